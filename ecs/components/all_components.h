@@ -63,6 +63,28 @@ struct Transform3DComponent {
 
 struct DirtyTransform {}; // Tag component
 
+// Tag on systems and observers that call into script; progress_worlds keeps
+// worlds that have any on the calling thread
+struct ScriptCallbackSystem {};
+
+// Transform relative to the ChildOf parent (to the world for roots)
+struct LocalTransform2D {
+	Transform2D transform;
+};
+
+// Local transform composed with every ancestor's; written by TransformPropagation
+struct GlobalTransform2D {
+	Transform2D transform;
+};
+
+struct LocalTransform3D {
+	Transform3D transform;
+};
+
+struct GlobalTransform3D {
+	Transform3D transform;
+};
+
 struct VisibilityComponent {
 	bool visible = true;
 };
@@ -145,6 +167,14 @@ struct World3DComponent {
 	~World3DComponent() = default;
 };
 
+// World singleton written by FixedTimestep before the variable-rate phases run
+struct PhysicsInterpolation {
+	double alpha = 1.0; // Fraction of a tick left in the accumulator, for blending physics states
+	double fixed_delta = 0.0; // Delta the physics phase ran with this frame
+	uint32_t steps = 0; // Physics steps run this frame
+	uint64_t tick = 0; // Physics steps run so far
+};
+
 // ============================================================================
 // RENDERING COMPONENTS - MESH
 // ============================================================================
@@ -684,6 +714,10 @@ inline void register_reflection_components() {
 	FlecsReflection::ComponentRegistrar<Transform2DComponent>::register_type("Transform2DComponent");
 	FlecsReflection::ComponentRegistrar<Transform3DComponent>::register_type("Transform3DComponent");
 	FlecsReflection::ComponentRegistrar<DirtyTransform>::register_type("DirtyTransform");
+	FlecsReflection::ComponentRegistrar<LocalTransform2D>::register_type("LocalTransform2D");
+	FlecsReflection::ComponentRegistrar<GlobalTransform2D>::register_type("GlobalTransform2D");
+	FlecsReflection::ComponentRegistrar<LocalTransform3D>::register_type("LocalTransform3D");
+	FlecsReflection::ComponentRegistrar<GlobalTransform3D>::register_type("GlobalTransform3D");
 	FlecsReflection::ComponentRegistrar<VisibilityComponent>::register_type("VisibilityComponent");
 	FlecsReflection::ComponentRegistrar<SceneNodeComponent>::register_type("SceneNodeComponent");
 	FlecsReflection::ComponentRegistrar<ObjectInstanceComponent>::register_type("ObjectInstanceComponent");
@@ -691,6 +725,7 @@ inline void register_reflection_components() {
 	FlecsReflection::ComponentRegistrar<ResourceComponent>::register_type("ResourceComponent");
 	FlecsReflection::ComponentRegistrar<World2DComponent>::register_type("World2DComponent");
 	FlecsReflection::ComponentRegistrar<World3DComponent>::register_type("World3DComponent");
+	FlecsReflection::ComponentRegistrar<PhysicsInterpolation>::register_type("PhysicsInterpolation");
 	FlecsReflection::ComponentRegistrar<MeshComponent>::register_type("MeshComponent");
 	FlecsReflection::ComponentRegistrar<MultiMeshComponent>::register_type("MultiMeshComponent");
 	FlecsReflection::ComponentRegistrar<MultiMeshInstanceComponent>::register_type("MultiMeshInstanceComponent");
@@ -756,6 +791,17 @@ inline void register_all(flecs::world& world, bool enable_serialization = false)
 	world.component<Transform3DComponent>()
 		.member<Transform3D>("transform");
 	world.component<DirtyTransform>(); // Tag component
+	// A local transform brings its global one along (the With trait adds it)
+	world.component<GlobalTransform2D>()
+		.member<Transform2D>("transform");
+	world.component<LocalTransform2D>()
+		.member<Transform2D>("transform")
+		.add(flecs::With, world.component<GlobalTransform2D>());
+	world.component<GlobalTransform3D>()
+		.member<Transform3D>("transform");
+	world.component<LocalTransform3D>()
+		.member<Transform3D>("transform")
+		.add(flecs::With, world.component<GlobalTransform3D>());
 	
 	world.component<VisibilityComponent>()
 		.member<bool>("visible");
@@ -794,6 +840,11 @@ inline void register_all(flecs::world& world, bool enable_serialization = false)
 		.member<RID>("navigation_map_id")
 		.member<RID>("scenario_id")
 		.member<RID>("space_id");
+	world.component<PhysicsInterpolation>()
+		.member<double>("alpha")
+		.member<double>("fixed_delta")
+		.member<uint32_t>("steps")
+		.member<uint64_t>("tick");
 	
 	// Mesh components - use reflection, nested Godot types are opaque
 	world.component<MeshComponent>()
@@ -0,0 +1,460 @@
+#include "modules/godot_turbo/ecs/components/component_access_plan.h"
+
+#include "core/math/aabb.h"
+#include "core/math/basis.h"
+#include "core/math/color.h"
+#include "core/math/plane.h"
+#include "core/math/projection.h"
+#include "core/math/quaternion.h"
+#include "core/math/rect2.h"
+#include "core/math/rect2i.h"
+#include "core/math/transform_2d.h"
+#include "core/math/transform_3d.h"
+#include "core/math/vector2.h"
+#include "core/math/vector2i.h"
+#include "core/math/vector3.h"
+#include "core/math/vector3i.h"
+#include "core/math/vector4.h"
+#include "core/math/vector4i.h"
+#include "core/object/object_id.h"
+#include "core/string/node_path.h"
+#include "core/string/print_string.h"
+#include "core/templates/rid.h"
+#include "core/variant/array.h"
+#include "core/variant/callable.h"
+
+namespace FlecsReflection {
+
+// Same limit as the cursor conversion in FlecsServer
+static constexpr int MAX_PLAN_DEPTH = 32;
+
+static const Variant &_value_key() {
+	static const Variant key = String("value");
+	return key;
+}
+
+// ----------------------------------------------------------------------------
+// Converters
+// ----------------------------------------------------------------------------
+
+template <typename T>
+static Variant _read_value(const void *p_field) {
+	return *static_cast<const T *>(p_field);
+}
+
+template <typename T>
+static void _write_value(void *p_field, const Variant &p_value) {
+	*static_cast<T *>(p_field) = p_value;
+}
+
+template <typename T>
+static Variant _read_int(const void *p_field) {
+	return static_cast<int64_t>(*static_cast<const T *>(p_field));
+}
+
+template <typename T>
+static void _write_int(void *p_field, const Variant &p_value) {
+	*static_cast<T *>(p_field) = static_cast<T>(p_value.operator int64_t());
+}
+
+template <typename T>
+static Variant _read_float(const void *p_field) {
+	return static_cast<double>(*static_cast<const T *>(p_field));
+}
+
+template <typename T>
+static void _write_float(void *p_field, const Variant &p_value) {
+	*static_cast<T *>(p_field) = static_cast<T>(p_value.operator double());
+}
+
+static Variant _read_bool(const void *p_field) {
+	return *static_cast<const bool *>(p_field);
+}
+
+static void _write_bool(void *p_field, const Variant &p_value) {
+	*static_cast<bool *>(p_field) = p_value.operator bool();
+}
+
+static Variant _read_c_string(const void *p_field) {
+	const char *str = *static_cast<const char *const *>(p_field);
+	return str ? String::utf8(str) : String();
+}
+
+static void _write_c_string(void *p_field, const Variant &p_value) {
+	char **str = static_cast<char **>(p_field);
+	if (*str) {
+		ecs_os_free(*str);
+	}
+	*str = ecs_os_strdup(String(p_value).utf8().get_data());
+}
+
+static Variant _read_object_id(const void *p_field) {
+	return static_cast<int64_t>(static_cast<const ObjectID *>(p_field)->operator uint64_t());
+}
+
+static void _write_object_id(void *p_field, const Variant &p_value) {
+	*static_cast<ObjectID *>(p_field) = ObjectID(p_value.operator int64_t());
+}
+
+static bool _resolve_primitive(ecs_primitive_kind_t p_kind, MemberAccess &r_member) {
+	switch (p_kind) {
+		case EcsBool:
+			r_member.variant_type = Variant::BOOL;
+			r_member.read = &_read_bool;
+			r_member.write = &_write_bool;
+			return true;
+		case EcsChar:
+		case EcsI8:
+			r_member.variant_type = Variant::INT;
+			r_member.read = &_read_int<int8_t>;
+			r_member.write = &_write_int<int8_t>;
+			return true;
+		case EcsByte:
+		case EcsU8:
+			r_member.variant_type = Variant::INT;
+			r_member.read = &_read_int<uint8_t>;
+			r_member.write = &_write_int<uint8_t>;
+			return true;
+		case EcsI16:
+			r_member.variant_type = Variant::INT;
+			r_member.read = &_read_int<int16_t>;
+			r_member.write = &_write_int<int16_t>;
+			return true;
+		case EcsU16:
+			r_member.variant_type = Variant::INT;
+			r_member.read = &_read_int<uint16_t>;
+			r_member.write = &_write_int<uint16_t>;
+			return true;
+		case EcsI32:
+			r_member.variant_type = Variant::INT;
+			r_member.read = &_read_int<int32_t>;
+			r_member.write = &_write_int<int32_t>;
+			return true;
+		case EcsU32:
+			r_member.variant_type = Variant::INT;
+			r_member.read = &_read_int<uint32_t>;
+			r_member.write = &_write_int<uint32_t>;
+			return true;
+		case EcsI64:
+		case EcsIPtr:
+			r_member.variant_type = Variant::INT;
+			r_member.read = &_read_int<int64_t>;
+			r_member.write = &_write_int<int64_t>;
+			return true;
+		case EcsU64:
+		case EcsUPtr:
+		case EcsEntity:
+			r_member.variant_type = Variant::INT;
+			r_member.read = &_read_int<uint64_t>;
+			r_member.write = &_write_int<uint64_t>;
+			return true;
+		case EcsF32:
+			r_member.variant_type = Variant::FLOAT;
+			r_member.read = &_read_float<float>;
+			r_member.write = &_write_float<float>;
+			return true;
+		case EcsF64:
+			r_member.variant_type = Variant::FLOAT;
+			r_member.read = &_read_float<double>;
+			r_member.write = &_write_float<double>;
+			return true;
+		case EcsString:
+			r_member.variant_type = Variant::STRING;
+			r_member.read = &_read_c_string;
+			r_member.write = &_write_c_string;
+			return true;
+		default:
+			return false;
+	}
+}
+
+// Godot types are registered as opaque components (see FlecsOpaqueTypes), so
+// they are matched by component id rather than by name.
+#define PLAN_VALUE_TYPE(m_type, m_variant_type)                                     \
+	{                                                                               \
+		MemberAccess &value_type = r_value_types[p_world.component<m_type>().id()]; \
+		value_type.variant_type = m_variant_type;                                   \
+		value_type.read = &_read_value<m_type>;                                     \
+		value_type.write = &_write_value<m_type>;                                   \
+	}
+
+// component<T>() registers the type when it is missing, so this must not run
+// while the world is readonly. It runs outside the cache lock: registering can
+// emit events that reach the invalidation observers.
+void AccessPlanCache::_resolve_value_types(flecs::world &p_world, HashMap<flecs::entity_t, MemberAccess> &r_value_types) {
+	PLAN_VALUE_TYPE(Vector2, Variant::VECTOR2)
+	PLAN_VALUE_TYPE(Vector3, Variant::VECTOR3)
+	PLAN_VALUE_TYPE(Vector4, Variant::VECTOR4)
+	PLAN_VALUE_TYPE(Vector2i, Variant::VECTOR2I)
+	PLAN_VALUE_TYPE(Vector3i, Variant::VECTOR3I)
+	PLAN_VALUE_TYPE(Vector4i, Variant::VECTOR4I)
+	PLAN_VALUE_TYPE(Color, Variant::COLOR)
+	PLAN_VALUE_TYPE(Quaternion, Variant::QUATERNION)
+	PLAN_VALUE_TYPE(Plane, Variant::PLANE)
+	PLAN_VALUE_TYPE(AABB, Variant::AABB)
+	PLAN_VALUE_TYPE(Rect2, Variant::RECT2)
+	PLAN_VALUE_TYPE(Rect2i, Variant::RECT2I)
+	PLAN_VALUE_TYPE(Transform2D, Variant::TRANSFORM2D)
+	PLAN_VALUE_TYPE(Transform3D, Variant::TRANSFORM3D)
+	PLAN_VALUE_TYPE(Basis, Variant::BASIS)
+	PLAN_VALUE_TYPE(Projection, Variant::PROJECTION)
+	PLAN_VALUE_TYPE(String, Variant::STRING)
+	PLAN_VALUE_TYPE(StringName, Variant::STRING_NAME)
+	PLAN_VALUE_TYPE(NodePath, Variant::NODE_PATH)
+	PLAN_VALUE_TYPE(RID, Variant::RID)
+	PLAN_VALUE_TYPE(Callable, Variant::CALLABLE)
+	PLAN_VALUE_TYPE(Signal, Variant::SIGNAL)
+	PLAN_VALUE_TYPE(Dictionary, Variant::DICTIONARY)
+	PLAN_VALUE_TYPE(Array, Variant::ARRAY)
+	PLAN_VALUE_TYPE(PackedByteArray, Variant::PACKED_BYTE_ARRAY)
+	PLAN_VALUE_TYPE(PackedInt32Array, Variant::PACKED_INT32_ARRAY)
+	PLAN_VALUE_TYPE(PackedInt64Array, Variant::PACKED_INT64_ARRAY)
+	PLAN_VALUE_TYPE(PackedFloat32Array, Variant::PACKED_FLOAT32_ARRAY)
+	PLAN_VALUE_TYPE(PackedFloat64Array, Variant::PACKED_FLOAT64_ARRAY)
+	PLAN_VALUE_TYPE(PackedStringArray, Variant::PACKED_STRING_ARRAY)
+	PLAN_VALUE_TYPE(PackedVector2Array, Variant::PACKED_VECTOR2_ARRAY)
+	PLAN_VALUE_TYPE(PackedVector3Array, Variant::PACKED_VECTOR3_ARRAY)
+	PLAN_VALUE_TYPE(PackedColorArray, Variant::PACKED_COLOR_ARRAY)
+
+	MemberAccess &variant = r_value_types[p_world.component<Variant>().id()];
+	variant.variant_type = Variant::VARIANT_MAX;
+	variant.read = &_read_value<Variant>;
+	variant.write = &_write_value<Variant>;
+
+	MemberAccess &object_id = r_value_types[p_world.component<ObjectID>().id()];
+	object_id.variant_type = Variant::INT;
+	object_id.read = &_read_object_id;
+	object_id.write = &_write_object_id;
+}
+
+#undef PLAN_VALUE_TYPE
+
+// ----------------------------------------------------------------------------
+// AccessPlan
+// ----------------------------------------------------------------------------
+
+Dictionary AccessPlan::to_dict(const void *p_data) const {
+	Dictionary dict;
+	const uint8_t *base = static_cast<const uint8_t *>(p_data);
+	for (const MemberAccess &member : members) {
+		const void *field = base + member.offset;
+		if (member.nested) {
+			dict[member.key] = member.nested->to_dict(field);
+		} else {
+			dict[member.key] = member.read ? member.read(field) : Variant();
+		}
+	}
+	return dict;
+}
+
+void AccessPlan::from_dict(void *p_data, const Dictionary &p_dict) const {
+	uint8_t *base = static_cast<uint8_t *>(p_data);
+
+	if (!is_struct) {
+		// Single value components accept {"value": v}. Dictionary and Variant
+		// components also take the whole dictionary / its first value, like the
+		// cursor based path did.
+		if (members.is_empty() || !members[0].write) {
+			return;
+		}
+		const MemberAccess &member = members[0];
+		if (const Variant *wrapped = p_dict.size() == 1 ? p_dict.getptr(_value_key()) : nullptr) {
+			member.write(base, *wrapped);
+		} else if (member.variant_type == Variant::DICTIONARY) {
+			member.write(base, p_dict);
+		} else if (member.variant_type == Variant::VARIANT_MAX && p_dict.size() > 0) {
+			member.write(base, p_dict.values()[0]);
+		}
+		return;
+	}
+
+	for (const MemberAccess &member : members) {
+		const Variant *value = p_dict.getptr(member.key);
+		if (!value) {
+			continue;
+		}
+		void *field = base + member.offset;
+		if (member.nested) {
+			if (value->get_type() == Variant::DICTIONARY) {
+				member.nested->from_dict(field, *value);
+			}
+		} else if (member.write) {
+			member.write(field, *value);
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+// AccessPlanCache
+// ----------------------------------------------------------------------------
+
+void AccessPlanCache::watch_world(flecs::world &p_world) {
+	// EcsStruct is set once per added member and removed when the type goes away,
+	// which covers runtime components being (re)defined through ecs_struct_init.
+	p_world.observer<>("AccessPlanStructObserver")
+			.with<EcsStruct>()
+			.event(flecs::OnSet)
+			.event(flecs::OnRemove)
+			.each([](flecs::iter &it, size_t) {
+				AccessPlanCache::get().invalidate(it.world());
+			});
+	p_world.observer<>("AccessPlanComponentObserver")
+			.with<flecs::Component>()
+			.event(flecs::OnRemove)
+			.each([](flecs::iter &it, size_t) {
+				AccessPlanCache::get().invalidate(it.world());
+			});
+
+	HashMap<flecs::entity_t, MemberAccess> value_types;
+	_resolve_value_types(p_world, value_types);
+	RWLockWrite write_lock(lock);
+	WorldPlans &world_plans = worlds[ecs_get_world(p_world.c_ptr())];
+	world_plans.value_types = value_types;
+	world_plans.value_types_resolved = true;
+}
+
+void AccessPlanCache::forget_world(const flecs::world &p_world) {
+	RWLockWrite write_lock(lock);
+	worlds.erase(ecs_get_world(p_world.c_ptr()));
+	generation.fetch_add(1, std::memory_order_release);
+}
+
+void AccessPlanCache::invalidate(const flecs::world &p_world) {
+	RWLockWrite write_lock(lock);
+	if (WorldPlans *world_plans = worlds.getptr(ecs_get_world(p_world.c_ptr()))) {
+		// Nested plans are shared between outer plans, so the whole world is dropped
+		world_plans->plans.clear();
+	}
+	generation.fetch_add(1, std::memory_order_release);
+}
+
+std::shared_ptr<const AccessPlan> AccessPlanCache::get_plan(const flecs::world &p_world, flecs::entity_t p_component) {
+	if (p_component == 0) {
+		return nullptr;
+	}
+	// Always work against the real world; p_world may be a stage inside a system
+	const ecs_world_t *real_world = ecs_get_world(p_world.c_ptr());
+	bool value_types_resolved = false;
+	{
+		RWLockRead read_lock(lock);
+		if (const WorldPlans *world_plans = worlds.getptr(real_world)) {
+			if (const std::shared_ptr<const AccessPlan> *cached = world_plans->plans.getptr(p_component)) {
+				return *cached;
+			}
+			value_types_resolved = world_plans->value_types_resolved;
+		}
+	}
+
+	flecs::world world(const_cast<ecs_world_t *>(real_world));
+	HashMap<flecs::entity_t, MemberAccess> value_types;
+	if (!value_types_resolved) {
+		// Only worlds FlecsServer did not create get here, resolved when it is safe
+		if (ecs_stage_is_readonly(real_world)) {
+			ERR_PRINT_ONCE("AccessPlanCache: value types of an unwatched world cannot be resolved while it is readonly");
+			return nullptr;
+		}
+		_resolve_value_types(world, value_types);
+	}
+
+	RWLockWrite write_lock(lock);
+	WorldPlans &world_plans = worlds[real_world];
+	if (!world_plans.value_types_resolved) {
+		world_plans.value_types = value_types;
+		world_plans.value_types_resolved = true;
+	}
+	return _get_or_build(world, world_plans, p_component, 0);
+}
+
+std::shared_ptr<const AccessPlan> AccessPlanCache::_get_or_build(flecs::world &p_world, WorldPlans &p_world_plans, flecs::entity_t p_component, int p_depth) {
+	// Another thread may have built it between the read and the write lock
+	if (const std::shared_ptr<const AccessPlan> *cached = p_world_plans.plans.getptr(p_component)) {
+		return *cached;
+	}
+	if (p_depth > MAX_PLAN_DEPTH) {
+		return nullptr;
+	}
+
+	flecs::entity type(p_world.c_ptr(), p_component);
+	std::shared_ptr<AccessPlan> plan;
+
+	if (type.is_valid() && type.has<EcsStruct>()) {
+		plan = std::make_shared<AccessPlan>();
+		plan->component_id = p_component;
+		plan->is_struct = true;
+
+		const EcsStruct &ecs_struct = type.get<EcsStruct>();
+		const ecs_member_t *members = ecs_vec_first_t(&ecs_struct.members, ecs_member_t);
+		const int32_t member_count = ecs_vec_count(&ecs_struct.members);
+		plan->members.reserve(member_count);
+		for (int32_t i = 0; i < member_count; i++) {
+			if (members[i].name == nullptr || members[i].name[0] == '\0') {
+				continue;
+			}
+			MemberAccess member;
+			member.key = String::utf8(members[i].name);
+			member.offset = members[i].offset;
+			// Inline arrays are left unconverted, like the cursor path
+			if (members[i].count <= 1 && !_resolve_member(p_world, p_world_plans, members[i].type, member, p_depth)) {
+				print_verbose(vformat("AccessPlanCache: member '%s' of '%s' has no Variant conversion", String(member.key), String(type.name().c_str())));
+			}
+			plan->members.push_back(member);
+		}
+	} else {
+		MemberAccess member;
+		member.key = _value_key();
+		if (type.is_valid() && _resolve_member(p_world, p_world_plans, p_component, member, p_depth)) {
+			plan = std::make_shared<AccessPlan>();
+			plan->component_id = p_component;
+			plan->members.push_back(member);
+		}
+	}
+
+	// Negative results are cached too so unreflected types are not re-examined every call
+	p_world_plans.plans.insert(p_component, plan);
+	build_count.fetch_add(1, std::memory_order_relaxed);
+	return plan;
+}
+
+bool AccessPlanCache::_resolve_member(flecs::world &p_world, WorldPlans &p_world_plans, flecs::entity_t p_type, MemberAccess &r_member, int p_depth) {
+	flecs::entity type(p_world.c_ptr(), p_type);
+	if (!type.is_valid()) {
+		return false;
+	}
+
+	if (type.has<EcsPrimitive>()) {
+		return _resolve_primitive(type.get<EcsPrimitive>().kind, r_member);
+	}
+
+	if (type.has<EcsEnum>() && type.has<EcsComponent>()) {
+		// Enums are stored as their underlying integer
+		switch (type.get<EcsComponent>().size) {
+			case 1:
+				return _resolve_primitive(EcsI8, r_member);
+			case 2:
+				return _resolve_primitive(EcsI16, r_member);
+			case 4:
+				return _resolve_primitive(EcsI32, r_member);
+			case 8:
+				return _resolve_primitive(EcsI64, r_member);
+			default:
+				return false;
+		}
+	}
+
+	if (const MemberAccess *value_type = p_world_plans.value_types.getptr(p_type)) {
+		r_member.variant_type = value_type->variant_type;
+		r_member.read = value_type->read;
+		r_member.write = value_type->write;
+		return true;
+	}
+
+	if (type.has<EcsStruct>()) {
+		r_member.variant_type = Variant::DICTIONARY;
+		r_member.nested = _get_or_build(p_world, p_world_plans, p_type, p_depth + 1);
+		return r_member.nested != nullptr;
+	}
+
+	return false;
+}
+
+} // namespace FlecsReflection
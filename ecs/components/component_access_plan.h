@@ -0,0 +1,112 @@
+#pragma once
+
+#include "core/os/rw_lock.h"
+#include "core/string/string_name.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/dictionary.h"
+#include "core/variant/variant.h"
+#include "modules/godot_turbo/thirdparty/flecs/distr/flecs.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace FlecsReflection {
+
+// Direct converters between a member's storage and a Variant
+using MemberReadFn = Variant (*)(const void *p_field);
+using MemberWriteFn = void (*)(void *p_field, const Variant &p_value);
+
+struct AccessPlan;
+
+/**
+ * @struct MemberAccess
+ * @brief Precompiled access for one component member
+ *
+ * A member either has a direct read/write converter pair, or a nested plan
+ * when the member is itself a reflected struct. Members whose type has no
+ * Variant representation keep null converters and read back as Variant().
+ */
+struct MemberAccess {
+	Variant key; // Member name as a String Variant, ready to be used as a Dictionary key
+	int32_t offset = 0;
+	Variant::Type variant_type = Variant::NIL; // VARIANT_MAX for Variant-typed members
+	MemberReadFn read = nullptr;
+	MemberWriteFn write = nullptr;
+	std::shared_ptr<const AccessPlan> nested;
+};
+
+/**
+ * @struct AccessPlan
+ * @brief Flat description of how to convert a component to and from a Dictionary
+ *
+ * Built once per (world, component) from Flecs reflection data. Struct
+ * components map to one entry per member; any other reflected type maps to a
+ * single "value" entry at offset 0, matching the shape produced by the cursor
+ * based conversion in FlecsServer.
+ */
+struct AccessPlan {
+	flecs::entity_t component_id = 0;
+	bool is_struct = false;
+	LocalVector<MemberAccess> members;
+
+	Dictionary to_dict(const void *p_data) const;
+	void from_dict(void *p_data, const Dictionary &p_dict) const;
+};
+
+/**
+ * @class AccessPlanCache
+ * @brief Process-wide cache of access plans, keyed by world and component
+ *
+ * Plans are built lazily on first use (or eagerly when a runtime component is
+ * created) and dropped whenever reflection data of the world changes, so a
+ * redefined or deleted type never reuses a stale layout. Thread-safe: script
+ * systems running on worker threads can request plans concurrently. A hit
+ * only takes the read side of the lock; misses build under the write side.
+ *
+ * Plans never register components. The ids of the Godot value types are
+ * resolved once per world in watch_world(), on the main thread, so a miss on
+ * a worker cannot touch a world that is readonly.
+ */
+class AccessPlanCache {
+public:
+	static AccessPlanCache &get() {
+		static AccessPlanCache instance;
+		return instance;
+	}
+
+	// Installs the observers that invalidate plans when EcsStruct or a component
+	// changes and resolves the world's value type ids
+	void watch_world(flecs::world &p_world);
+	void forget_world(const flecs::world &p_world);
+
+	// Returns null when the component has no reflection data to build a plan from
+	std::shared_ptr<const AccessPlan> get_plan(const flecs::world &p_world, flecs::entity_t p_component);
+	void invalidate(const flecs::world &p_world);
+
+	uint64_t get_build_count() const { return build_count.load(std::memory_order_relaxed); }
+	// Bumped whenever plans are dropped; holders of a plan compare it to tell
+	// whether theirs may be stale without looking the plan up again
+	uint64_t get_generation() const { return generation.load(std::memory_order_acquire); }
+
+private:
+	typedef HashMap<flecs::entity_t, std::shared_ptr<const AccessPlan>> PlanMap;
+
+	struct WorldPlans {
+		PlanMap plans;
+		// Converters of the Godot value types (opaque components), by component id
+		HashMap<flecs::entity_t, MemberAccess> value_types;
+		bool value_types_resolved = false;
+	};
+
+	RWLock lock;
+	HashMap<const ecs_world_t *, WorldPlans> worlds;
+	std::atomic<uint64_t> build_count{ 0 };
+	std::atomic<uint64_t> generation{ 0 };
+
+	static void _resolve_value_types(flecs::world &p_world, HashMap<flecs::entity_t, MemberAccess> &r_value_types);
+	std::shared_ptr<const AccessPlan> _get_or_build(flecs::world &p_world, WorldPlans &p_world_plans, flecs::entity_t p_component, int p_depth);
+	bool _resolve_member(flecs::world &p_world, WorldPlans &p_world_plans, flecs::entity_t p_type, MemberAccess &r_member, int p_depth);
+};
+
+} // namespace FlecsReflection
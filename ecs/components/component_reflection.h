@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/variant/dictionary.h"
+#include "modules/godot_turbo/ecs/components/component_access_plan.h"
 #include "modules/godot_turbo/thirdparty/flecs/distr/flecs.h"
 #include "core/string/string_name.h"
 #include "core/templates/hash_map.h"
@@ -59,31 +60,38 @@ public:
 		return nullptr;
 	}
 
-	// Serialize component from entity
+	// Serialize component from entity. Custom serializers win; everything else
+	// goes through the cached access plan built from Flecs reflection data.
 	::Dictionary serialize(const flecs::entity& e, flecs::entity_t component_id) {
-		ComponentMeta* meta = get_by_id(component_id);
-		if (!meta || !meta->serialize) {
-			return ::Dictionary();
-		}
-
 		const void* data = e.get(component_id);
 		if (!data) {
 			return ::Dictionary();
 		}
 
-		return meta->serialize(data);
+		ComponentMeta* meta = get_by_id(component_id);
+		if (meta && meta->serialize) {
+			return meta->serialize(data);
+		}
+
+		std::shared_ptr<const AccessPlan> plan = AccessPlanCache::get().get_plan(e.world(), component_id);
+		return plan ? plan->to_dict(data) : ::Dictionary();
 	}
 
 	// Deserialize component to entity
 	void deserialize(flecs::entity& e, flecs::entity_t component_id, const ::Dictionary& dict) {
-		ComponentMeta* meta = get_by_id(component_id);
-		if (!meta || !meta->deserialize) {
+		void* data = e.get_mut(component_id);
+		if (!data) {
 			return;
 		}
 
-		void* data = e.get_mut(component_id);
-		if (data) {
+		ComponentMeta* meta = get_by_id(component_id);
+		if (meta && meta->deserialize) {
 			meta->deserialize(data, dict);
+			return;
+		}
+
+		if (std::shared_ptr<const AccessPlan> plan = AccessPlanCache::get().get_plan(e.world(), component_id)) {
+			plan->from_dict(data, dict);
 		}
 	}
 
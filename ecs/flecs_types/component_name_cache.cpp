@@ -0,0 +1,72 @@
+#include "modules/godot_turbo/ecs/flecs_types/component_name_cache.h"
+
+#include "core/string/ustring.h"
+
+void ComponentNameCache::watch_world(flecs::world &p_world) {
+	p_world.observer<>("ComponentNameRemoveObserver")
+			.with<flecs::Component>()
+			.event(flecs::OnRemove)
+			.each([](flecs::iter &it, size_t) {
+				ComponentNameCache::get().invalidate(it.world());
+			});
+	// A component moved to another parent changes its path just like a rename
+	p_world.observer<>("ComponentNameRenameObserver")
+			.with<flecs::Identifier>(flecs::Name)
+			.with<flecs::Component>()
+			.event(flecs::OnSet)
+			.each([](flecs::iter &it, size_t) {
+				ComponentNameCache::get().invalidate(it.world());
+			});
+	p_world.observer<>("ComponentNameReparentObserver")
+			.with(flecs::ChildOf, flecs::Wildcard)
+			.with<flecs::Component>()
+			.event(flecs::OnAdd)
+			.each([](flecs::iter &it, size_t) {
+				ComponentNameCache::get().invalidate(it.world());
+			});
+}
+
+void ComponentNameCache::forget_world(const flecs::world &p_world) {
+	RWLockWrite write_lock(lock);
+	names.erase(ecs_get_world(p_world.c_ptr()));
+}
+
+void ComponentNameCache::invalidate(const flecs::world &p_world) {
+	RWLockWrite write_lock(lock);
+	if (NameMap *world_names = names.getptr(ecs_get_world(p_world.c_ptr()))) {
+		world_names->clear();
+	}
+}
+
+flecs::entity_t ComponentNameCache::lookup(const flecs::world &p_world, const StringName &p_name) {
+	if (p_name.is_empty()) {
+		return 0;
+	}
+	// Always key on the real world; p_world may be a stage inside a system
+	const ecs_world_t *real_world = ecs_get_world(p_world.c_ptr());
+	{
+		RWLockRead read_lock(lock);
+		if (const NameMap *world_names = names.getptr(real_world)) {
+			if (const flecs::entity_t *component = world_names->getptr(p_name)) {
+				return *component;
+			}
+		}
+	}
+
+	miss_count.fetch_add(1, std::memory_order_relaxed);
+	const CharString utf8 = String(p_name).utf8();
+	flecs::entity entity = p_world.lookup(utf8.get_data());
+	if (!entity.is_valid()) {
+		return 0;
+	}
+	// Plain named entities can be created and destroyed freely, only components are cached
+	if (entity.has<flecs::Component>()) {
+		insert(p_world, p_name, entity.id());
+	}
+	return entity.id();
+}
+
+void ComponentNameCache::insert(const flecs::world &p_world, const StringName &p_name, flecs::entity_t p_component) {
+	RWLockWrite write_lock(lock);
+	names[ecs_get_world(p_world.c_ptr())][p_name] = p_component;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "core/os/rw_lock.h"
+#include "core/string/string_name.h"
+#include "core/templates/hash_map.h"
+#include "modules/godot_turbo/thirdparty/flecs/distr/flecs.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class ComponentNameCache
+ * @brief Process-wide StringName -> component id cache, keyed by world
+ *
+ * Name based APIs used to run world->lookup(String.utf8()) on every call: a
+ * UTF-8 conversion plus a hierarchical path walk. Here a hit is a single
+ * HashMap probe on the interned StringName's precomputed hash.
+ *
+ * Only entities that are components are cached. A new component cannot make
+ * an existing entry wrong, so registration never invalidates. Deleting or
+ * renaming a component drops the world's entries through the observers
+ * installed by watch_world(). Runtime components are inserted eagerly when
+ * they are created. Reads take a shared lock, so systems running on worker
+ * threads can resolve names concurrently.
+ */
+class ComponentNameCache {
+public:
+	static ComponentNameCache &get() {
+		static ComponentNameCache instance;
+		return instance;
+	}
+
+	// Installs the observers that drop entries when a component is deleted or renamed
+	void watch_world(flecs::world &p_world);
+	void forget_world(const flecs::world &p_world);
+
+	// Returns 0 when no entity with that name exists
+	flecs::entity_t lookup(const flecs::world &p_world, const StringName &p_name);
+	void insert(const flecs::world &p_world, const StringName &p_name, flecs::entity_t p_component);
+	void invalidate(const flecs::world &p_world);
+
+	uint64_t get_miss_count() const { return miss_count.load(std::memory_order_relaxed); }
+
+private:
+	typedef HashMap<StringName, flecs::entity_t> NameMap;
+
+	RWLock lock;
+	HashMap<const ecs_world_t *, NameMap> names;
+	std::atomic<uint64_t> miss_count{ 0 };
+};
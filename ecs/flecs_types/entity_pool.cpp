@@ -0,0 +1,112 @@
+#include "modules/godot_turbo/ecs/flecs_types/entity_pool.h"
+
+void EntityPool::setup(flecs::world &p_world, const PackedStringArray &p_component_names, const LocalVector<flecs::entity_t> &p_components) {
+	component_names = p_component_names;
+	components = p_components;
+	row_bytes = 0;
+	for (const flecs::entity_t component : components) {
+		if (const ecs_type_info_t *type_info = ecs_get_type_info(p_world.c_ptr(), component)) {
+			row_bytes += type_info->size;
+		}
+	}
+}
+
+bool EntityPool::has_component(flecs::entity_t p_component) const {
+	for (const flecs::entity_t component : components) {
+		if (component == p_component) {
+			return true;
+		}
+	}
+	return false;
+}
+
+uint32_t EntityPool::take(flecs::world &p_world, uint32_t p_count, flecs::entity_t *r_entities) {
+	ecs_world_t *world = p_world.c_ptr();
+	uint32_t taken = 0;
+	while (taken < p_count && !parked.is_empty()) {
+		const flecs::entity_t entity = parked[parked.size() - 1];
+		parked.resize(parked.size() - 1);
+		parked_set.erase(entity);
+		if (!ecs_is_alive(world, entity)) {
+			members.erase(entity);
+			continue;
+		}
+		ecs_remove_id(world, entity, EcsDisabled);
+		r_entities[taken++] = entity;
+	}
+	hits += taken;
+	misses += p_count - taken;
+	peak_active = MAX(peak_active, get_active_count());
+	return taken;
+}
+
+void EntityPool::add_created(const flecs::entity_t *p_entities, uint32_t p_count) {
+	members.reserve(members.size() + p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		members.insert(p_entities[i]);
+	}
+	peak_active = MAX(peak_active, get_active_count());
+}
+
+uint32_t EntityPool::park(flecs::world &p_world, const flecs::entity_t *p_entities, uint32_t p_count) {
+	ecs_world_t *world = p_world.c_ptr();
+	uint32_t parked_now = 0;
+	for (uint32_t i = 0; i < p_count; i++) {
+		const flecs::entity_t entity = p_entities[i];
+		if (!members.has(entity) || parked_set.has(entity)) {
+			continue;
+		}
+		if (!ecs_is_alive(world, entity)) {
+			members.erase(entity);
+			continue;
+		}
+		ecs_add_id(world, entity, EcsDisabled);
+		parked.push_back(entity);
+		parked_set.insert(entity);
+		parked_now++;
+	}
+	releases += parked_now;
+	return parked_now;
+}
+
+void EntityPool::drain(LocalVector<flecs::entity_t> &r_parked) {
+	r_parked = parked;
+	parked.clear();
+	parked_set.clear();
+	members.clear();
+}
+
+void EntityPool::resync(flecs::world &p_world) {
+	ecs_world_t *world = p_world.c_ptr();
+	parked.clear();
+	parked_set.clear();
+	LocalVector<flecs::entity_t> dead;
+	for (const flecs::entity_t entity : members) {
+		if (!ecs_is_alive(world, entity)) {
+			dead.push_back(entity);
+		} else if (ecs_has_id(world, entity, EcsDisabled)) {
+			parked.push_back(entity);
+			parked_set.insert(entity);
+		}
+	}
+	for (const flecs::entity_t entity : dead) {
+		members.erase(entity);
+	}
+}
+
+Dictionary EntityPool::get_stats() const {
+	const uint64_t acquires = hits + misses;
+	Dictionary stats;
+	stats["acquires"] = (int64_t)acquires;
+	stats["hits"] = (int64_t)hits;
+	stats["misses"] = (int64_t)misses;
+	stats["hit_rate"] = acquires == 0 ? 0.0 : double(hits) / double(acquires);
+	stats["releases"] = (int64_t)releases;
+	stats["active"] = (int64_t)get_active_count();
+	stats["peak_active"] = (int64_t)peak_active;
+	stats["parked"] = (int64_t)get_parked_count();
+	stats["parked_bytes"] = (int64_t)get_parked_bytes();
+	// Approximate: the hash sets also keep a hash and two indices per slot
+	stats["bookkeeping_bytes"] = (int64_t)(parked.get_capacity() * sizeof(flecs::entity_t) + (members.get_capacity() + parked_set.get_capacity()) * (sizeof(flecs::entity_t) + 3 * sizeof(uint32_t)));
+	return stats;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "core/templates/a_hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/string/string_name.h"
+#include "core/variant/dictionary.h"
+#include "core/variant/variant.h"
+#include "modules/godot_turbo/thirdparty/flecs/distr/flecs.h"
+#include <cstdint>
+
+/**
+ * @class EntityPool
+ * @brief Recycles entities of one archetype for high-churn spawn/despawn
+ *
+ * Released entities are not destroyed: they get the Flecs Disabled tag, which
+ * moves them to a sibling table that systems, queries and observers skip.
+ * Their component storage, entity id and RID stay as they are, so acquiring
+ * one back is a single table move instead of an entity creation, RID
+ * allocation and one archetype move per component.
+ *
+ * The pool only tracks ids; FlecsServer creates entities on a miss and writes
+ * initial data. An acquired entity keeps the values of its previous life
+ * unless they are overwritten.
+ */
+class EntityPool {
+public:
+	void setup(flecs::world &p_world, const PackedStringArray &p_component_names, const LocalVector<flecs::entity_t> &p_components);
+
+	// Components every entity of the pool has
+	const PackedStringArray &get_component_names() const { return component_names; }
+	bool has_component(flecs::entity_t p_component) const;
+
+	// Re-enables up to p_count parked entities into r_entities and returns how
+	// many were taken; parked entities destroyed in the meantime are dropped
+	uint32_t take(flecs::world &p_world, uint32_t p_count, flecs::entity_t *r_entities);
+	// Records entities created for the pool on a miss
+	void add_created(const flecs::entity_t *p_entities, uint32_t p_count);
+	// Disables and parks entities of this pool; returns how many were parked.
+	// Entities that are dead, already parked or not from this pool are skipped.
+	uint32_t park(flecs::world &p_world, const flecs::entity_t *p_entities, uint32_t p_count);
+	// Hands out every parked entity (for destruction) and forgets the pool's entities
+	void drain(LocalVector<flecs::entity_t> &r_parked);
+	// Rebuilds the parked list from the Disabled tag after a snapshot restore
+	void resync(flecs::world &p_world);
+
+	uint32_t get_parked_count() const { return parked.size(); }
+	uint32_t get_active_count() const { return members.size() - parked.size(); }
+	// Component bytes held by parked entities
+	uint64_t get_parked_bytes() const { return uint64_t(parked.size()) * row_bytes; }
+	Dictionary get_stats() const;
+
+private:
+	PackedStringArray component_names;
+	LocalVector<flecs::entity_t> components;
+	uint32_t row_bytes = 0;
+	LocalVector<flecs::entity_t> parked;
+	HashSet<flecs::entity_t> parked_set;
+	HashSet<flecs::entity_t> members;
+
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+	uint64_t releases = 0;
+	uint32_t peak_active = 0;
+};
+
+// Named pools of one world
+typedef AHashMap<StringName, EntityPool *> EntityPoolMap;
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/rid.h"
+#include <cstdint>
+
+/**
+ * @class EntityRIDMap
+ * @brief Sharded Flecs entity id -> Godot RID map
+ *
+ * Script systems run with multi_threaded(true) materialize entity RIDs from
+ * worker threads, so the reverse map cannot be a plain HashMap. Entries are
+ * spread over a fixed number of shards by the low bits of the entity index,
+ * each guarded by its own mutex: workers touching different entities almost
+ * never contend, and no global lock is taken.
+ *
+ * get_or_create() holds the shard lock only to read and to publish the entry:
+ * the validity check and the RID allocation run outside it, and a racing
+ * creator loses by discarding its RID, so two workers resolving the same
+ * entity still end up with the same RID.
+ */
+class EntityRIDMap {
+public:
+	static constexpr uint32_t SHARD_COUNT = 64; // Power of two
+
+	EntityRIDMap() = default;
+	EntityRIDMap(const EntityRIDMap &) = delete;
+	EntityRIDMap &operator=(const EntityRIDMap &) = delete;
+
+	bool get(uint64_t p_entity, RID &r_rid) const {
+		const Shard &shard = _shard(p_entity);
+		MutexLock lock(shard.mutex);
+		const RID *rid = shard.map.getptr(p_entity);
+		if (!rid) {
+			return false;
+		}
+		r_rid = *rid;
+		return true;
+	}
+
+	bool has(uint64_t p_entity) const {
+		const Shard &shard = _shard(p_entity);
+		MutexLock lock(shard.mutex);
+		return shard.map.has(p_entity);
+	}
+
+	void set(uint64_t p_entity, const RID &p_rid) {
+		Shard &shard = _shard(p_entity);
+		MutexLock lock(shard.mutex);
+		shard.map[p_entity] = p_rid;
+	}
+
+	// Removes the entry and returns the RID it held
+	bool take(uint64_t p_entity, RID &r_rid) {
+		Shard &shard = _shard(p_entity);
+		MutexLock lock(shard.mutex);
+		HashMap<uint64_t, RID>::Iterator it = shard.map.find(p_entity);
+		if (!it) {
+			return false;
+		}
+		r_rid = it->value;
+		shard.map.remove(it);
+		return true;
+	}
+
+	void erase(uint64_t p_entity) {
+		Shard &shard = _shard(p_entity);
+		MutexLock lock(shard.mutex);
+		shard.map.erase(p_entity);
+	}
+
+	/**
+	 * @brief Return the RID mapped to @p p_entity, creating it when missing
+	 *
+	 * @p p_is_valid(rid) decides whether an existing entry can be reused,
+	 * @p p_make() creates a new RID and @p p_discard(rid) releases one that is
+	 * no longer mapped: the stale entry that got replaced, or the RID made by
+	 * a creator that lost the race. None of them run under the shard lock.
+	 */
+	template <typename FValid, typename FMake, typename FDiscard>
+	RID get_or_create(uint64_t p_entity, FValid &&p_is_valid, FMake &&p_make, FDiscard &&p_discard) {
+		Shard &shard = _shard(p_entity);
+		RID observed;
+		{
+			MutexLock lock(shard.mutex);
+			if (const RID *existing = shard.map.getptr(p_entity)) {
+				observed = *existing;
+			}
+		}
+		if (observed.is_valid() && p_is_valid(observed)) {
+			return observed;
+		}
+
+		RID rid = p_make();
+		RID discarded;
+		{
+			MutexLock lock(shard.mutex);
+			RID *existing = shard.map.getptr(p_entity);
+			if (!existing) {
+				shard.map.insert(p_entity, rid);
+			} else if (*existing == observed) {
+				discarded = observed;
+				*existing = rid;
+			} else {
+				// Another thread published first, keep its RID
+				discarded = rid;
+				rid = *existing;
+			}
+		}
+		if (discarded.is_valid()) {
+			p_discard(discarded);
+		}
+		return rid;
+	}
+
+	void reserve(uint32_t p_total) {
+		const uint32_t per_shard = p_total / SHARD_COUNT + 1;
+		for (Shard &shard : shards) {
+			MutexLock lock(shard.mutex);
+			shard.map.reserve(shard.map.size() + per_shard);
+		}
+	}
+
+	uint32_t size() const {
+		uint32_t total = 0;
+		for (const Shard &shard : shards) {
+			MutexLock lock(shard.mutex);
+			total += shard.map.size();
+		}
+		return total;
+	}
+
+	void clear() {
+		for (Shard &shard : shards) {
+			MutexLock lock(shard.mutex);
+			shard.map.clear();
+		}
+	}
+
+private:
+	// Padded to a cache line so neighbouring shard locks do not false-share
+	struct alignas(64) Shard {
+		mutable Mutex mutex;
+		HashMap<uint64_t, RID> map;
+	};
+
+	Shard shards[SHARD_COUNT];
+
+	// Entity indices are handed out sequentially, so the low bits spread well
+	_FORCE_INLINE_ Shard &_shard(uint64_t p_entity) { return shards[uint32_t(p_entity) & (SHARD_COUNT - 1)]; }
+	_FORCE_INLINE_ const Shard &_shard(uint64_t p_entity) const { return shards[uint32_t(p_entity) & (SHARD_COUNT - 1)]; }
+};
+
+/**
+ * @class EntityWorldIndex
+ * @brief Sharded entity RID -> world RID index
+ *
+ * Every RID-mode entity RID is indexed when it is made, possibly from worker
+ * threads. Shards are picked by the low bits of the RID id (RID_Owner hands
+ * ids out sequentially), so concurrent creators rarely share a lock.
+ */
+class EntityWorldIndex {
+public:
+	static constexpr uint32_t SHARD_COUNT = 64; // Power of two
+
+	EntityWorldIndex() = default;
+	EntityWorldIndex(const EntityWorldIndex &) = delete;
+	EntityWorldIndex &operator=(const EntityWorldIndex &) = delete;
+
+	RID get(const RID &p_entity) const {
+		const Shard &shard = _shard(p_entity);
+		MutexLock lock(shard.mutex);
+		const RID *world = shard.map.getptr(p_entity);
+		return world ? *world : RID();
+	}
+
+	void insert(const RID &p_entity, const RID &p_world) {
+		Shard &shard = _shard(p_entity);
+		MutexLock lock(shard.mutex);
+		shard.map.insert(p_entity, p_world);
+	}
+
+	void erase(const RID &p_entity) {
+		Shard &shard = _shard(p_entity);
+		MutexLock lock(shard.mutex);
+		shard.map.erase(p_entity);
+	}
+
+private:
+	struct alignas(64) Shard {
+		mutable Mutex mutex;
+		HashMap<RID, RID> map;
+	};
+
+	Shard shards[SHARD_COUNT];
+
+	_FORCE_INLINE_ Shard &_shard(const RID &p_entity) { return shards[uint32_t(p_entity.get_id()) & (SHARD_COUNT - 1)]; }
+	_FORCE_INLINE_ const Shard &_shard(const RID &p_entity) const { return shards[uint32_t(p_entity.get_id()) & (SHARD_COUNT - 1)]; }
+};
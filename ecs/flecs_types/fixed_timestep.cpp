@@ -0,0 +1,56 @@
+#include "modules/godot_turbo/ecs/flecs_types/fixed_timestep.h"
+
+#include "core/math/math_funcs.h"
+#include "modules/godot_turbo/ecs/components/all_components.h"
+
+void FixedTimestep::setup(flecs::world &p_world) {
+	p_world.component<FlecsPhases::OnPhysicsUpdate>();
+	pipeline = p_world.pipeline()
+					   .with(flecs::System)
+					   .with<FlecsPhases::OnPhysicsUpdate>()
+					   .build();
+	p_world.set<PhysicsInterpolation>({ alpha, 0.0, 0, tick_count });
+}
+
+uint32_t FixedTimestep::advance(flecs::world &p_world, double p_delta) {
+	uint32_t steps = 1;
+	double step_delta = p_delta;
+	if (tick_rate > 0.0) {
+		step_delta = 1.0 / tick_rate;
+		accumulator += p_delta;
+		// Deltas like 1/60 do not add up exactly; a tick that is short by
+		// rounding error still counts
+		const double epsilon = step_delta * 1e-6;
+		steps = uint32_t((accumulator + epsilon) / step_delta);
+		if (steps > max_steps) {
+			dropped_steps += steps - max_steps;
+			steps = max_steps;
+			accumulator = Math::fmod(accumulator + epsilon, step_delta);
+		} else {
+			accumulator = MAX(accumulator - steps * step_delta, 0.0);
+		}
+		alpha = CLAMP(accumulator / step_delta, 0.0, 1.0);
+	}
+
+	for (uint32_t i = 0; i < steps; i++) {
+		ecs_run_pipeline(p_world.c_ptr(), pipeline, (ecs_ftime_t)step_delta);
+	}
+	tick_count += steps;
+	p_world.set<PhysicsInterpolation>({ alpha, step_delta, steps, tick_count });
+	return steps;
+}
+
+void FixedTimestep::set_tick_rate(double p_ticks_per_second) {
+	tick_rate = MAX(p_ticks_per_second, 0.0);
+	accumulator = 0.0;
+	alpha = tick_rate > 0.0 ? 0.0 : 1.0;
+}
+
+void FixedTimestep::copy_timing(const FixedTimestep &p_other) {
+	tick_rate = p_other.tick_rate;
+	max_steps = p_other.max_steps;
+	accumulator = p_other.accumulator;
+	alpha = p_other.alpha;
+	tick_count = p_other.tick_count;
+	dropped_steps = p_other.dropped_steps;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "modules/godot_turbo/ecs/flecs_types/flecs_phases.h"
+#include "modules/godot_turbo/thirdparty/flecs/distr/flecs.h"
+#include <cstdint>
+
+/**
+ * @class FixedTimestep
+ * @brief Per-world accumulator driving the FlecsPhases::OnPhysicsUpdate phase
+ *
+ * With a tick rate set, advance() adds the frame delta to an accumulator and
+ * runs the physics pipeline once per whole tick it holds, each time with the
+ * fixed delta; variable-rate phases still run once per frame from
+ * world.progress(). The steps run in one frame are capped at max_steps: on a
+ * frame spike the backlog is dropped instead of making the next frame even
+ * longer.
+ *
+ * What is left in the accumulator, as a fraction of a tick, is published in
+ * the PhysicsInterpolation singleton so rendering can blend the last two
+ * physics states instead of forcing the simulation rate up.
+ *
+ * Without a tick rate the physics phase runs once per frame with the frame
+ * delta and the interpolation alpha is always 1.
+ */
+class FixedTimestep {
+public:
+	static constexpr uint32_t DEFAULT_MAX_STEPS = 8;
+
+	// Builds the physics pipeline and the PhysicsInterpolation singleton
+	void setup(flecs::world &p_world);
+
+	// Runs the physics phase for one frame and returns how many steps ran
+	uint32_t advance(flecs::world &p_world, double p_delta);
+
+	// Ticks per second; 0 disables fixed stepping. Resets the accumulator.
+	void set_tick_rate(double p_ticks_per_second);
+	double get_tick_rate() const { return tick_rate; }
+	void set_max_steps(uint32_t p_max_steps) { max_steps = p_max_steps; }
+	uint32_t get_max_steps() const { return max_steps; }
+
+	double get_alpha() const { return alpha; }
+	uint64_t get_tick_count() const { return tick_count; }
+	// Steps skipped by the max_steps clamp so far
+	uint64_t get_dropped_steps() const { return dropped_steps; }
+
+	// Same rate, clamp and accumulator as @p p_other (the pipeline is kept)
+	void copy_timing(const FixedTimestep &p_other);
+
+private:
+	flecs::entity_t pipeline = 0;
+	double tick_rate = 0.0;
+	uint32_t max_steps = DEFAULT_MAX_STEPS;
+	double accumulator = 0.0;
+	double alpha = 1.0;
+	uint64_t tick_count = 0;
+	uint64_t dropped_steps = 0;
+};
@@ -0,0 +1,754 @@
+#include "modules/godot_turbo/ecs/flecs_types/flecs_column_access.h"
+
+#include "core/error/error_macros.h"
+#include "core/math/basis.h"
+#include "core/math/color.h"
+#include "core/math/quaternion.h"
+#include "core/math/transform_2d.h"
+#include "core/math/transform_3d.h"
+#include "core/math/vector2.h"
+#include "core/math/vector3.h"
+#include "core/math/vector4.h"
+#include "core/string/print_string.h"
+#include "core/variant/variant.h"
+#include <cstring>
+
+namespace FlecsColumnAccess {
+
+static ColumnKind _classify_type(flecs::world &p_world, flecs::entity_t p_type, ecs_primitive_kind_t &r_primitive) {
+	flecs::entity type(p_world.c_ptr(), p_type);
+	if (!type.is_valid()) {
+		return COLUMN_INVALID;
+	}
+
+	if (type.has<EcsPrimitive>()) {
+		r_primitive = type.get<EcsPrimitive>().kind;
+		switch (r_primitive) {
+			case EcsBool:
+				return COLUMN_BOOL;
+			case EcsChar:
+			case EcsByte:
+			case EcsI8:
+			case EcsI16:
+			case EcsI32:
+			case EcsU8:
+			case EcsU16:
+				return COLUMN_INT32;
+			case EcsI64:
+			case EcsU32:
+			case EcsU64:
+			case EcsIPtr:
+			case EcsUPtr:
+			case EcsEntity:
+				return COLUMN_INT64;
+			case EcsF32:
+				return COLUMN_FLOAT32;
+			case EcsF64:
+				return COLUMN_FLOAT64;
+			default:
+				return COLUMN_INVALID;
+		}
+	}
+
+	// Godot math types are registered as opaque components (see FlecsOpaqueTypes)
+	if (p_type == p_world.component<Vector2>().id()) {
+		return COLUMN_VECTOR2;
+	}
+	if (p_type == p_world.component<Vector3>().id()) {
+		return COLUMN_VECTOR3;
+	}
+	if (p_type == p_world.component<Vector4>().id()) {
+		return COLUMN_VECTOR4;
+	}
+	if (p_type == p_world.component<Color>().id()) {
+		return COLUMN_COLOR;
+	}
+	if (p_type == p_world.component<Quaternion>().id()) {
+		return COLUMN_QUATERNION;
+	}
+	if (p_type == p_world.component<Basis>().id()) {
+		return COLUMN_BASIS;
+	}
+	if (p_type == p_world.component<Transform2D>().id()) {
+		return COLUMN_TRANSFORM2D;
+	}
+	if (p_type == p_world.component<Transform3D>().id()) {
+		return COLUMN_TRANSFORM3D;
+	}
+	return COLUMN_INVALID;
+}
+
+bool resolve_field(flecs::world &p_world, flecs::entity_t p_component, const String &p_field, FieldLayout &r_layout) {
+	r_layout = FieldLayout();
+
+	flecs::entity comp(p_world.c_ptr(), p_component);
+	if (!comp.is_valid() || !comp.has<EcsComponent>()) {
+		return false;
+	}
+
+	r_layout.component_id = p_component;
+	r_layout.component_size = comp.get<EcsComponent>().size;
+
+	flecs::entity_t member_type = p_component;
+	if (!p_field.is_empty()) {
+		if (!comp.has<EcsStruct>()) {
+			return false;
+		}
+
+		const EcsStruct &ecs_struct = comp.get<EcsStruct>();
+		const ecs_member_t *members = ecs_vec_first_t(&ecs_struct.members, ecs_member_t);
+		const int32_t member_count = ecs_vec_count(&ecs_struct.members);
+		const CharString field_utf8 = p_field.utf8();
+
+		bool found = false;
+		for (int32_t i = 0; i < member_count; i++) {
+			if (members[i].name == nullptr || strcmp(members[i].name, field_utf8.get_data()) != 0) {
+				continue;
+			}
+			// Inline arrays have no single-value packed representation
+			if (members[i].count > 1) {
+				return false;
+			}
+			member_type = members[i].type;
+			r_layout.offset = members[i].offset;
+			found = true;
+			break;
+		}
+		if (!found) {
+			return false;
+		}
+	}
+
+	r_layout.kind = _classify_type(p_world, member_type, r_layout.primitive);
+	return r_layout.kind != COLUMN_INVALID;
+}
+
+void resolve_fields(flecs::world &p_world, flecs::entity_t p_component, LocalVector<String> &r_fields, LocalVector<FieldLayout> &r_layouts) {
+	flecs::entity comp(p_world.c_ptr(), p_component);
+	if (!comp.is_valid() || !comp.has<EcsStruct>()) {
+		return;
+	}
+
+	const EcsStruct &ecs_struct = comp.get<EcsStruct>();
+	const ecs_member_t *members = ecs_vec_first_t(&ecs_struct.members, ecs_member_t);
+	const int32_t member_count = ecs_vec_count(&ecs_struct.members);
+	for (int32_t i = 0; i < member_count; i++) {
+		if (members[i].name == nullptr) {
+			continue;
+		}
+		const String field = String::utf8(members[i].name);
+		FieldLayout layout;
+		if (resolve_field(p_world, p_component, field, layout)) {
+			r_fields.push_back(field);
+			r_layouts.push_back(layout);
+		}
+	}
+}
+
+Variant::Type get_column_array_type(ColumnKind p_kind) {
+	switch (p_kind) {
+		case COLUMN_BOOL:
+			return Variant::PACKED_BYTE_ARRAY;
+		case COLUMN_INT32:
+			return Variant::PACKED_INT32_ARRAY;
+		case COLUMN_INT64:
+			return Variant::PACKED_INT64_ARRAY;
+		case COLUMN_FLOAT64:
+			return Variant::PACKED_FLOAT64_ARRAY;
+		case COLUMN_VECTOR2:
+			return Variant::PACKED_VECTOR2_ARRAY;
+		case COLUMN_VECTOR3:
+			return Variant::PACKED_VECTOR3_ARRAY;
+		case COLUMN_VECTOR4:
+			return Variant::PACKED_VECTOR4_ARRAY;
+		case COLUMN_COLOR:
+			return Variant::PACKED_COLOR_ARRAY;
+		case COLUMN_FLOAT32:
+		case COLUMN_QUATERNION:
+		case COLUMN_BASIS:
+		case COLUMN_TRANSFORM2D:
+		case COLUMN_TRANSFORM3D:
+			return Variant::PACKED_FLOAT32_ARRAY;
+		default:
+			return Variant::NIL;
+	}
+}
+
+int get_column_stride(ColumnKind p_kind) {
+	switch (p_kind) {
+		case COLUMN_QUATERNION:
+			return 4;
+		case COLUMN_BASIS:
+			return 9;
+		case COLUMN_TRANSFORM2D:
+			return 8;
+		case COLUMN_TRANSFORM3D:
+			return 12;
+		case COLUMN_INVALID:
+			return 0;
+		default:
+			return 1;
+	}
+}
+
+int64_t get_column_row_count(ColumnKind p_kind, const Variant &p_column) {
+	const Variant::Type expected = get_column_array_type(p_kind);
+	if (expected == Variant::NIL || p_column.get_type() != expected) {
+		return -1;
+	}
+	int64_t size = 0;
+	switch (expected) {
+		case Variant::PACKED_BYTE_ARRAY:
+			size = PackedByteArray(p_column).size();
+			break;
+		case Variant::PACKED_INT32_ARRAY:
+			size = PackedInt32Array(p_column).size();
+			break;
+		case Variant::PACKED_INT64_ARRAY:
+			size = PackedInt64Array(p_column).size();
+			break;
+		case Variant::PACKED_FLOAT32_ARRAY:
+			size = PackedFloat32Array(p_column).size();
+			break;
+		case Variant::PACKED_FLOAT64_ARRAY:
+			size = PackedFloat64Array(p_column).size();
+			break;
+		case Variant::PACKED_VECTOR2_ARRAY:
+			size = PackedVector2Array(p_column).size();
+			break;
+		case Variant::PACKED_VECTOR3_ARRAY:
+			size = PackedVector3Array(p_column).size();
+			break;
+		case Variant::PACKED_VECTOR4_ARRAY:
+			size = PackedVector4Array(p_column).size();
+			break;
+		case Variant::PACKED_COLOR_ARRAY:
+			size = PackedColorArray(p_column).size();
+			break;
+		default:
+			return -1;
+	}
+	const int stride = get_column_stride(p_kind);
+	if (size % stride != 0) {
+		return -1;
+	}
+	return size / stride;
+}
+
+// ----------------------------------------------------------------------------
+// Element conversion
+// ----------------------------------------------------------------------------
+
+static int64_t _load_int(ecs_primitive_kind_t p_kind, const uint8_t *p_src) {
+	switch (p_kind) {
+		case EcsChar:
+		case EcsI8:
+			return *reinterpret_cast<const int8_t *>(p_src);
+		case EcsByte:
+		case EcsU8:
+			return *p_src;
+		case EcsI16:
+			return *reinterpret_cast<const int16_t *>(p_src);
+		case EcsU16:
+			return *reinterpret_cast<const uint16_t *>(p_src);
+		case EcsI32:
+			return *reinterpret_cast<const int32_t *>(p_src);
+		case EcsU32:
+			return *reinterpret_cast<const uint32_t *>(p_src);
+		case EcsI64:
+		case EcsIPtr:
+			return *reinterpret_cast<const int64_t *>(p_src);
+		case EcsU64:
+		case EcsUPtr:
+		case EcsEntity:
+			return static_cast<int64_t>(*reinterpret_cast<const uint64_t *>(p_src));
+		default:
+			return 0;
+	}
+}
+
+static void _store_int(ecs_primitive_kind_t p_kind, uint8_t *p_dst, int64_t p_value) {
+	switch (p_kind) {
+		case EcsChar:
+		case EcsI8:
+			*reinterpret_cast<int8_t *>(p_dst) = static_cast<int8_t>(p_value);
+			break;
+		case EcsByte:
+		case EcsU8:
+			*p_dst = static_cast<uint8_t>(p_value);
+			break;
+		case EcsI16:
+			*reinterpret_cast<int16_t *>(p_dst) = static_cast<int16_t>(p_value);
+			break;
+		case EcsU16:
+			*reinterpret_cast<uint16_t *>(p_dst) = static_cast<uint16_t>(p_value);
+			break;
+		case EcsI32:
+			*reinterpret_cast<int32_t *>(p_dst) = static_cast<int32_t>(p_value);
+			break;
+		case EcsU32:
+			*reinterpret_cast<uint32_t *>(p_dst) = static_cast<uint32_t>(p_value);
+			break;
+		case EcsI64:
+		case EcsIPtr:
+			*reinterpret_cast<int64_t *>(p_dst) = p_value;
+			break;
+		case EcsU64:
+		case EcsUPtr:
+		case EcsEntity:
+			*reinterpret_cast<uint64_t *>(p_dst) = static_cast<uint64_t>(p_value);
+			break;
+		default:
+			break;
+	}
+}
+
+static void _flatten(const Quaternion &p_q, float *r_dst) {
+	r_dst[0] = p_q.x;
+	r_dst[1] = p_q.y;
+	r_dst[2] = p_q.z;
+	r_dst[3] = p_q.w;
+}
+
+static void _unflatten(const float *p_src, Quaternion &r_q) {
+	r_q = Quaternion(p_src[0], p_src[1], p_src[2], p_src[3]);
+}
+
+static void _flatten(const Basis &p_b, float *r_dst) {
+	for (int r = 0; r < 3; r++) {
+		r_dst[r * 3 + 0] = p_b.rows[r].x;
+		r_dst[r * 3 + 1] = p_b.rows[r].y;
+		r_dst[r * 3 + 2] = p_b.rows[r].z;
+	}
+}
+
+static void _unflatten(const float *p_src, Basis &r_b) {
+	for (int r = 0; r < 3; r++) {
+		r_b.rows[r] = Vector3(p_src[r * 3 + 0], p_src[r * 3 + 1], p_src[r * 3 + 2]);
+	}
+}
+
+static void _flatten(const Transform2D &p_t, float *r_dst) {
+	r_dst[0] = p_t.columns[0].x;
+	r_dst[1] = p_t.columns[1].x;
+	r_dst[2] = 0.0f;
+	r_dst[3] = p_t.columns[2].x;
+	r_dst[4] = p_t.columns[0].y;
+	r_dst[5] = p_t.columns[1].y;
+	r_dst[6] = 0.0f;
+	r_dst[7] = p_t.columns[2].y;
+}
+
+static void _unflatten(const float *p_src, Transform2D &r_t) {
+	r_t.columns[0] = Vector2(p_src[0], p_src[4]);
+	r_t.columns[1] = Vector2(p_src[1], p_src[5]);
+	r_t.columns[2] = Vector2(p_src[3], p_src[7]);
+}
+
+static void _flatten(const Transform3D &p_t, float *r_dst) {
+	for (int r = 0; r < 3; r++) {
+		r_dst[r * 4 + 0] = p_t.basis.rows[r].x;
+		r_dst[r * 4 + 1] = p_t.basis.rows[r].y;
+		r_dst[r * 4 + 2] = p_t.basis.rows[r].z;
+		r_dst[r * 4 + 3] = p_t.origin[r];
+	}
+}
+
+static void _unflatten(const float *p_src, Transform3D &r_t) {
+	for (int r = 0; r < 3; r++) {
+		r_t.basis.rows[r] = Vector3(p_src[r * 4 + 0], p_src[r * 4 + 1], p_src[r * 4 + 2]);
+		r_t.origin[r] = p_src[r * 4 + 3];
+	}
+}
+
+// ----------------------------------------------------------------------------
+// Table iteration
+// ----------------------------------------------------------------------------
+
+// Invokes p_fn(field_base, count, first_row, iter) once per matched table slice.
+// field_base points at the field of the first row and is null when the table
+// does not store the component. With p_inherited set, rows that inherit the
+// component from a prefab are passed one at a time, pointing at the prefab's
+// value; writers leave it unset so they never modify the prefab.
+template <typename F>
+static int64_t _for_each_slice(flecs::world &p_world, flecs::query<> &p_query, const FieldLayout &p_layout, F &&p_fn, bool p_inherited = false) {
+	int64_t row = 0;
+	p_query.run([&](flecs::iter &it) {
+		while (it.next()) {
+			ecs_iter_t *iter = it.c_ptr();
+			uint8_t *base = nullptr;
+			if (iter->table) {
+				base = static_cast<uint8_t *>(ecs_table_get_id(p_world.c_ptr(), iter->table, p_layout.component_id, iter->offset));
+			}
+			if (!base && p_inherited && iter->count > 0) {
+				// Rows of one table have the same IsA bases, so they share the value
+				uint8_t *shared = static_cast<uint8_t *>(const_cast<void *>(ecs_get_id(p_world.c_ptr(), iter->entities[0], p_layout.component_id)));
+				if (shared) {
+					for (int32_t i = 0; i < iter->count; i++) {
+						p_fn(shared + p_layout.offset, 1, row + i, iter);
+					}
+					row += iter->count;
+					continue;
+				}
+			}
+			p_fn(base ? base + p_layout.offset : nullptr, iter->count, row, iter);
+			row += iter->count;
+		}
+	});
+	return row;
+}
+
+template <typename TArray, typename T>
+static Variant _read_direct(flecs::world &p_world, flecs::query<> &p_query, const FieldLayout &p_layout, int64_t p_rows) {
+	TArray out;
+	out.resize(p_rows);
+	T *w = out.ptrw();
+	const int32_t stride = p_layout.component_size;
+	_for_each_slice(p_world, p_query, p_layout, [&](const uint8_t *p_src, int32_t p_count, int64_t p_row, ecs_iter_t *) {
+		const int64_t count = MIN(int64_t(p_count), p_rows - p_row);
+		for (int64_t i = 0; i < count; i++) {
+			w[p_row + i] = p_src ? *reinterpret_cast<const T *>(p_src + i * stride) : T();
+		}
+	}, true);
+	return out;
+}
+
+template <typename T>
+static Variant _read_flattened(flecs::world &p_world, flecs::query<> &p_query, const FieldLayout &p_layout, int64_t p_rows) {
+	const int elems = get_column_stride(p_layout.kind);
+	PackedFloat32Array out;
+	out.resize(p_rows * elems);
+	float *w = out.ptrw();
+	const int32_t stride = p_layout.component_size;
+	_for_each_slice(p_world, p_query, p_layout, [&](const uint8_t *p_src, int32_t p_count, int64_t p_row, ecs_iter_t *) {
+		const int64_t count = MIN(int64_t(p_count), p_rows - p_row);
+		for (int64_t i = 0; i < count; i++) {
+			_flatten(p_src ? *reinterpret_cast<const T *>(p_src + i * stride) : T(), w + (p_row + i) * elems);
+		}
+	}, true);
+	return out;
+}
+
+template <typename TArray, typename TElem>
+static Variant _read_numeric(flecs::world &p_world, flecs::query<> &p_query, const FieldLayout &p_layout, int64_t p_rows) {
+	TArray out;
+	out.resize(p_rows);
+	TElem *w = out.ptrw();
+	const int32_t stride = p_layout.component_size;
+	const ecs_primitive_kind_t prim = p_layout.primitive;
+	_for_each_slice(p_world, p_query, p_layout, [&](const uint8_t *p_src, int32_t p_count, int64_t p_row, ecs_iter_t *) {
+		const int64_t count = MIN(int64_t(p_count), p_rows - p_row);
+		for (int64_t i = 0; i < count; i++) {
+			TElem value = TElem();
+			if (p_src) {
+				const uint8_t *field = p_src + i * stride;
+				if (prim == EcsF32) {
+					value = static_cast<TElem>(*reinterpret_cast<const float *>(field));
+				} else if (prim == EcsF64) {
+					value = static_cast<TElem>(*reinterpret_cast<const double *>(field));
+				} else if (prim == EcsBool) {
+					value = static_cast<TElem>(*reinterpret_cast<const bool *>(field) ? 1 : 0);
+				} else {
+					value = static_cast<TElem>(_load_int(prim, field));
+				}
+			}
+			w[p_row + i] = value;
+		}
+	}, true);
+	return out;
+}
+
+Variant read_column(flecs::world &p_world, flecs::query<> &p_query, const FieldLayout &p_layout) {
+	const int64_t rows = p_query.count();
+	switch (p_layout.kind) {
+		case COLUMN_BOOL:
+			return _read_numeric<PackedByteArray, uint8_t>(p_world, p_query, p_layout, rows);
+		case COLUMN_INT32:
+			return _read_numeric<PackedInt32Array, int32_t>(p_world, p_query, p_layout, rows);
+		case COLUMN_INT64:
+			return _read_numeric<PackedInt64Array, int64_t>(p_world, p_query, p_layout, rows);
+		case COLUMN_FLOAT32:
+			return _read_numeric<PackedFloat32Array, float>(p_world, p_query, p_layout, rows);
+		case COLUMN_FLOAT64:
+			return _read_numeric<PackedFloat64Array, double>(p_world, p_query, p_layout, rows);
+		case COLUMN_VECTOR2:
+			return _read_direct<PackedVector2Array, Vector2>(p_world, p_query, p_layout, rows);
+		case COLUMN_VECTOR3:
+			return _read_direct<PackedVector3Array, Vector3>(p_world, p_query, p_layout, rows);
+		case COLUMN_VECTOR4:
+			return _read_direct<PackedVector4Array, Vector4>(p_world, p_query, p_layout, rows);
+		case COLUMN_COLOR:
+			return _read_direct<PackedColorArray, Color>(p_world, p_query, p_layout, rows);
+		case COLUMN_QUATERNION:
+			return _read_flattened<Quaternion>(p_world, p_query, p_layout, rows);
+		case COLUMN_BASIS:
+			return _read_flattened<Basis>(p_world, p_query, p_layout, rows);
+		case COLUMN_TRANSFORM2D:
+			return _read_flattened<Transform2D>(p_world, p_query, p_layout, rows);
+		case COLUMN_TRANSFORM3D:
+			return _read_flattened<Transform3D>(p_world, p_query, p_layout, rows);
+		default:
+			ERR_PRINT("FlecsColumnAccess::read_column: field has no packed representation");
+			return Variant();
+	}
+}
+
+PackedInt64Array read_entity_ids(flecs::query<> &p_query) {
+	static_assert(sizeof(flecs::entity_t) == sizeof(int64_t));
+	PackedInt64Array out;
+	out.resize(p_query.count());
+	int64_t *w = out.ptrw();
+	const int64_t rows = out.size();
+	int64_t row = 0;
+	p_query.run([&](flecs::iter &it) {
+		while (it.next()) {
+			const ecs_iter_t *iter = it.c_ptr();
+			const int64_t count = MIN(int64_t(iter->count), rows - row);
+			if (count > 0) {
+				memcpy(w + row, iter->entities, count * sizeof(int64_t));
+			}
+			row += iter->count;
+		}
+	});
+	return out;
+}
+
+// ----------------------------------------------------------------------------
+// Write-back
+// ----------------------------------------------------------------------------
+
+// Slice sources for write-back. Each one calls
+// p_fn(field_base, count, first_row, entities, table, table_row) per
+// contiguous run of rows of one table.
+
+struct QuerySlices {
+	flecs::world &world;
+	flecs::query<> &query;
+	const FieldLayout &layout;
+
+	template <typename F>
+	void operator()(F &&p_fn) const {
+		_for_each_slice(world, query, layout, [&](uint8_t *p_dst, int32_t p_count, int64_t p_row, ecs_iter_t *p_iter) {
+			p_fn(p_dst, p_count, p_row, p_iter->entities, p_iter->table, p_iter->offset);
+		});
+	}
+};
+
+// Groups an entity list into runs that sit next to each other in the same
+// table, so entities created by ecs_bulk_init are written as a single slice.
+struct EntitySlices {
+	flecs::world &world;
+	const flecs::entity_t *entities;
+	int32_t count;
+	const FieldLayout &layout;
+
+	template <typename F>
+	void operator()(F &&p_fn) const {
+		// Lookups go to the real world, so this also works when writing through a stage
+		ecs_world_t *w = const_cast<ecs_world_t *>(ecs_get_world(world.c_ptr()));
+		int32_t i = 0;
+		while (i < count) {
+			const ecs_record_t *record = ecs_record_find(w, entities[i]);
+			if (!record || !record->table) {
+				i++;
+				continue;
+			}
+			const int32_t row = ECS_RECORD_TO_ROW(record->row);
+			int32_t run = 1;
+			while (i + run < count) {
+				const ecs_record_t *next = ecs_record_find(w, entities[i + run]);
+				if (!next || next->table != record->table || ECS_RECORD_TO_ROW(next->row) != row + run) {
+					break;
+				}
+				run++;
+			}
+			uint8_t *base = static_cast<uint8_t *>(ecs_table_get_id(w, record->table, layout.component_id, row));
+			p_fn(base ? base + layout.offset : nullptr, run, i, entities + i, record->table, row);
+			i += run;
+		}
+	}
+};
+
+struct WrittenSlice {
+	ecs_table_t *table = nullptr;
+	int32_t offset = 0;
+	int32_t count = 0;
+	flecs::entity_t first = 0;
+};
+
+// Notifies one written table slice with two events instead of one per row.
+// modified() on the first row is what flags the table for change detection;
+// the remaining rows get a single OnSet emitted for the whole range.
+static void _emit_slice_on_set(ecs_world_t *p_world, flecs::entity_t p_component, const WrittenSlice &p_slice) {
+	ecs_modified_id(p_world, p_slice.first, p_component);
+	if (p_slice.count < 2) {
+		return;
+	}
+	ecs_id_t id = p_component;
+	ecs_type_t ids = { &id, 1 };
+	ecs_event_desc_t desc = {};
+	desc.event = EcsOnSet;
+	desc.ids = &ids;
+	desc.table = p_slice.table;
+	desc.offset = p_slice.offset + 1;
+	desc.count = p_slice.count - 1;
+	// The writer may be handed a stage; observers live on the world
+	desc.observable = const_cast<ecs_world_t *>(ecs_get_world(p_world));
+	ecs_emit(p_world, &desc);
+}
+
+// Runs the write inside a deferred block and emits OnSet for every written
+// row, either per entity or per table slice once all rows are stored.
+// A table event does not run on_set hooks, so components with one are
+// always notified per entity.
+template <typename TSlices, typename F>
+static void _write_slices(flecs::world &p_world, const FieldLayout &p_layout, const TSlices &p_slices, bool p_table_events, F &&p_store) {
+	ecs_world_t *world = p_world.c_ptr();
+	const flecs::entity_t comp = p_layout.component_id;
+	if (p_table_events) {
+		const ecs_type_info_t *info = ecs_get_type_info(world, comp);
+		p_table_events = !(info && info->hooks.on_set);
+	}
+	LocalVector<WrittenSlice> written;
+	p_world.defer_begin();
+	p_slices([&](uint8_t *p_dst, int32_t p_count, int64_t p_row, const flecs::entity_t *p_entities, ecs_table_t *p_table, int32_t p_table_row) {
+		if (!p_dst || p_count <= 0) {
+			return;
+		}
+		p_store(p_dst, p_count, p_row);
+		if (p_table_events) {
+			written.push_back({ p_table, p_table_row, p_count, p_entities[0] });
+			return;
+		}
+		for (int32_t i = 0; i < p_count; i++) {
+			ecs_modified_id(world, p_entities[i], comp);
+		}
+	});
+	for (const WrittenSlice &slice : written) {
+		_emit_slice_on_set(world, comp, slice);
+	}
+	p_world.defer_end();
+}
+
+template <typename TArray, typename T, typename TSlices>
+static void _write_direct(flecs::world &p_world, const FieldLayout &p_layout, const TSlices &p_slices, bool p_table_events, const TArray &p_src) {
+	const T *r = p_src.ptr();
+	const int32_t stride = p_layout.component_size;
+	_write_slices(p_world, p_layout, p_slices, p_table_events, [&](uint8_t *p_dst, int32_t p_count, int64_t p_row) {
+		for (int32_t i = 0; i < p_count; i++) {
+			*reinterpret_cast<T *>(p_dst + i * stride) = r[p_row + i];
+		}
+	});
+}
+
+template <typename T, typename TSlices>
+static void _write_flattened(flecs::world &p_world, const FieldLayout &p_layout, const TSlices &p_slices, bool p_table_events, const PackedFloat32Array &p_src) {
+	const int elems = get_column_stride(p_layout.kind);
+	const float *r = p_src.ptr();
+	const int32_t stride = p_layout.component_size;
+	_write_slices(p_world, p_layout, p_slices, p_table_events, [&](uint8_t *p_dst, int32_t p_count, int64_t p_row) {
+		for (int32_t i = 0; i < p_count; i++) {
+			_unflatten(r + (p_row + i) * elems, *reinterpret_cast<T *>(p_dst + i * stride));
+		}
+	});
+}
+
+template <typename TArray, typename TElem, typename TSlices>
+static void _write_numeric(flecs::world &p_world, const FieldLayout &p_layout, const TSlices &p_slices, bool p_table_events, const TArray &p_src) {
+	const TElem *r = p_src.ptr();
+	const int32_t stride = p_layout.component_size;
+	const ecs_primitive_kind_t prim = p_layout.primitive;
+	_write_slices(p_world, p_layout, p_slices, p_table_events, [&](uint8_t *p_dst, int32_t p_count, int64_t p_row) {
+		for (int32_t i = 0; i < p_count; i++) {
+			uint8_t *field = p_dst + i * stride;
+			const TElem value = r[p_row + i];
+			if (prim == EcsF32) {
+				*reinterpret_cast<float *>(field) = static_cast<float>(value);
+			} else if (prim == EcsF64) {
+				*reinterpret_cast<double *>(field) = static_cast<double>(value);
+			} else if (prim == EcsBool) {
+				*reinterpret_cast<bool *>(field) = value != 0;
+			} else {
+				_store_int(prim, field, static_cast<int64_t>(value));
+			}
+		}
+	});
+}
+
+template <typename TSlices>
+static bool _write_column(flecs::world &p_world, const FieldLayout &p_layout, const TSlices &p_slices, bool p_table_events, const Variant &p_column) {
+	switch (p_layout.kind) {
+		case COLUMN_BOOL:
+			_write_numeric<PackedByteArray, uint8_t>(p_world, p_layout, p_slices, p_table_events, p_column);
+			break;
+		case COLUMN_INT32:
+			_write_numeric<PackedInt32Array, int32_t>(p_world, p_layout, p_slices, p_table_events, p_column);
+			break;
+		case COLUMN_INT64:
+			_write_numeric<PackedInt64Array, int64_t>(p_world, p_layout, p_slices, p_table_events, p_column);
+			break;
+		case COLUMN_FLOAT32:
+			_write_numeric<PackedFloat32Array, float>(p_world, p_layout, p_slices, p_table_events, p_column);
+			break;
+		case COLUMN_FLOAT64:
+			_write_numeric<PackedFloat64Array, double>(p_world, p_layout, p_slices, p_table_events, p_column);
+			break;
+		case COLUMN_VECTOR2:
+			_write_direct<PackedVector2Array, Vector2>(p_world, p_layout, p_slices, p_table_events, p_column);
+			break;
+		case COLUMN_VECTOR3:
+			_write_direct<PackedVector3Array, Vector3>(p_world, p_layout, p_slices, p_table_events, p_column);
+			break;
+		case COLUMN_VECTOR4:
+			_write_direct<PackedVector4Array, Vector4>(p_world, p_layout, p_slices, p_table_events, p_column);
+			break;
+		case COLUMN_COLOR:
+			_write_direct<PackedColorArray, Color>(p_world, p_layout, p_slices, p_table_events, p_column);
+			break;
+		case COLUMN_QUATERNION:
+			_write_flattened<Quaternion>(p_world, p_layout, p_slices, p_table_events, p_column);
+			break;
+		case COLUMN_BASIS:
+			_write_flattened<Basis>(p_world, p_layout, p_slices, p_table_events, p_column);
+			break;
+		case COLUMN_TRANSFORM2D:
+			_write_flattened<Transform2D>(p_world, p_layout, p_slices, p_table_events, p_column);
+			break;
+		case COLUMN_TRANSFORM3D:
+			_write_flattened<Transform3D>(p_world, p_layout, p_slices, p_table_events, p_column);
+			break;
+		default:
+			return false;
+	}
+	return true;
+}
+
+static bool _check_column(const FieldLayout &p_layout, const Variant &p_column, int64_t p_rows, const char *p_what) {
+	const int64_t column_rows = get_column_row_count(p_layout.kind, p_column);
+	if (column_rows < 0) {
+		ERR_PRINT(vformat("FlecsColumnAccess::%s: expected %s, got %s", p_what,
+				Variant::get_type_name(get_column_array_type(p_layout.kind)), Variant::get_type_name(p_column.get_type())));
+		return false;
+	}
+	if (column_rows != p_rows) {
+		ERR_PRINT(vformat("FlecsColumnAccess::%s: column has %d rows but %d entities are targeted", p_what, column_rows, p_rows));
+		return false;
+	}
+	return true;
+}
+
+bool write_column(flecs::world &p_world, flecs::query<> &p_query, const FieldLayout &p_layout, const Variant &p_column, bool p_table_events) {
+	if (!_check_column(p_layout, p_column, p_query.count(), "write_column")) {
+		return false;
+	}
+	return _write_column(p_world, p_layout, QuerySlices{ p_world, p_query, p_layout }, p_table_events, p_column);
+}
+
+bool write_entities(flecs::world &p_world, const flecs::entity_t *p_entities, int32_t p_count, const FieldLayout &p_layout, const Variant &p_column, bool p_table_events) {
+	if (!_check_column(p_layout, p_column, p_count, "write_entities")) {
+		return false;
+	}
+	return _write_column(p_world, p_layout, EntitySlices{ p_world, p_entities, p_count, p_layout }, p_table_events, p_column);
+}
+
+} // namespace FlecsColumnAccess
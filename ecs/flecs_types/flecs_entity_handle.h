@@ -0,0 +1,61 @@
+#pragma once
+
+#include "core/templates/rid.h"
+#include "modules/godot_turbo/thirdparty/flecs/distr/flecs.h"
+#include <cstdint>
+
+/**
+ * @namespace FlecsEntityHandle
+ * @brief Dense entity handles derived straight from Flecs entity ids
+ *
+ * In FlecsServer::ENTITY_HANDLE_DENSE mode, the RID handed to scripts is not a
+ * RID_Owner slot but an encoding of the Flecs entity id (index + generation)
+ * and the world it lives in, so creating one allocates nothing:
+ *
+ *   bit  63     : handle tag (RID_Owner validators never set it)
+ *   bits 56..62 : world slot generation
+ *   bits 48..55 : world slot
+ *   bits  0..47 : Flecs entity id (32-bit index + 16-bit generation)
+ *
+ * A recycled entity index gets a new Flecs generation and a recycled world
+ * slot a new slot generation, so stale handles fail to resolve instead of
+ * aliasing a new entity.
+ */
+namespace FlecsEntityHandle {
+
+constexpr uint64_t HANDLE_BIT = uint64_t(1) << 63;
+constexpr uint64_t ENTITY_MASK = (uint64_t(1) << 48) - 1;
+constexpr uint32_t SLOT_SHIFT = 48;
+constexpr uint32_t SLOT_MASK = 0xFF;
+constexpr uint32_t GENERATION_SHIFT = 56;
+constexpr uint32_t GENERATION_MASK = 0x7F;
+
+_FORCE_INLINE_ bool is_handle(const RID &p_rid) {
+	return (p_rid.get_id() & HANDLE_BIT) != 0;
+}
+
+// Pairs and flagged ids do not fit in 48 bits and stay on RID_Owner
+_FORCE_INLINE_ bool can_encode(flecs::entity_t p_entity) {
+	return p_entity != 0 && (p_entity & ~ENTITY_MASK) == 0;
+}
+
+_FORCE_INLINE_ RID encode(uint32_t p_slot, uint32_t p_generation, flecs::entity_t p_entity) {
+	return RID::from_uint64(HANDLE_BIT |
+			(uint64_t(p_generation & GENERATION_MASK) << GENERATION_SHIFT) |
+			(uint64_t(p_slot & SLOT_MASK) << SLOT_SHIFT) |
+			(p_entity & ENTITY_MASK));
+}
+
+_FORCE_INLINE_ uint32_t get_slot(const RID &p_handle) {
+	return uint32_t(p_handle.get_id() >> SLOT_SHIFT) & SLOT_MASK;
+}
+
+_FORCE_INLINE_ uint32_t get_generation(const RID &p_handle) {
+	return uint32_t(p_handle.get_id() >> GENERATION_SHIFT) & GENERATION_MASK;
+}
+
+_FORCE_INLINE_ flecs::entity_t get_entity(const RID &p_handle) {
+	return p_handle.get_id() & ENTITY_MASK;
+}
+
+} // namespace FlecsEntityHandle
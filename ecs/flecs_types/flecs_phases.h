@@ -2,8 +2,12 @@
 
 #include "modules/godot_turbo/thirdparty/flecs/distr/flecs.h"
 
-// Flecs upstream doesn't define an OnPhysicsUpdate phase in this version.
-// Alias it to OnUpdate so existing code/tests compile and run consistently.
-namespace flecs {
-inline const flecs::entity_t OnPhysicsUpdate = flecs::OnUpdate;
-} // namespace flecs
+namespace FlecsPhases {
+
+// Flecs upstream doesn't define a physics phase. OnPhysicsUpdate is a tag
+// used as a phase (.kind<FlecsPhases::OnPhysicsUpdate>()) that is not a
+// flecs::Phase, so the default pipeline skips it: FixedTimestep runs the
+// systems in it from a pipeline of their own, 0..N times per frame.
+struct OnPhysicsUpdate {};
+
+} // namespace FlecsPhases
@@ -6,6 +6,7 @@
 #include "core/os/os.h"
 #include "core/string/string_name.h"
 #include "core/variant/dictionary.h"
+#include "modules/godot_turbo/ecs/flecs_types/component_name_cache.h"
 #include "modules/godot_turbo/ecs/flecs_types/flecs_server.h"
 #include "modules/godot_turbo/ecs/components/component_reflection.h"
 #include "modules/godot_turbo/debug/ecs_trace_bridge.h"
@@ -18,10 +19,10 @@ static flecs::entity resolve_component_entity(flecs::world *world, const String
         return flecs::entity();
     }
 
-    const CharString utf8 = name.utf8();
-    flecs::entity comp = world->lookup(utf8.get_data());
-    if (comp.is_valid()) {
-        return comp;
+    // Exact names go through the server's interned name cache
+    const flecs::entity_t cached = ComponentNameCache::get().lookup(*world, StringName(name));
+    if (cached) {
+        return world->entity(cached);
     }
 
     if (name.find("::") != -1) {
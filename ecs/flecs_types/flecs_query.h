@@ -133,6 +133,7 @@ public:
     
     // Internal access (for FlecsServer)
     flecs::world* _get_world() const { return world; }
+    flecs::query<> &_get_flecs_query() { return query; }
     void _set_world(flecs::world *p_world) { world = p_world; }
     RID get_world() const { return world_id; }
     void set_world(const RID &p_world_id);
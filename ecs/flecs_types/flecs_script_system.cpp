@@ -7,6 +7,7 @@
 #include "core/variant/array.h"
 #include "core/variant/dictionary.h"
 #include "core/variant/variant.h"
+#include "modules/godot_turbo/ecs/components/all_components.h"
 #include "modules/godot_turbo/ecs/components/component_reflection.h"
 #include "modules/godot_turbo/thirdparty/flecs/distr/flecs.h"
 #include "modules/godot_turbo/ecs/flecs_types/flecs_server.h"
@@ -66,6 +67,81 @@ static flecs::entity resolve_component_entity(flecs::world *world, const String
 
 	return resolved;
 }
+
+// A second handle on a packed column's buffer. It keeps the buffer shared, so
+// a write through the handle in the batch copies it to a new address.
+static Variant retain_column(const Variant &p_column) {
+	switch (p_column.get_type()) {
+		case Variant::PACKED_BYTE_ARRAY:
+			return PackedByteArray(p_column);
+		case Variant::PACKED_INT32_ARRAY:
+			return PackedInt32Array(p_column);
+		case Variant::PACKED_INT64_ARRAY:
+			return PackedInt64Array(p_column);
+		case Variant::PACKED_FLOAT32_ARRAY:
+			return PackedFloat32Array(p_column);
+		case Variant::PACKED_FLOAT64_ARRAY:
+			return PackedFloat64Array(p_column);
+		case Variant::PACKED_VECTOR2_ARRAY:
+			return PackedVector2Array(p_column);
+		case Variant::PACKED_VECTOR3_ARRAY:
+			return PackedVector3Array(p_column);
+		case Variant::PACKED_VECTOR4_ARRAY:
+			return PackedVector4Array(p_column);
+		case Variant::PACKED_COLOR_ARRAY:
+			return PackedColorArray(p_column);
+		default:
+			return p_column;
+	}
+}
+
+// Address of a packed column's buffer, without copying it. Unchanged from the
+// one sent out means the callback neither edited nor replaced the column.
+static const void *column_data_ptr(const Variant &p_column) {
+	switch (p_column.get_type()) {
+		case Variant::PACKED_BYTE_ARRAY:
+			return PackedByteArray(p_column).ptr();
+		case Variant::PACKED_INT32_ARRAY:
+			return PackedInt32Array(p_column).ptr();
+		case Variant::PACKED_INT64_ARRAY:
+			return PackedInt64Array(p_column).ptr();
+		case Variant::PACKED_FLOAT32_ARRAY:
+			return PackedFloat32Array(p_column).ptr();
+		case Variant::PACKED_FLOAT64_ARRAY:
+			return PackedFloat64Array(p_column).ptr();
+		case Variant::PACKED_VECTOR2_ARRAY:
+			return PackedVector2Array(p_column).ptr();
+		case Variant::PACKED_VECTOR3_ARRAY:
+			return PackedVector3Array(p_column).ptr();
+		case Variant::PACKED_VECTOR4_ARRAY:
+			return PackedVector4Array(p_column).ptr();
+		case Variant::PACKED_COLOR_ARRAY:
+			return PackedColorArray(p_column).ptr();
+		default:
+			return nullptr;
+	}
+}
+
+static Variant read_member(const FlecsReflection::MemberAccess &p_member, const uint8_t *p_data) {
+	const void *field = p_data + p_member.offset;
+	if (p_member.nested) {
+		return p_member.nested->to_dict(field);
+	}
+	return p_member.read ? p_member.read(field) : Variant();
+}
+
+// Indices of the members named by p_keys, in the order of p_keys
+static void resolve_members(const FlecsReflection::AccessPlan &p_plan, const LocalVector<Variant> &p_keys, LocalVector<uint32_t> &r_members) {
+	r_members.clear();
+	for (const Variant &key : p_keys) {
+		for (uint32_t m = 0; m < p_plan.members.size(); ++m) {
+			if (p_plan.members[m].key == key) {
+				r_members.push_back(m);
+				break;
+			}
+		}
+	}
+}
 } // namespace
 
 // ============================================================================
@@ -78,6 +154,14 @@ void FlecsScriptSystem::cleanup_existing_systems() {
 	if (change_observer_add.is_alive()) { change_observer_add.destruct(); }
 	if (change_observer_remove.is_alive()) { change_observer_remove.destruct(); }
 	if (reset_system.is_alive()) { reset_system.destruct(); }
+	if (columnar_query) { columnar_query.destruct(); }
+	columnar_fields.clear();
+	sent_columns.clear();
+	sent_column_ptrs.clear();
+	std::lock_guard<std::mutex> _l(batch_mtx);
+	pending_added.clear();
+	pending_changed.clear();
+	pending_removed.clear();
 }
 
 Vector<flecs::entity> FlecsScriptSystem::get_component_terms() {
@@ -93,17 +177,129 @@ Vector<flecs::entity> FlecsScriptSystem::get_component_terms() {
 	return comp_terms;
 }
 
-Dictionary FlecsScriptSystem::serialize_entity_components(flecs::entity e) {
-	Dictionary comp_dicts;
-	for (int ci = 0; ci < required_components.size(); ++ci) {
-		String cname = required_components.get(ci);
+void FlecsScriptSystem::build_projection() {
+	projected_components.clear();
+	// Taken before the plans, so an invalidation in between reads as stale
+	projection_generation = FlecsReflection::AccessPlanCache::get().get_generation();
+	for (int i = 0; i < required_components.size(); ++i) {
+		const String cname = required_components.get(i);
 		flecs::entity ce = resolve_component_entity(world, cname);
 		if (!ce.is_valid()) { continue; }
+		ProjectedComponent pc;
+		pc.name = StringName(cname);
+		pc.id = ce.id();
+		if (!projection.is_empty()) {
+			bool whole = false;
+			LocalVector<String> fields;
+			const String prefix = cname + ".";
+			for (const String &path : projection) {
+				if (path == cname) {
+					whole = true;
+				} else if (path.begins_with(prefix)) {
+					fields.push_back(path.substr(prefix.length()));
+				}
+			}
+			if (!whole) {
+				pc.has_data = !fields.is_empty();
+				if (pc.has_data) {
+					pc.plan = FlecsReflection::AccessPlanCache::get().get_plan(*world, pc.id);
+					pc.projected = pc.plan && pc.plan->is_struct;
+					if (!pc.projected) {
+						ERR_PRINT(vformat("FlecsScriptSystem: component '%s' has no reflected members to project; sending it whole", cname));
+					}
+				}
+				if (pc.projected) {
+					for (const String &field : fields) {
+						bool found = false;
+						for (uint32_t m = 0; m < pc.plan->members.size(); ++m) {
+							if (pc.plan->members[m].key == Variant(field)) {
+								pc.members.push_back(m);
+								pc.keys.push_back(pc.plan->members[m].key);
+								found = true;
+								break;
+							}
+						}
+						if (!found) {
+							ERR_PRINT(vformat("FlecsScriptSystem: component '%s' has no member '%s'", cname, field));
+						}
+					}
+				}
+			}
+		}
+		if (pc.has_data && !pc.projected) {
+			// Same choice as Registry::serialize(), made once instead of per row
+			const FlecsReflection::ComponentMeta *meta = FlecsReflection::Registry::get().get_by_id(pc.id);
+			if (meta && meta->serialize) {
+				pc.serialize = meta->serialize;
+				pc.plan.reset();
+			} else if (!pc.plan) {
+				pc.plan = FlecsReflection::AccessPlanCache::get().get_plan(*world, pc.id);
+			}
+		}
+		projected_components.push_back(pc);
+	}
+	for (const String &path : projection) {
+		if (path == PROJECTION_TAG_ONLY) { continue; }
+		if (!required_components.has(path.get_slicec('.', 0))) {
+			ERR_PRINT(vformat("FlecsScriptSystem: projection entry '%s' does not name a required component", path));
+		}
+	}
+}
+
+void FlecsScriptSystem::resize_stage_accumulators(uint32_t p_count) {
+	stage_accumulators.reset(p_count > 0 ? new StageAccumulator[p_count] : nullptr);
+	stage_accumulator_count = p_count;
+}
+
+void FlecsScriptSystem::refresh_projection_plans() {
+	const uint64_t generation = FlecsReflection::AccessPlanCache::get().get_generation();
+	if (generation == projection_generation) { return; }
+	projection_generation = generation;
+	// Plans are dropped when reflection data changes; member indices only hold
+	// for the plan they were resolved against
+	for (ProjectedComponent &pc : projected_components) {
+		if (!pc.has_data || pc.serialize) { continue; }
+		pc.plan = FlecsReflection::AccessPlanCache::get().get_plan(*world, pc.id);
+		if (pc.projected && pc.plan) {
+			resolve_members(*pc.plan, pc.keys, pc.members);
+		}
+	}
+}
+
+Dictionary FlecsScriptSystem::serialize_entity_components(flecs::entity e, bool p_plans_current) {
+	Dictionary comp_dicts;
+	for (const ProjectedComponent &pc : projected_components) {
 		Dictionary value;
-		if (e.has(ce)) {
-			value = FlecsReflection::Registry::get().serialize(e, ce.id());
+		const uint8_t *data = pc.has_data ? static_cast<const uint8_t *>(e.get(pc.id)) : nullptr;
+		if (!data) {
+			comp_dicts[pc.name] = value;
+			continue;
 		}
-		comp_dicts[StringName(cname)] = value;
+		if (pc.serialize) {
+			value = pc.serialize(data);
+		} else if (p_plans_current) {
+			if (pc.plan && !pc.projected) {
+				value = pc.plan->to_dict(data);
+			} else if (pc.plan) {
+				for (const uint32_t index : pc.members) {
+					const FlecsReflection::MemberAccess &member = pc.plan->members[index];
+					value[member.key] = read_member(member, data);
+				}
+			}
+		} else if (std::shared_ptr<const FlecsReflection::AccessPlan> plan = FlecsReflection::AccessPlanCache::get().get_plan(e.world(), pc.id)) {
+			// Reflection changed during this run and the refresh comes on the
+			// main thread: go through the current plan by member name
+			if (!pc.projected) {
+				value = plan->to_dict(data);
+			} else {
+				for (const FlecsReflection::MemberAccess &member : plan->members) {
+					if (pc.keys.has(member.key)) {
+						value[member.key] = read_member(member, data);
+					}
+				}
+			}
+		}
+		comp_dicts[pc.name] = value;
 	}
 	return comp_dicts;
 }
@@ -122,11 +318,56 @@ void FlecsScriptSystem::update_instrumentation(uint64_t start_time) {
 	}
 }
 
-void FlecsScriptSystem::dispatch_callback(const Array& data) {
+Variant FlecsScriptSystem::dispatch_callback(const Variant& data) {
 	if (use_deferred_calls) {
 		callback.call_deferred(data);
-	} else {
-		callback.call(data);
+		return Variant();
+	}
+	return callback.call(data);
+}
+
+Dictionary FlecsScriptSystem::read_columnar_batch(int64_t p_count) {
+	Dictionary columns;
+	Dictionary component_columns;
+	StringName current_component;
+	sent_columns.resize(columnar_fields.size());
+	sent_column_ptrs.resize(columnar_fields.size());
+	for (uint32_t i = 0; i < columnar_fields.size(); ++i) {
+		const ColumnarField &f = columnar_fields[i];
+		// Fields of one component are contiguous
+		if (f.component != current_component) {
+			component_columns = Dictionary();
+			columns[f.component] = component_columns;
+			current_component = f.component;
+		}
+		const Variant column = FlecsColumnAccess::read_column(*world, columnar_query, f.layout);
+		component_columns[f.field] = column;
+		sent_columns[i] = retain_column(column);
+		sent_column_ptrs[i] = column_data_ptr(column);
+	}
+
+	Dictionary batch;
+	batch["count"] = p_count;
+	batch["entities"] = FlecsColumnAccess::read_entity_ids(columnar_query);
+	batch["columns"] = columns;
+	return batch;
+}
+
+void FlecsScriptSystem::write_back_columns(flecs::world &p_world, const PackedInt64Array &p_entities, const Dictionary &p_columns) {
+	const flecs::entity_t *entities = reinterpret_cast<const flecs::entity_t *>(p_entities.ptr());
+	for (uint32_t i = 0; i < columnar_fields.size(); ++i) {
+		const ColumnarField &f = columnar_fields[i];
+		const Variant *component_columns = p_columns.getptr(f.component);
+		if (!component_columns || component_columns->get_type() != Variant::DICTIONARY) { continue; }
+		const Dictionary fields = *component_columns;
+		const Variant *column = fields.getptr(f.field);
+		if (!column) { continue; }
+		// A column still on the buffer that was sent out was neither replaced
+		// nor edited, whether it was returned or left in the batch
+		if (i < sent_column_ptrs.size() && sent_column_ptrs[i] && column_data_ptr(*column) == sent_column_ptrs[i]) { continue; }
+		if (FlecsColumnAccess::write_entities(p_world, entities, p_entities.size(), f.layout, *column, true) && instrumentation_enabled) {
+			total_columns_written += 1;
+		}
 	}
 }
 
@@ -140,18 +381,30 @@ void FlecsScriptSystem::build_change_observer_system() {
 	// Get the first component ID for tracing
 	uint64_t trace_component_id = comp_terms.size() > 0 ? comp_terms[0].id() : 0;
 	
-	auto make_observer = [this, &comp_terms, trace_component_id](flecs::entity_t evt, uint64_t &last_counter, uint64_t &total_counter) {
+	// Batch mode only records the entity; the flush system dispatches once
+	const bool coalesce = dispatch_mode == DISPATCH_BATCH;
+	
+	auto make_observer = [this, &comp_terms, trace_component_id, coalesce](flecs::entity_t evt, uint64_t &last_counter, uint64_t &total_counter) {
 		flecs::observer_builder<> ob = world->observer();
 		ob.event(evt);
 		for (int i = 0; i < comp_terms.size(); ++i) {
 			ob.with(comp_terms[i].id());
 		}
-		return ob.each([this, &last_counter, &total_counter, trace_component_id](flecs::entity e) {
+		return ob.each([this, evt, &last_counter, &total_counter, trace_component_id, coalesce](flecs::entity e) {
 			if (is_paused || !callback.is_valid()) { return; }
 			
 			// Trace query iteration for neural visualizer
 			ECS_TRACE_QUERY(e.id(), trace_component_id);
 			
+			if (coalesce) {
+				record_change(e, evt);
+				if (instrumentation_enabled) {
+					last_counter += 1;
+					total_counter += 1;
+				}
+				return;
+			}
+			
 			uint64_t t0 = instrumentation_enabled ? OS::get_singleton()->get_ticks_usec() : 0;
 			
 			FlecsServer *server = FlecsServer::get_singleton();
@@ -166,8 +419,10 @@ void FlecsScriptSystem::build_change_observer_system() {
 				return;
 			}
 			
+			// Observers run on the main thread
+			refresh_projection_plans();
 			RID rid = server->_get_or_create_rid_for_entity(wid, e);
-			Dictionary comp_dicts = serialize_entity_components(e);
+			Dictionary comp_dicts = serialize_entity_components(e, true);
 			
 			Array arr;
 			arr.resize(1);
@@ -200,6 +455,122 @@ void FlecsScriptSystem::build_change_observer_system() {
 	}
 }
 
+void FlecsScriptSystem::record_change(flecs::entity e, flecs::entity_t p_event) {
+	const flecs::entity_t entity_id = e.id();
+	if (p_event == flecs::OnRemove) {
+		// The components are gone by the time of the flush, so the row is taken now
+		Dictionary row;
+		FlecsServer *server = FlecsServer::get_singleton();
+		refresh_projection_plans();
+		row["rid"] = server ? server->_get_or_create_rid_for_entity(world_id, e) : RID();
+		row["components"] = serialize_entity_components(e, true);
+		
+		std::lock_guard<std::mutex> _l(batch_mtx);
+		// Added and removed between two flushes: the script never saw it
+		bool coalesced = pending_added.erase(entity_id);
+		if (!coalesced) {
+			coalesced = pending_changed.erase(entity_id) || pending_removed.has(entity_id);
+			pending_removed[entity_id] = row;
+		}
+		if (coalesced && instrumentation_enabled) { total_change_events_coalesced += 1; }
+		return;
+	}
+	
+	std::lock_guard<std::mutex> _l(batch_mtx);
+	bool coalesced = true;
+	if (pending_removed.erase(entity_id)) {
+		// Removed and matched again: to the script it only changed
+		pending_changed.insert(entity_id);
+	} else if (!pending_added.has(entity_id) && !pending_changed.has(entity_id)) {
+		// Entities already pending stay as they are; the flush reads the latest values
+		if (p_event == flecs::OnAdd) {
+			pending_added.insert(entity_id);
+		} else {
+			pending_changed.insert(entity_id);
+		}
+		coalesced = false;
+	}
+	if (coalesced && instrumentation_enabled) { total_change_events_coalesced += 1; }
+}
+
+Array FlecsScriptSystem::build_change_rows(const HashSet<flecs::entity_t> &p_entities) {
+	Array rows;
+	FlecsServer *server = FlecsServer::get_singleton();
+	if (!server) {
+		ERR_PRINT("FlecsScriptSystem change flush: FlecsServer null");
+		return rows;
+	}
+	refresh_projection_plans();
+	for (const flecs::entity_t entity_id : p_entities) {
+		flecs::entity e(world->c_ptr(), entity_id);
+		if (!e.is_alive()) { continue; }
+		// Without OnRemove observation an entity can stop matching unnoticed
+		bool matches = true;
+		for (const ProjectedComponent &pc : projected_components) {
+			if (!e.has(pc.id)) {
+				matches = false;
+				break;
+			}
+		}
+		if (!matches) { continue; }
+		Dictionary row;
+		row["rid"] = server->_get_or_create_rid_for_entity(world_id, e);
+		row["components"] = serialize_entity_components(e, true);
+		rows.push_back(row);
+	}
+	return rows;
+}
+
+void FlecsScriptSystem::flush_change_batch() {
+	// Respect minimum flush interval if configured; events keep coalescing meanwhile
+	if (min_flush_interval_usec > 0) {
+		uint64_t now = OS::get_singleton()->get_ticks_usec();
+		if (last_flush_time_usec != 0 && (now - last_flush_time_usec) < min_flush_interval_usec) {
+			return;
+		}
+	}
+	
+	// Rows are built under the lock, but the callback runs outside of it: it
+	// may set components, which records new changes for the next flush
+	Array added;
+	Array changed;
+	Array removed;
+	{
+		std::lock_guard<std::mutex> _l(batch_mtx);
+		if (pending_added.is_empty() && pending_changed.is_empty() && pending_removed.is_empty()) { return; }
+		added = build_change_rows(pending_added);
+		changed = build_change_rows(pending_changed);
+		for (const KeyValue<flecs::entity_t, Dictionary> &kv : pending_removed) {
+			removed.push_back(kv.value);
+		}
+		pending_added.clear();
+		pending_changed.clear();
+		pending_removed.clear();
+	}
+	
+	const uint64_t row_count = added.size() + changed.size() + removed.size();
+	if (row_count == 0) { return; }
+	
+	Dictionary batch;
+	batch["added"] = added;
+	batch["changed"] = changed;
+	batch["removed"] = removed;
+	
+	uint64_t t0 = instrumentation_enabled ? OS::get_singleton()->get_ticks_usec() : 0;
+	dispatch_callback(batch);
+	
+	if (instrumentation_enabled) {
+		std::lock_guard<std::mutex> _li(instr_mtx);
+		total_entities_processed += row_count;
+		last_frame_entity_count += row_count;
+		total_callbacks_invoked += 1;
+		last_frame_batch_size = row_count;
+		update_instrumentation(t0);
+	}
+	
+	last_flush_time_usec = OS::get_singleton()->get_ticks_usec();
+}
+
 void FlecsScriptSystem::build_task_system() {
 	script_system = world->system()
 		.kind(flecs::OnUpdate)
@@ -241,75 +612,178 @@ void FlecsScriptSystem::build_entity_iteration_system() {
 	// Enable multi-threading for regular entity-iterating systems
 	if (required_components.size() > 0 && multi_threaded) {
 		builder.multi_threaded(true);
+		resize_stage_accumulators(MAX(world->get_stage_count(), 1));
+	} else {
+		resize_stage_accumulators(0);
 	}
 	
-	script_system = builder.each([this, trace_component_id](flecs::entity e) {
-		if (is_paused || !callback.is_valid()) { return; }
-		
-		// Trace query iteration for neural visualizer
-		ECS_TRACE_QUERY(e.id(), trace_component_id);
-		
-		uint64_t t0 = instrumentation_enabled ? OS::get_singleton()->get_ticks_usec() : 0;
+	script_system = builder.run([this, trace_component_id](flecs::iter &it) {
+		if (is_paused || !callback.is_valid()) {
+			it.fini();
+			return;
+		}
 		
 		FlecsServer *server = FlecsServer::get_singleton();
 		if (!server) {
 			ERR_PRINT("FlecsScriptSystem system iter: FlecsServer null");
+			it.fini();
 			return;
 		}
 		
 		RID wid = world_id;
 		if (!wid.is_valid()) {
 			ERR_PRINT("FlecsScriptSystem system iter: invalid world id");
+			it.fini();
 			return;
 		}
 		
-		RID rid = server->_get_or_create_rid_for_entity(wid, e);
-		Dictionary comp_dicts = serialize_entity_components(e);
-		
-		Dictionary row;
-		row["rid"] = rid;
-		row["components"] = comp_dicts;
+		// Workers may not touch projected_components; the batch flush system
+		// refreshes it for them on the main thread
+		if (!multi_threaded) {
+			refresh_projection_plans();
+		}
+		const bool plans_current = FlecsReflection::AccessPlanCache::get().get_generation() == projection_generation;
 		
-		// Multi-threaded: accumulate and flush later
+		// Every worker owns the accumulator of its stage, so rows take no lock
+		StageAccumulator *acc = nullptr;
 		if (multi_threaded) {
-			{
-				std::lock_guard<std::mutex> _l(batch_mtx);
-				batch_accumulator.push_back(row);
-				batch_dirty = true;
+			const int32_t stage_id = it.world().get_stage_id();
+			if (stage_id >= 0 && uint32_t(stage_id) < stage_accumulator_count) {
+				acc = &stage_accumulators[stage_id];
 			}
-			if (instrumentation_enabled) {
-				std::lock_guard<std::mutex> _li(instr_mtx);
-				total_entities_processed += 1;
-				last_frame_entity_count += 1;
+		}
+		
+		while (it.next()) {
+			for (const size_t index : it) {
+				flecs::entity e = it.entity(index);
+				
+				// Trace query iteration for neural visualizer
+				ECS_TRACE_QUERY(e.id(), trace_component_id);
+				
+				uint64_t t0 = instrumentation_enabled ? OS::get_singleton()->get_ticks_usec() : 0;
+				
+				Dictionary comp_dicts = serialize_entity_components(e, plans_current);
+				
+				Dictionary row;
+				if (acc) {
+					// Making the RID here would take the entity owner's lock;
+					// the flush fills it in
+					row["rid"] = RID();
+					row["components"] = comp_dicts;
+					acc->rows.push_back(row);
+					acc->row_entities.push_back(e.id());
+					acc->entities += 1;
+					continue;
+				}
+				row["rid"] = server->_get_or_create_rid_for_entity(wid, e);
+				row["components"] = comp_dicts;
+				
+				// Multi-threaded: accumulate and flush later
+				if (multi_threaded) {
+					// Stages added after the system was built
+					{
+						std::lock_guard<std::mutex> _l(batch_mtx);
+						batch_accumulator.push_back(row);
+						batch_dirty = true;
+					}
+					if (instrumentation_enabled) {
+						std::lock_guard<std::mutex> _li(instr_mtx);
+						total_entities_processed += 1;
+						last_frame_entity_count += 1;
+					}
+					continue;
+				}
+				
+				// Per-entity dispatch
+				if (dispatch_mode == DISPATCH_PER_ENTITY) {
+					Array single;
+					single.resize(1);
+					single[0] = row;
+					
+					dispatch_callback(single);
+					
+					if (instrumentation_enabled) {
+						total_callbacks_invoked += 1;
+						last_frame_batch_size = 1;
+						update_instrumentation(t0);
+					}
+				} else {
+					// Batch accumulation in single-threaded mode
+					batch_accumulator.push_back(row);
+					batch_dirty = true;
+				}
+				
+				if (instrumentation_enabled) {
+					total_entities_processed += 1;
+					last_frame_entity_count += 1;
+				}
 			}
-			return;
 		}
+	});
+	
+	apply_system_name();
+}
+
+void FlecsScriptSystem::build_columnar_system() {
+	// Named so the query belongs to an entity and can be destructed on rebuild
+	const CharString query_name = (String("ScriptSystemColumns") + itos(id)).ascii();
+	flecs::query_builder<> builder = world->query_builder<>(query_name.get_data());
+	for (int i = 0; i < required_components.size(); ++i) {
+		String cname = required_components.get(i);
+		flecs::entity ce = resolve_component_entity(world, cname);
+		if (!ce.is_valid()) {
+			continue;
+		}
+		builder.with(ce.id());
 		
-		// Per-entity dispatch
-		if (dispatch_mode == DISPATCH_PER_ENTITY) {
-			Array single;
-			single.resize(1);
-			single[0] = row;
+		LocalVector<String> fields;
+		LocalVector<FlecsColumnAccess::FieldLayout> layouts;
+		FlecsColumnAccess::resolve_fields(*world, ce.id(), fields, layouts);
+		for (uint32_t fi = 0; fi < fields.size(); ++fi) {
+			columnar_fields.push_back({ StringName(cname), fields[fi], layouts[fi] });
+		}
+	}
+	columnar_query = builder.build();
+	
+	// The query does the table walk, so the system itself has no terms and
+	// always runs on the main thread
+	script_system = world->system()
+		.kind(flecs::OnUpdate)
+		.run([this](flecs::iter& it) {
+			if (is_paused || !callback.is_valid()) { return; }
+			
+			const int64_t count = columnar_query.count();
+			if (count == 0) { return; }
 			
-			dispatch_callback(single);
+			Dictionary batch = read_columnar_batch(count);
+			
+			uint64_t t0 = instrumentation_enabled ? OS::get_singleton()->get_ticks_usec() : 0;
+			
+			const Variant result = dispatch_callback(batch);
+			
+			// Structural changes made by the callback are deferred by the
+			// pipeline, so the rows sent out are still where they were
+			if (!use_deferred_calls) {
+				flecs::world stage = it.world();
+				const bool returned = result.get_type() == Variant::DICTIONARY;
+				write_back_columns(stage, batch["entities"], returned ? Dictionary(result) : Dictionary(batch["columns"]));
+			}
+			sent_columns.clear();
+			sent_column_ptrs.clear();
 			
 			if (instrumentation_enabled) {
+				total_entities_processed += count;
+				last_frame_entity_count += count;
 				total_callbacks_invoked += 1;
-				last_frame_batch_size = 1;
+				last_frame_batch_size = count;
 				update_instrumentation(t0);
 			}
-		} else {
-			// Batch accumulation in single-threaded mode
-			batch_accumulator.push_back(row);
-			batch_dirty = true;
-		}
-		
-		if (instrumentation_enabled) {
-			total_entities_processed += 1;
-			last_frame_entity_count += 1;
-		}
-	});
+		});
 	
+	apply_system_name();
+}
+
+void FlecsScriptSystem::apply_system_name() {
 	String base_name = system_name.is_empty() ? String("ScriptSystem" + itos(id)) : system_name;
 	String unique_name = base_name;
 	if (world) {
@@ -331,8 +805,9 @@ void FlecsScriptSystem::build_batch_flush_system() {
 		return;
 	}
 	
-	// Only create flush system if in batch mode or multi-threaded
-	if (dispatch_mode != DISPATCH_BATCH && !multi_threaded) {
+	// Only create flush system if in batch mode or multi-threaded; columnar
+	// mode dispatches from its own system, per-entity change observers directly
+	if (dispatch_mode == DISPATCH_COLUMNAR || (dispatch_mode != DISPATCH_BATCH && (change_only || !multi_threaded))) {
 		if (batch_flush_system.is_alive()) {
 			batch_flush_system.destruct();
 		}
@@ -344,9 +819,26 @@ void FlecsScriptSystem::build_batch_flush_system() {
 	}
 	
 	batch_flush_system = world->system()
-		.kind(flecs::PostUpdate)
+		.kind(flush_phase != 0 ? flush_phase : flecs::PostUpdate)
 		.run([this](flecs::iter& it) {
-			if (!batch_dirty || is_paused || !callback.is_valid()) { return; }
+			if (is_paused || !callback.is_valid()) { return; }
+			
+			// Workers are idle here, so this is where their rows pick up new plans
+			refresh_projection_plans();
+			
+			if (change_only) {
+				flush_change_batch();
+				return;
+			}
+			
+			bool stages_dirty = false;
+			for (uint32_t i = 0; i < stage_accumulator_count; ++i) {
+				if (!stage_accumulators[i].rows.is_empty()) {
+					stages_dirty = true;
+					break;
+				}
+			}
+			if (!batch_dirty && !stages_dirty) { return; }
 			
 			// Respect minimum flush interval if configured
 			if (min_flush_interval_usec > 0) {
@@ -356,12 +848,48 @@ void FlecsScriptSystem::build_batch_flush_system() {
 				}
 			}
 			
+			// Arrays are shared on assignment, so the accumulator gets a new one
+			// instead of being cleared
 			Array buffered;
 			{
 				std::lock_guard<std::mutex> _l(batch_mtx);
 				batch_dirty = false;
 				buffered = batch_accumulator;
-				batch_accumulator.clear();
+				batch_accumulator = Array();
+			}
+			
+			// Workers are idle in PostUpdate, so their accumulators can be drained
+			FlecsServer *server = FlecsServer::get_singleton();
+			uint64_t staged_entities = 0;
+			for (uint32_t i = 0; i < stage_accumulator_count; ++i) {
+				StageAccumulator &acc = stage_accumulators[i];
+				if (!acc.rows.is_empty()) {
+					// Entities deleted since their row was taken keep an invalid RID
+					for (uint32_t r = 0; server && r < acc.row_entities.size(); ++r) {
+						flecs::entity e(world->c_ptr(), acc.row_entities[r]);
+						if (e.is_alive()) {
+							Dictionary row = acc.rows[r];
+							row["rid"] = server->_get_or_create_rid_for_entity(world_id, e);
+						}
+					}
+					acc.row_entities.clear();
+					if (buffered.is_empty()) {
+						buffered = acc.rows;
+					} else {
+						buffered.append_array(acc.rows);
+					}
+					acc.rows = Array();
+				}
+				staged_entities += acc.entities;
+				acc.entities = 0;
+			}
+			if (instrumentation_enabled && staged_entities > 0) {
+				total_entities_processed += staged_entities;
+				last_frame_entity_count += staged_entities;
+			}
+			// Stages added by set_world_thread_count() get their own accumulator from now on
+			if (multi_threaded && stage_accumulator_count < uint32_t(world->get_stage_count())) {
+				resize_stage_accumulators(world->get_stage_count());
 			}
 			
 			if (buffered.is_empty()) { return; }
@@ -436,16 +964,21 @@ void FlecsScriptSystem::build_system() {
 	}
 	
 	cleanup_existing_systems();
+	build_projection();
 	
 	// Change-only mode uses observers instead of per-frame systems
 	if (change_only) {
 		build_change_observer_system();
+		build_batch_flush_system();
+		mark_script_callbacks();
 		return;
 	}
 	
 	// Build appropriate system type
 	if (required_components.size() == 0) {
 		build_task_system();
+	} else if (dispatch_mode == DISPATCH_COLUMNAR) {
+		build_columnar_system();
 	} else {
 		build_entity_iteration_system();
 	}
@@ -453,11 +986,22 @@ void FlecsScriptSystem::build_system() {
 	// Build supporting systems
 	build_batch_flush_system();
 	build_auto_reset_system();
+	mark_script_callbacks();
+}
+
+void FlecsScriptSystem::mark_script_callbacks() {
+	// The callback is script, so progress_worlds must not run this world on a pool thread
+	flecs::entity dispatchers[] = { script_system, change_observer, change_observer_add, change_observer_remove, batch_flush_system };
+	for (flecs::entity &e : dispatchers) {
+		if (e.is_alive()) {
+			e.add<ScriptCallbackSystem>();
+		}
+	}
 }
 
 void FlecsScriptSystem::set_dispatch_mode(DispatchMode p_mode) {
-	if (change_only && p_mode == DISPATCH_BATCH) {
-		ERR_PRINT("Cannot set batch dispatch while in change-only mode. Disable change-only first.");
+	if (change_only && p_mode == DISPATCH_COLUMNAR) {
+		ERR_PRINT("Cannot set columnar dispatch while in change-only mode. Disable change-only first.");
 		return;
 	}
 	dispatch_mode = (int)p_mode;
@@ -466,8 +1010,8 @@ void FlecsScriptSystem::set_dispatch_mode(DispatchMode p_mode) {
 
 void FlecsScriptSystem::set_change_only(bool p_change_only) {
 	if (change_only == p_change_only) { return; }
-	if (p_change_only && dispatch_mode == (int)DISPATCH_BATCH) {
-		ERR_PRINT("Cannot enable change-only while in batch dispatch mode. Switch to per-entity first.");
+	if (p_change_only && dispatch_mode == (int)DISPATCH_COLUMNAR) {
+		ERR_PRINT("Cannot enable change-only while in columnar dispatch mode. Switch to per-entity or batch first.");
 		return;
 	}
 	change_only = p_change_only;
@@ -509,6 +1053,7 @@ void FlecsScriptSystem::reset(const RID &p_world_id, const PackedStringArray &re
 
 void FlecsScriptSystem::set_required_components(const PackedStringArray &p_required_components) { required_components = p_required_components; build_system(); }
 PackedStringArray FlecsScriptSystem::get_required_components() const { return required_components; }
+void FlecsScriptSystem::set_projection(const PackedStringArray &p_paths) { projection = p_paths; build_system(); }
 void FlecsScriptSystem::set_callback(const Callable &p_callback) { callback = p_callback; build_system(); }
 Callable FlecsScriptSystem::get_callback() const { return callback; }
 PackedStringArray FlecsScriptSystem::get_required_components() { return required_components; }
@@ -536,10 +1081,12 @@ void FlecsScriptSystem::set_system_dependency(uint32_t p_system_id) {
 FlecsScriptSystem::FlecsScriptSystem(const FlecsScriptSystem &other) {
 	callback = other.callback;
 	required_components = other.required_components;
+	projection = other.projection;
 	world_id = other.world_id;
 	world = other.world;
 	dispatch_mode = other.dispatch_mode;
 	batch_flush_chunk_size = other.batch_flush_chunk_size;
+	flush_phase = other.flush_phase;
 	min_flush_interval_usec = other.min_flush_interval_usec;
 	change_only = other.change_only;
 	observe_add_and_set = other.observe_add_and_set;
@@ -564,10 +1111,12 @@ FlecsScriptSystem &FlecsScriptSystem::operator=(const FlecsScriptSystem &other)
 	if (this != &other) {
 		callback = other.callback;
 		required_components = other.required_components;
+		projection = other.projection;
 		world_id = other.world_id;
 		world = other.world;
 		dispatch_mode = other.dispatch_mode;
 		batch_flush_chunk_size = other.batch_flush_chunk_size;
+		flush_phase = other.flush_phase;
 		min_flush_interval_usec = other.min_flush_interval_usec;
 		change_only = other.change_only;
 		observe_add_and_set = other.observe_add_and_set;
@@ -597,6 +1146,7 @@ FlecsScriptSystem::~FlecsScriptSystem() {
 	if (change_observer_remove.is_alive()) { change_observer_remove.destruct(); }
 	if (reset_system.is_alive()) { reset_system.destruct(); }
 	if (batch_flush_system.is_alive()) { batch_flush_system.destruct(); }
+	if (columnar_query) { columnar_query.destruct(); }
 }
 
 double FlecsScriptSystem::get_frame_dispatch_median_usec() const {
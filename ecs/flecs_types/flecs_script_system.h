@@ -12,14 +12,21 @@
 
 #ifndef FLECS_SCRIPT_SYSTEM_H
 #define FLECS_SCRIPT_SYSTEM_H
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "core/typedefs.h"
 #include "core/variant/callable.h"
 #include "core/variant/typed_dictionary.h"
 #include "core/variant/variant.h"
+#include "modules/godot_turbo/ecs/components/component_access_plan.h"
+#include "modules/godot_turbo/ecs/components/component_reflection.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_column_access.h"
 #include "modules/godot_turbo/thirdparty/flecs/distr/flecs.h"
 #include <atomic>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 
 
@@ -33,11 +40,12 @@
  * performance instrumentation, and flexible execution strategies. It can operate as:
  * - Per-entity dispatch: Call GDScript for each matching entity
  * - Batch dispatch: Accumulate entities and send in batches
+ * - Columnar dispatch: Send every matched entity as packed arrays, one per component field
  * - Change-only observers: React only to component changes (OnAdd/OnSet/OnRemove)
  * - Task systems: Execute without entity iteration
  * 
  * @section Features
- * - **Dispatch Modes**: Per-entity or batched for reduced GDScript call overhead
+ * - **Dispatch Modes**: Per-entity, batched or columnar for reduced GDScript call overhead
  * - **Multi-threading**: Optional parallel entity processing (batched automatically)
  * - **Change Observers**: React to component changes instead of polling every frame
  * - **Instrumentation**: Detailed performance metrics (timings, counts, distributions)
@@ -46,6 +54,7 @@
  * 
  * @section Performance
  * - Batch mode: ~10-100x fewer GDScript calls vs per-entity
+ * - Columnar mode: No per-entity Dictionaries; fields are copied table by table
  * - Multi-threaded: Distributes entity processing across CPU cores
  * - Change-only: Processes only changed entities, not all entities every frame
  * 
@@ -68,8 +77,23 @@
  * // Enable batch mode for better performance
  * FlecsServer.set_script_system_dispatch_mode(system_rid, 1) # BATCH
  * FlecsServer.set_script_system_batch_chunk_size(system_rid, 100)
+ * 
+ * // Columnar mode: one call per frame with a packed array per component field
+ * FlecsServer.set_script_system_dispatch_mode(system_rid, 2) # COLUMNAR
+ * 
+ * func update_movement(batch: Dictionary):
+ *     var ids: PackedInt64Array = batch["entities"]
+ *     var transforms: PackedFloat32Array = batch["columns"]["Transform3DComponent"]["transform"]
+ *     # ... modify transforms ...
+ *     return {"Transform3DComponent": {"transform": transforms}} # written back
  * @endcode
  * 
+ * @note Columnar mode copies rows in query table order on the main thread; the
+ *       batch chunk size, flush interval and multi-threaded settings do not apply.
+ *       Columns the callback returns (same shape as batch["columns"]) or edits
+ *       inside batch["columns"] are written back when it returns, with one OnSet
+ *       per table. Deferred calls cannot write back.
+ * 
  * @note Thread-safety: Multi-threaded mode automatically batches and uses mutex protection
  * @warning GDScript callbacks from worker threads require use_deferred_calls = true
  */
@@ -83,6 +107,47 @@ class FlecsScriptSystem {
         RID rid; ///< Entity RID
         TypedDictionary<StringName, Dictionary> comps; ///< Component data
     };
+
+    /**
+     * @struct StageAccumulator
+     * @brief Rows and counters one Flecs stage collects in multi-threaded mode
+     *
+     * Cache line aligned so neighbouring stages do not false-share. Rows leave
+     * the worker without their RID; the flush fills it in on the main thread.
+     * @private
+     */
+    struct alignas(64) StageAccumulator {
+        Array rows; ///< Rows serialized by this stage since the last flush
+        LocalVector<flecs::entity_t> row_entities; ///< Entity of each row, for the RIDs filled in by the flush
+        uint64_t entities = 0; ///< Entities processed by this stage since the last flush
+    };
+
+    /**
+     * @struct ColumnarField
+     * @brief One component field sent as a packed array in columnar mode
+     * @private
+     */
+    struct ColumnarField {
+        StringName component; ///< Required component name the field belongs to
+        String field; ///< Member name
+        FlecsColumnAccess::FieldLayout layout; ///< Resolved offset and column kind
+    };
+
+    /**
+     * @struct ProjectedComponent
+     * @brief How one required component is serialized into an entity row
+     * @private
+     */
+    struct ProjectedComponent {
+        StringName name; ///< Required component name, used as the row key
+        flecs::entity_t id = 0; ///< Resolved component id
+        bool has_data = true; ///< False sends an empty Dictionary (presence only)
+        bool projected = false; ///< Only the members listed are sent
+        FlecsReflection::SerializeFn serialize; ///< Custom serializer of the component; wins over the plan
+        std::shared_ptr<const FlecsReflection::AccessPlan> plan; ///< Plan the member indices refer to
+        LocalVector<uint32_t> members; ///< Projected members, as indices into plan->members
+        LocalVector<Variant> keys; ///< Projected member names, to re-resolve against a rebuilt plan
+    };
     
     // ========================================================================
     // MEMBER VARIABLES
@@ -90,24 +155,37 @@ class FlecsScriptSystem {
     
     Callable callback; ///< GDScript callback function to invoke with entity data
     PackedStringArray required_components; ///< Component names to query for
+    PackedStringArray projection; ///< "Component.field" / "Component" paths to serialize; empty = everything
+    LocalVector<ProjectedComponent> projected_components; ///< Resolved from required_components and projection
+    uint64_t projection_generation = 0; ///< AccessPlanCache generation the plans in projected_components were taken at
     RID world_id; ///< Associated Flecs world RID
     flecs::world *world = nullptr; ///< Pointer to Flecs world instance
     
     // System entities
     flecs::entity script_system; ///< Main system entity handle
-    flecs::entity batch_flush_system; ///< Runs after update to flush batches (PostUpdate)
+    flecs::entity batch_flush_system; ///< Runs after update to flush batches (flush_phase)
+    flecs::entity_t flush_phase = 0; ///< Pipeline phase of batch_flush_system; 0 = PostUpdate
     flecs::entity reset_system; ///< Per-frame auto-reset system (PreUpdate)
     
     // Dispatch configuration
-    int dispatch_mode = 0; ///< 0 = per-entity, 1 = batch (enum defined publicly below)
+    int dispatch_mode = 0; ///< 0 = per-entity, 1 = batch, 2 = columnar (enum defined publicly below)
     
     // Batching support
-    Array batch_accumulator; ///< Accumulates entity data for batch dispatch
+    Array batch_accumulator; ///< Accumulates entity data for batch dispatch (single-threaded, or stages beyond stage_accumulators)
     bool batch_dirty = false; ///< Flag indicating batch has new data
     mutable std::mutex batch_mtx; ///< Protects batch_accumulator & batch_dirty (multi-threaded)
     int batch_flush_chunk_size = 0; ///< 0 = send all at once; >0 = send in chunks
     uint64_t min_flush_interval_usec = 0; ///< Minimum time between flushes (0 = no limit)
     uint64_t last_flush_time_usec = 0; ///< Last flush timestamp in microseconds
+    std::unique_ptr<StageAccumulator[]> stage_accumulators; ///< One per stage, only touched by that stage's worker until the flush; new[] honours the alignment
+    uint32_t stage_accumulator_count = 0; ///< Entries in stage_accumulators
+    
+    // Columnar support
+    flecs::query<> columnar_query; ///< Matches the required components; rows in table order
+    LocalVector<ColumnarField> columnar_fields; ///< Fields copied out per dispatch
+    LocalVector<Variant> sent_columns; ///< Second handles on the last batch's columns, so in-place edits copy the buffer
+    LocalVector<const void *> sent_column_ptrs; ///< Buffer addresses of the last batch's columns; a match means untouched
+    uint64_t total_columns_written = 0; ///< Lifetime columns scattered back from callbacks
     
     // Change-only mode (uses observers instead of per-frame systems)
     bool change_only = false; ///< If true, use observers; if false, use regular systems
@@ -115,6 +193,12 @@ class FlecsScriptSystem {
     flecs::entity change_observer_add; ///< OnAdd observer handle (optional)
     flecs::entity change_observer_remove; ///< OnRemove observer handle (optional)
     
+    // Coalesced change batches (change-only + DISPATCH_BATCH), keyed by entity id; guarded by batch_mtx
+    HashSet<flecs::entity_t> pending_added; ///< Entities that started matching since the last flush
+    HashSet<flecs::entity_t> pending_changed; ///< Entities set since the last flush, unless in pending_added
+    HashMap<flecs::entity_t, Dictionary> pending_removed; ///< Rows taken at OnRemove, while the data still exists
+    uint64_t total_change_events_coalesced = 0; ///< Lifetime events folded into an entity already pending
+    
     // Instrumentation counters
     bool instrumentation_enabled = false; ///< Enable performance tracking
     uint64_t last_frame_entity_count = 0; ///< Entities processed last frame
@@ -162,7 +246,7 @@ class FlecsScriptSystem {
      * Creates appropriate Flecs systems/observers based on:
      * - change_only: observers vs regular systems
      * - required_components.size(): task vs entity iteration
-     * - dispatch_mode: per-entity vs batch
+     * - dispatch_mode: per-entity vs batch vs columnar
      * - multi_threaded: single vs multi-threaded
      * 
      * Also creates auxiliary systems (batch flush, auto-reset) as needed.
@@ -185,23 +269,60 @@ private:
     /** @brief Build entity iteration system (regular or multi-threaded) */
     void build_entity_iteration_system();
     
-    /** @brief Build batch flush system (PostUpdate phase) */
+    /** @brief Build columnar system (query + task system sending packed columns) */
+    void build_columnar_system();
+    
+    /** @brief Give the main system its configured or generated, world-unique name */
+    void apply_system_name();
+    
+    /** @brief Record an observer event for the next coalesced change batch */
+    void record_change(flecs::entity e, flecs::entity_t p_event);
+    
+    /** @brief Serialize pending entities that still match into rows */
+    Array build_change_rows(const HashSet<flecs::entity_t> &p_entities);
+    
+    /** @brief Dispatch pending changes as one {added, changed, removed} Dictionary */
+    void flush_change_batch();
+    
+    /** @brief Build batch flush system (flush_phase, PostUpdate by default) */
     void build_batch_flush_system();
     
     /** @brief Build auto-reset instrumentation system (PreUpdate phase) */
     void build_auto_reset_system();
     
+    /** @brief Tag every entity that dispatches the callback with ScriptCallbackSystem */
+    void mark_script_callbacks();
+    
     /** @brief Convert component names to Flecs entity terms */
     Vector<flecs::entity> get_component_terms();
     
-    /** @brief Serialize all required components from an entity */
-    Dictionary serialize_entity_components(flecs::entity e);
+    /** @brief Resolve required components and the projection into projected_components */
+    void build_projection();
+    
+    /** @brief Replace stage_accumulators with @p p_count empty ones; only while no worker runs */
+    void resize_stage_accumulators(uint32_t p_count);
+    
+    /** @brief Re-take the plans of projected_components if reflection data changed; main thread only */
+    void refresh_projection_plans();
+    
+    /**
+     * @brief Serialize the required components of an entity, limited to the projection
+     * @param p_plans_current Whether projection_generation matched the cache when the caller's run began;
+     *        rows take no lock when it did
+     */
+    Dictionary serialize_entity_components(flecs::entity e, bool p_plans_current);
     
     /** @brief Update instrumentation counters after dispatch */
     void update_instrumentation(uint64_t start_time);
     
-    /** @brief Invoke callback with proper deferred/immediate handling */
-    void dispatch_callback(const Array& data);
+    /** @brief Invoke callback with proper deferred/immediate handling (Array rows or columnar Dictionary); returns its result, or nil when deferred */
+    Variant dispatch_callback(const Variant& data);
+    
+    /** @brief Copy entity ids and every columnar field of the matched tables into one Dictionary */
+    Dictionary read_columnar_batch(int64_t p_count);
+    
+    /** @brief Scatter columns the callback edited or replaced back into storage, one OnSet per table */
+    void write_back_columns(flecs::world &p_world, const PackedInt64Array &p_entities, const Dictionary &p_columns);
     
 public:
 public:
@@ -215,7 +336,8 @@ public:
      */
     enum DispatchMode {
         DISPATCH_PER_ENTITY = 0, ///< Call GDScript once per entity (simple, higher overhead)
-        DISPATCH_BATCH = 1       ///< Accumulate entities and call GDScript with batches (faster)
+        DISPATCH_BATCH = 1,      ///< Accumulate entities and call GDScript with batches (faster)
+        DISPATCH_COLUMNAR = 2    ///< Call GDScript once per frame with packed arrays per field (fastest)
     };
     // ========================================================================
     // CONFIGURATION METHODS
@@ -251,6 +373,12 @@ public:
     /** @brief Set batch chunk size (0 = send all at once, >0 = chunk size) */
     void set_batch_flush_chunk_size(int p_size) { batch_flush_chunk_size = p_size < 0 ? 0 : p_size; }
     
+    /** @brief Set the pipeline phase batches are flushed in (0 = PostUpdate; rebuilds system) */
+    void set_flush_phase(flecs::entity_t p_phase) { flush_phase = p_phase; build_system(); }
+    
+    /** @brief Get the flush phase (0 = PostUpdate) */
+    flecs::entity_t get_flush_phase() const { return flush_phase; }
+    
     /** @brief Get batch chunk size */
     int get_batch_flush_chunk_size() const { return batch_flush_chunk_size; }
     
@@ -306,6 +434,12 @@ public:
     /** @brief Get total callbacks invoked (lifetime) */
     uint64_t get_total_callbacks_invoked() const { return total_callbacks_invoked; }
     
+    /** @brief Get change events merged into an entity already pending (lifetime, change-only batch mode) */
+    uint64_t get_total_change_events_coalesced() const { return total_change_events_coalesced; }
+    
+    /** @brief Get total columns written back by columnar callbacks (lifetime) */
+    uint64_t get_total_columns_written() const { return total_columns_written; }
+    
     /** @brief Get callback invocations this frame */
     uint64_t get_frame_dispatch_invocations() const { return frame_dispatch_invocations; }
     
@@ -403,6 +537,19 @@ public:
     /** @brief Get current callback */
     Callable get_callback() const;
     
+    /** @brief Projection entry that names no component; alone it sends every required component as an empty Dictionary */
+    static constexpr const char *PROJECTION_TAG_ONLY = "#tag_only";
+    
+    /**
+     * @brief Limit row serialization to a projection (rebuilds system)
+     * @param p_paths "Component.field" entries pick members, "Component" keeps a component whole;
+     *        required components not named are sent as an empty Dictionary. Empty = serialize everything.
+     */
+    void set_projection(const PackedStringArray &p_paths);
+    
+    /** @brief Get the projection paths */
+    PackedStringArray get_projection() const { return projection; }
+    
     /** @brief Get required components (duplicate method, kept for compatibility) */
     PackedStringArray get_required_components();
     
@@ -22,12 +22,20 @@
 #include "core/variant/typed_array.h"
 #include "core/variant/variant.h"
 #include "modules/godot_turbo/thirdparty/flecs/distr/flecs.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_column_access.h"
 #include "modules/godot_turbo/ecs/flecs_types/flecs_script_system.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_world_snapshot.h"
+#include "modules/godot_turbo/ecs/flecs_types/transform_propagation.h"
 #include "modules/godot_turbo/ecs/systems/utility/node_storage.h"
 #include "modules/godot_turbo/ecs/systems/utility/ref_storage.h"
+#include "modules/godot_turbo/ecs/systems/utility/scene_object_utility.h"
 #include "core/string/ustring.h"
 #include "flecs_variant.h"
 #include "modules/godot_turbo/ecs/components/all_components.h"
+#include "modules/godot_turbo/ecs/components/component_access_plan.h"
+#include "servers/physics_2d/physics_server_2d.h"
+#include "servers/physics_3d/physics_server_3d.h"
+#include "servers/rendering/rendering_server.h"
 #include <cstdint>
 #include <cstdio>
 
@@ -433,6 +441,8 @@ static Variant cursor_to_variant_impl(flecs::cursor& cur, int depth) {
 // Maximum number of struct members to iterate to prevent infinite loops
 static constexpr int MAX_STRUCT_MEMBERS = 64;
 
+static Dictionary component_to_dict_cursor_walk(flecs::world &world, flecs::entity_t comp_type_id, const void *comp_ptr);
+
 static Dictionary component_to_dict_cursor(flecs::entity entity, flecs::entity_t comp_type_id) {
 	// Validate entity is still valid and alive before accessing
 	if (!entity.is_valid() || !entity.is_alive()) {
@@ -463,6 +473,17 @@ static Dictionary component_to_dict_cursor(flecs::entity entity, flecs::entity_t
 		return Dictionary();
 	}
 
+	// Precompiled plan: flat loop over member offsets, no cursor walk
+	std::shared_ptr<const FlecsReflection::AccessPlan> plan = FlecsReflection::AccessPlanCache::get().get_plan(world, comp_type_id);
+	if (plan) {
+		return plan->to_dict(comp_ptr);
+	}
+
+	return component_to_dict_cursor_walk(world, comp_type_id, comp_ptr);
+}
+
+// Reflection walk used for types that have no access plan
+static Dictionary component_to_dict_cursor_walk(flecs::world &world, flecs::entity_t comp_type_id, const void *comp_ptr) {
 	flecs::cursor cur = world.cursor(comp_type_id, const_cast<void*>(comp_ptr));
 
 	// Get the type to check if it's a struct
@@ -594,6 +615,13 @@ static void component_from_dict_cursor(flecs::entity entity, flecs::entity_t com
 		return;
 	}
 
+	std::shared_ptr<const FlecsReflection::AccessPlan> plan = FlecsReflection::AccessPlanCache::get().get_plan(entity.world(), comp_type_id);
+	if (plan) {
+		plan->from_dict(comp_ptr, dict);
+		entity.modified(comp_type_id);
+		return;
+	}
+
 	// For opaque types, get the type name directly from the component entity
 	// instead of relying on cursor (which may not have type info for opaque types)
 	flecs::entity comp_entity(entity.world().c_ptr(), comp_type_id);
@@ -744,7 +772,7 @@ RID FlecsServer::create_query(const RID &world_id, const PackedStringArray &requ
 	CHECK_WORLD_VALIDITY_V(world_id, RID(), create_query);
 	FlecsQuery query;
 	query.init(world_id, required_components);
-	return flecs_variant_owners.get(world_id).query_owner.make_rid(query);
+	return world_registries.get(world_id)->query_owner.make_rid(query);
 }
 
 Array FlecsServer::query_get_entities(const RID &world_id, const RID &query_id) {
@@ -842,9 +870,55 @@ void FlecsServer::query_reset_instrumentation(const RID &world_id, const RID &qu
 	query->reset_instrumentation();
 }
 
+Variant FlecsServer::get_component_field_column(const RID &world_id, const RID &query_id, const String &component_type, const String &field) {
+	CHECK_QUERY_VALIDITY_V(query_id, world_id, Variant(), get_component_field_column);
+	flecs::world *world = _get_world(world_id);
+	if (!world) {
+		ERR_PRINT("FlecsServer::get_component_field_column: world not found");
+		return Variant();
+	}
+
+	flecs::entity component = _lookup_component(*world, component_type);
+	if (!component.is_valid()) {
+		ERR_PRINT("FlecsServer::get_component_field_column: component type not found: " + component_type);
+		return Variant();
+	}
+
+	FlecsColumnAccess::FieldLayout layout;
+	if (!FlecsColumnAccess::resolve_field(*world, component.id(), field, layout)) {
+		ERR_PRINT(vformat("FlecsServer::get_component_field_column: '%s.%s' has no packed column representation", component_type, field));
+		return Variant();
+	}
+
+	return FlecsColumnAccess::read_column(*world, query->_get_flecs_query(), layout);
+}
+
+void FlecsServer::set_component_field_column(const RID &world_id, const RID &query_id, const String &component_type, const String &field, const Variant &column) {
+	CHECK_QUERY_VALIDITY(query_id, world_id, set_component_field_column);
+	flecs::world *world = _get_world(world_id);
+	if (!world) {
+		ERR_PRINT("FlecsServer::set_component_field_column: world not found");
+		return;
+	}
+
+	flecs::entity component = _lookup_component(*world, component_type);
+	if (!component.is_valid()) {
+		ERR_PRINT("FlecsServer::set_component_field_column: component type not found: " + component_type);
+		return;
+	}
+
+	FlecsColumnAccess::FieldLayout layout;
+	if (!FlecsColumnAccess::resolve_field(*world, component.id(), field, layout)) {
+		ERR_PRINT(vformat("FlecsServer::set_component_field_column: '%s.%s' has no packed column representation", component_type, field));
+		return;
+	}
+
+	FlecsColumnAccess::write_column(*world, query->_get_flecs_query(), layout, column);
+}
+
 void FlecsServer::free_query(const RID &world_id, const RID &query_id) {
 	CHECK_WORLD_VALIDITY(world_id, free_query);
-	flecs_variant_owners.get(world_id).query_owner.free(query_id);
+	world_registries.get(world_id)->query_owner.free(query_id);
 }
 
 FlecsQuery FlecsServer::_get_query(const RID &query_id, const RID &world_id) {
@@ -854,17 +928,41 @@ FlecsQuery FlecsServer::_get_query(const RID &query_id, const RID &world_id) {
 
 RID FlecsServer::_create_rid_for_query(const RID &world_id, const FlecsQuery &query) {
 	CHECK_WORLD_VALIDITY_V(world_id, RID(), _create_rid_for_query);
-	return flecs_variant_owners.get(world_id).query_owner.make_rid(query);
+	return world_registries.get(world_id)->query_owner.make_rid(query);
 }
 
 void FlecsServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("create_world"), &FlecsServer::create_world);
 	ClassDB::bind_method(D_METHOD("get_world_list"), &FlecsServer::get_world_list);
 	ClassDB::bind_method(D_METHOD("init_world", "world_id"), &FlecsServer::init_world);
+	ClassDB::bind_method(D_METHOD("set_worker_thread_count", "count"), &FlecsServer::set_worker_thread_count);
+	ClassDB::bind_method(D_METHOD("get_worker_thread_count"), &FlecsServer::get_worker_thread_count);
+	ClassDB::bind_method(D_METHOD("set_world_thread_count", "world_id", "count"), &FlecsServer::set_world_thread_count);
+	ClassDB::bind_method(D_METHOD("get_world_thread_count", "world_id"), &FlecsServer::get_world_thread_count);
+	ClassDB::bind_method(D_METHOD("set_world_tick_rate", "world_id", "ticks_per_second"), &FlecsServer::set_world_tick_rate);
+	ClassDB::bind_method(D_METHOD("get_world_tick_rate", "world_id"), &FlecsServer::get_world_tick_rate);
+	ClassDB::bind_method(D_METHOD("set_world_max_physics_steps", "world_id", "max_steps"), &FlecsServer::set_world_max_physics_steps);
+	ClassDB::bind_method(D_METHOD("get_world_max_physics_steps", "world_id"), &FlecsServer::get_world_max_physics_steps);
+	ClassDB::bind_method(D_METHOD("get_world_interpolation_alpha", "world_id"), &FlecsServer::get_world_interpolation_alpha);
 	ClassDB::bind_method(D_METHOD("progress_world", "world_id", "delta"), &FlecsServer::progress_world);
+	ClassDB::bind_method(D_METHOD("progress_worlds", "world_ids", "delta"), &FlecsServer::progress_worlds);
 	ClassDB::bind_method(D_METHOD("create_entity", "world_id"), &FlecsServer::create_entity);
 	ClassDB::bind_method(D_METHOD("create_entity_with_name", "world_id", "name"), &FlecsServer::create_entity_with_name);
 	ClassDB::bind_method(D_METHOD("create_entity_with_name_and_comps", "world_id", "name", "components_type_ids"), &FlecsServer::create_entity_with_name_and_comps);
+	ClassDB::bind_method(D_METHOD("create_entities_bulk", "world_id", "count", "component_names", "initial_data", "create_rids"), &FlecsServer::create_entities_bulk, DEFVAL(Dictionary()), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("create_prefab", "world_id", "components", "name"), &FlecsServer::create_prefab, DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("instantiate_prefab", "world_id", "prefab_id", "count", "overrides_columns", "create_rids"), &FlecsServer::instantiate_prefab, DEFVAL(Dictionary()), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("create_entity_pool", "world_id", "pool_name", "component_names", "prewarm"), &FlecsServer::create_entity_pool, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("acquire_pooled_entities", "world_id", "pool_name", "count", "initial_data"), &FlecsServer::acquire_pooled_entities, DEFVAL(Dictionary()));
+	ClassDB::bind_method(D_METHOD("release_pooled_entities", "world_id", "pool_name", "entity_ids"), &FlecsServer::release_pooled_entities);
+	ClassDB::bind_method(D_METHOD("free_entity_pool", "world_id", "pool_name"), &FlecsServer::free_entity_pool);
+	ClassDB::bind_method(D_METHOD("get_entity_pool_stats", "world_id", "pool_name"), &FlecsServer::get_entity_pool_stats);
+	ClassDB::bind_method(D_METHOD("get_entity_rid", "world_id", "entity_id"), &FlecsServer::get_entity_rid);
+	ClassDB::bind_method(D_METHOD("snapshot_world", "world_id"), &FlecsServer::snapshot_world);
+	ClassDB::bind_method(D_METHOD("restore_world", "world_id", "snapshot"), &FlecsServer::restore_world);
+	ClassDB::bind_method(D_METHOD("fork_world", "world_id"), &FlecsServer::fork_world);
+	ClassDB::bind_method(D_METHOD("discard_fork", "fork_id"), &FlecsServer::discard_fork);
+	ClassDB::bind_method(D_METHOD("get_fork_source", "fork_id"), &FlecsServer::get_fork_source);
 	ClassDB::bind_method(D_METHOD("lookup", "world_id", "entity_name"), &FlecsServer::lookup);
 	ClassDB::bind_method(D_METHOD("get_world_of_entity", "entity_id"), &FlecsServer::get_world_of_entity);
 	//all underscore types are not exposed and are only used internally
@@ -875,6 +973,9 @@ void FlecsServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_component", "entity_id", "component_type_id"), &FlecsServer::add_component);
 	ClassDB::bind_method(D_METHOD("has_component", "entity_id", "component_type"), &FlecsServer::has_component);
 	ClassDB::bind_method(D_METHOD("get_render_system_command_handler", "world_id"), &FlecsServer::get_render_system_command_handler);
+	ClassDB::bind_method(D_METHOD("get_command_handler", "world_id", "name"), &FlecsServer::get_command_handler);
+	ClassDB::bind_method(D_METHOD("register_command_handler", "world_id", "name", "command_handler"), &FlecsServer::register_command_handler);
+	ClassDB::bind_method(D_METHOD("unregister_command_handler", "world_id", "name"), &FlecsServer::unregister_command_handler);
 	ClassDB::bind_method(D_METHOD("remove_all_components_from_entity", "entity_id"), &FlecsServer::remove_all_components_from_entity);
 	ClassDB::bind_method(D_METHOD("get_component_types_as_name", "entity_id"), &FlecsServer::get_component_types_as_name);
 	ClassDB::bind_method(D_METHOD("get_component_types_as_id", "entity_id"), &FlecsServer::get_component_types_as_id);
@@ -892,6 +993,14 @@ void FlecsServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("remove_child", "parent_id", "child_id"), &FlecsServer::remove_child);
 	ClassDB::bind_method(D_METHOD("get_children", "parent_id"), &FlecsServer::get_children);
 	ClassDB::bind_method(D_METHOD("get_child", "parent_id", "index"), &FlecsServer::get_child);
+	ClassDB::bind_method(D_METHOD("batch_set_component", "entity_id", "component_type", "comp_data"), &FlecsServer::batch_set_component);
+	ClassDB::bind_method(D_METHOD("batch_add_component", "entity_id", "component_type"), &FlecsServer::batch_add_component);
+	ClassDB::bind_method(D_METHOD("batch_remove_component", "entity_id", "component_type"), &FlecsServer::batch_remove_component);
+	ClassDB::bind_method(D_METHOD("flush_write_batch", "world_id"), &FlecsServer::flush_write_batch);
+	ClassDB::bind_method(D_METHOD("clear_write_batch", "world_id"), &FlecsServer::clear_write_batch);
+	ClassDB::bind_method(D_METHOD("get_write_batch_pending_count", "world_id"), &FlecsServer::get_write_batch_pending_count);
+	ClassDB::bind_method(D_METHOD("set_write_batch_flush_phase", "world_id", "phase"), &FlecsServer::set_write_batch_flush_phase);
+	ClassDB::bind_method(D_METHOD("get_write_batch_flush_phase", "world_id"), &FlecsServer::get_write_batch_flush_phase);
 	ClassDB::bind_method(D_METHOD("add_script_system", "world_id", "component_types", "callable"), &FlecsServer::add_script_system);
 	ClassDB::bind_method(D_METHOD("set_script_system_dispatch_mode", "world_id", "script_system_id", "mode"), &FlecsServer::set_script_system_dispatch_mode);
 	ClassDB::bind_method(D_METHOD("get_script_system_dispatch_mode", "world_id", "script_system_id"), &FlecsServer::get_script_system_dispatch_mode);
@@ -919,10 +1028,17 @@ void FlecsServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_script_system_auto_reset", "world_id", "script_system_id"), &FlecsServer::get_script_system_auto_reset);
 	ClassDB::bind_method(D_METHOD("get_world_frame_summary", "world_id"), &FlecsServer::get_world_frame_summary);
 	ClassDB::bind_method(D_METHOD("reset_world_frame_summary", "world_id"), &FlecsServer::reset_world_frame_summary);
+	ClassDB::bind_method(D_METHOD("get_world_frame_history", "world_id", "max_frames"), &FlecsServer::get_world_frame_history, DEFVAL(-1));
+	ClassDB::bind_method(D_METHOD("set_world_frame_history_size", "world_id", "frame_count"), &FlecsServer::set_world_frame_history_size);
+	ClassDB::bind_method(D_METHOD("get_world_frame_history_size", "world_id"), &FlecsServer::get_world_frame_history_size);
 	ClassDB::bind_method(D_METHOD("set_script_system_detailed_timing", "world_id", "script_system_id", "enabled"), &FlecsServer::set_script_system_detailed_timing);
 	ClassDB::bind_method(D_METHOD("get_script_system_detailed_timing", "world_id", "script_system_id"), &FlecsServer::get_script_system_detailed_timing);
 	ClassDB::bind_method(D_METHOD("set_script_system_multi_threaded", "world_id", "script_system_id", "enable"), &FlecsServer::set_script_system_multi_threaded);
 	ClassDB::bind_method(D_METHOD("get_script_system_multi_threaded", "world_id", "script_system_id"), &FlecsServer::get_script_system_multi_threaded);
+	ClassDB::bind_method(D_METHOD("set_script_system_projection", "world_id", "script_system_id", "paths"), &FlecsServer::set_script_system_projection);
+	ClassDB::bind_method(D_METHOD("get_script_system_projection", "world_id", "script_system_id"), &FlecsServer::get_script_system_projection);
+	ClassDB::bind_method(D_METHOD("set_script_system_flush_phase", "world_id", "script_system_id", "phase"), &FlecsServer::set_script_system_flush_phase);
+	ClassDB::bind_method(D_METHOD("get_script_system_flush_phase", "world_id", "script_system_id"), &FlecsServer::get_script_system_flush_phase);
 	ClassDB::bind_method(D_METHOD("set_script_system_batch_chunk_size", "world_id", "script_system_id", "size"), &FlecsServer::set_script_system_batch_chunk_size);
 	ClassDB::bind_method(D_METHOD("get_script_system_batch_chunk_size", "world_id", "script_system_id"), &FlecsServer::get_script_system_batch_chunk_size);
 	ClassDB::bind_method(D_METHOD("set_script_system_flush_min_interval_msec", "world_id", "script_system_id", "msec"), &FlecsServer::set_script_system_flush_min_interval_msec);
@@ -973,11 +1089,20 @@ void FlecsServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("query_get_instrumentation_enabled", "world_id", "query_id"), &FlecsServer::query_get_instrumentation_enabled);
 	ClassDB::bind_method(D_METHOD("query_get_instrumentation_data", "world_id", "query_id"), &FlecsServer::query_get_instrumentation_data);
 	ClassDB::bind_method(D_METHOD("query_reset_instrumentation", "world_id", "query_id"), &FlecsServer::query_reset_instrumentation);
+	ClassDB::bind_method(D_METHOD("get_component_field_column", "world_id", "query_id", "component_type", "field"), &FlecsServer::get_component_field_column);
+	ClassDB::bind_method(D_METHOD("set_component_field_column", "world_id", "query_id", "component_type", "field", "column"), &FlecsServer::set_component_field_column);
 	ClassDB::bind_method(D_METHOD("free_query", "world_id", "query_id"), &FlecsServer::free_query);
 
 	// Script system constants (dispatch modes)
 	BIND_ENUM_CONSTANT(DISPATCH_PER_ENTITY);
 	BIND_ENUM_CONSTANT(DISPATCH_BATCH);
+	BIND_ENUM_CONSTANT(DISPATCH_COLUMNAR);
+
+	ClassDB::bind_method(D_METHOD("set_entity_handle_mode", "world_id", "mode"), &FlecsServer::set_entity_handle_mode);
+	ClassDB::bind_method(D_METHOD("get_entity_handle_mode", "world_id"), &FlecsServer::get_entity_handle_mode);
+	ClassDB::bind_method(D_METHOD("get_entity_handle", "world_id", "entity_id"), &FlecsServer::get_entity_handle);
+	BIND_ENUM_CONSTANT(ENTITY_HANDLE_RID);
+	BIND_ENUM_CONSTANT(ENTITY_HANDLE_DENSE);
 
 
 	ClassDB::bind_method(D_METHOD("set_children", "parent_id", "children"), &FlecsServer::set_children);
@@ -993,6 +1118,7 @@ void FlecsServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("free_system", "world_id", "system_id", "include_flecs_world"), &FlecsServer::free_system);
 	ClassDB::bind_method(D_METHOD("free_script_system", "world_id", "script_system_id"), &FlecsServer::free_script_system);
 	ClassDB::bind_method(D_METHOD("free_entity", "world_id", "entity_id", "include_flecs_world"), &FlecsServer::free_entity);
+	ClassDB::bind_method(D_METHOD("free_entities_bulk", "world_id", "entity_ids", "free_server_resources"), &FlecsServer::free_entities_bulk, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("free_type_id", "world_id", "type_id"), &FlecsServer::free_type_id);
 	ClassDB::bind_method(D_METHOD("add_to_ref_storage", "resource", "world_id"), &FlecsServer::add_to_ref_storage);
 	ClassDB::bind_method(D_METHOD("remove_from_ref_storage", "resource_rid", "world_id"), &FlecsServer::remove_from_ref_storage);
@@ -1026,6 +1152,9 @@ FlecsServer::FlecsServer() {
 	// This must happen before any Flecs world is created so that worker threads
 	// are automatically registered with the ECS trace bridge for neural visualization
 	FLECS_OS_API_TRACED_INSTALL();
+	// Route Flecs task threads of every world to one pool; the thread that
+	// calls progress_world() runs the first stage itself
+	FlecsWorkerPool::install(MAX(OS::get_singleton()->get_processor_count() - 1, 1));
 	
 	worlds = Vector<RID>();
 	worlds.resize(MAX_WORLD_COUNT);
@@ -1036,6 +1165,7 @@ FlecsServer::FlecsServer() {
 }
 
 FlecsServer::~FlecsServer() {
+	FlecsWorkerPool::uninstall();
 	singleton = nullptr;
 }
 
@@ -1097,15 +1227,34 @@ RID FlecsServer::create_world() {
 
 	// Register all components using the new reflection system
 	AllComponents::register_all(world_ref, false);
+	// Drop cached serialization plans whenever reflection data in this world changes
+	FlecsReflection::AccessPlanCache::get().watch_world(world_ref);
+	ComponentNameCache::get().watch_world(world_ref);
 
 
 
-	flecs_variant_owners.insert(flecs_world, RID_Owner_Wrapper{
-		flecs_world
-	});
+	world_registries.insert(flecs_world, memnew(WorldRegistry(flecs_world)));
+
+	for (uint32_t slot = 0; slot < MAX_WORLD_COUNT; slot++) {
+		EntityHandleSlot &handle_slot = entity_handle_slots[slot];
+		if (!handle_slot.world_id.is_valid()) {
+			handle_slot.world_id = flecs_world;
+			handle_slot.generation = (handle_slot.generation + 1) & FlecsEntityHandle::GENERATION_MASK;
+			handle_slot.mode = ENTITY_HANDLE_RID;
+			world_handle_slots.insert(flecs_world, slot);
+			break;
+		}
+	}
 
 	node_storages.insert(flecs_world, memnew(NodeStorage()));
 	ref_storages.insert(flecs_world, memnew(RefStorage()));
+	write_batches.insert(flecs_world, memnew(WorldWriteBatch()));
+	entity_pools.insert(flecs_world, memnew(EntityPoolMap()));
+	frame_histories.insert(flecs_world, memnew(FrameSummaryHistory()));
+	FixedTimestep *fixed_timestep = memnew(FixedTimestep());
+	fixed_timestep->setup(world_ref);
+	fixed_timesteps.insert(flecs_world, fixed_timestep);
+	TransformPropagation::setup(world_ref);
 	// Record the world RID in the worlds vector so _get_world can find it.
 	worlds.insert(counter++, flecs_world);
 
@@ -1175,10 +1324,74 @@ void FlecsServer::init_world(const RID& world_id) {
 
 	print_verbose("World initialized: " + itos((uint64_t)world.c_ptr()));
 
-	// Configure Flecs to use multiple threads for systems marked with multi_threaded()
-	auto threads = std::thread::hardware_concurrency();
-	print_verbose("Detected hardware concurrency: " + itos(threads));
-	world.set_threads(threads);
+	// Systems marked with multi_threaded() run on task threads borrowed from
+	// the shared worker pool, so worlds do not each spawn their own threads
+	set_world_thread_count(world_id, get_worker_thread_count() + 1);
+}
+
+void FlecsServer::set_worker_thread_count(const int count) {
+	if (count < 0) {
+		ERR_PRINT("FlecsServer::set_worker_thread_count: count must not be negative");
+		return;
+	}
+	FlecsWorkerPool::get_singleton()->set_thread_count(count);
+}
+
+int FlecsServer::get_worker_thread_count() const {
+	return FlecsWorkerPool::get_singleton()->get_thread_count();
+}
+
+void FlecsServer::set_world_thread_count(const RID &world_id, const int count) {
+	CHECK_WORLD_VALIDITY(world_id, set_world_thread_count);
+	if (count < 1) {
+		ERR_PRINT("FlecsServer::set_world_thread_count: count must be at least 1");
+		return;
+	}
+	flecs::world &world = world_variant->get_world();
+	if (world.is_deferred()) {
+		ERR_PRINT("FlecsServer::set_world_thread_count: cannot change thread count while the world is progressing");
+		return;
+	}
+	world.set_task_threads(count);
+	print_verbose(vformat("World %d uses %d task threads", (uint64_t)world.c_ptr(), count));
+}
+
+int FlecsServer::get_world_thread_count(const RID &world_id) {
+	CHECK_WORLD_VALIDITY_V(world_id, 0, get_world_thread_count);
+	return world_variant->get_world().get_stage_count();
+}
+
+void FlecsServer::set_world_tick_rate(const RID &world_id, const double ticks_per_second) {
+	CHECK_WORLD_VALIDITY(world_id, set_world_tick_rate);
+	if (ticks_per_second < 0.0) {
+		ERR_PRINT("FlecsServer::set_world_tick_rate: ticks_per_second must not be negative");
+		return;
+	}
+	fixed_timesteps.get(world_id)->set_tick_rate(ticks_per_second);
+}
+
+double FlecsServer::get_world_tick_rate(const RID &world_id) {
+	CHECK_WORLD_VALIDITY_V(world_id, 0.0, get_world_tick_rate);
+	return fixed_timesteps.get(world_id)->get_tick_rate();
+}
+
+void FlecsServer::set_world_max_physics_steps(const RID &world_id, const int max_steps) {
+	CHECK_WORLD_VALIDITY(world_id, set_world_max_physics_steps);
+	if (max_steps < 1) {
+		ERR_PRINT("FlecsServer::set_world_max_physics_steps: max_steps must be at least 1");
+		return;
+	}
+	fixed_timesteps.get(world_id)->set_max_steps(max_steps);
+}
+
+int FlecsServer::get_world_max_physics_steps(const RID &world_id) {
+	CHECK_WORLD_VALIDITY_V(world_id, 0, get_world_max_physics_steps);
+	return fixed_timesteps.get(world_id)->get_max_steps();
+}
+
+double FlecsServer::get_world_interpolation_alpha(const RID &world_id) {
+	CHECK_WORLD_VALIDITY_V(world_id, 1.0, get_world_interpolation_alpha);
+	return fixed_timesteps.get(world_id)->get_alpha();
 }
 
 bool FlecsServer::progress_world(const RID& world_id, const double delta) {
@@ -1194,73 +1407,188 @@ bool FlecsServer::progress_world(const RID& world_id, const double delta) {
 		return false;
 	}
 
-	const bool progress = world->progress(delta);
-	// Aggregate per-frame summary: totals across script systems + breakdown
-	Dictionary summary;
-	uint64_t total_entities = 0; uint64_t total_callbacks_all_time = 0; uint64_t batch_systems = 0;
-	uint64_t max_dispatch_usec = 0; uint64_t script_system_count = 0; uint64_t total_dispatch_invocations = 0; uint64_t accum_dispatch_usec = 0;
-	Array systems_breakdown;
-	for (RID ss_rid : flecs_variant_owners.get(world_id).script_system_owner.get_owned_list()) {
-		FlecsScriptSystem *ss = flecs_variant_owners.get(world_id).script_system_owner.get_or_null(ss_rid);
-		if (!ss) { continue; }
-		++script_system_count;
-		uint64_t ent = ss->get_last_frame_entity_count();
-		uint64_t last_usec = ss->get_last_frame_dispatch_usec();
-		uint64_t inv = ss->get_frame_dispatch_invocations();
-		uint64_t accum = ss->get_frame_dispatch_accum_usec();
-		total_entities += ent;
-		total_callbacks_all_time += ss->get_total_callbacks_invoked();
-		total_dispatch_invocations += inv;
-		accum_dispatch_usec += accum;
-		if (ss->get_dispatch_mode() == FlecsScriptSystem::DISPATCH_BATCH) { batch_systems += 1; }
-		if (last_usec > max_dispatch_usec) { max_dispatch_usec = last_usec; }
-		Dictionary row;
-		row["rid"] = ss_rid;
-		row["entities"] = (int64_t)ent;
-		row["last_dispatch_usec"] = (int64_t)last_usec;
-		row["dispatch_invocations"] = (int64_t)inv;
-		row["dispatch_accum_usec"] = (int64_t)accum;
-		row["dispatch_avg_usec"] = inv == 0 ? Variant() : Variant((int64_t)(accum / inv));
-		row["mode"] = (int64_t)ss->get_dispatch_mode();
-		row["min_dispatch_usec"] = (int64_t)ss->get_frame_dispatch_min_usec();
-		row["max_dispatch_usec_system"] = (int64_t)ss->get_frame_dispatch_max_usec();
-		if (ss->get_detailed_timing_enabled() && ss->get_frame_dispatch_invocations() > 0) {
-			row["median_dispatch_usec"] = ss->get_frame_dispatch_median_usec();
-			row["p99_dispatch_usec"] = ss->get_frame_dispatch_percentile_usec(99.0);
-			row["stddev_dispatch_usec"] = ss->get_frame_dispatch_stddev_usec();
-		}
-		row["onadd"] = (int64_t)ss->get_last_frame_onadd();
-		row["onset"] = (int64_t)ss->get_last_frame_onset();
-		row["onremove"] = (int64_t)ss->get_last_frame_onremove();
-		systems_breakdown.push_back(row);
-	}
-	summary["script_systems"] = (int64_t)script_system_count;
-	summary["total_entities_this_frame"] = (int64_t)total_entities;
-	summary["total_callbacks_all_time"] = (int64_t)total_callbacks_all_time;
-	summary["batch_system_count"] = (int64_t)batch_systems;
-	summary["max_dispatch_usec"] = (int64_t)max_dispatch_usec;
-	summary["dispatch_invocations"] = (int64_t)total_dispatch_invocations;
-	summary["dispatch_accum_usec"] = (int64_t)accum_dispatch_usec;
-	summary["dispatch_avg_usec"] = total_dispatch_invocations == 0 ? Variant() : Variant((int64_t)(accum_dispatch_usec / total_dispatch_invocations));
-	// For simplicity, we don't aggregate median/p99 across systems accurately (would need merge of distributions);
-	// could approximate by weighting but omitted for now. Per-system stats above carry detail.
-	summary["systems"] = systems_breakdown;
-	last_frame_summaries.insert(world_id, summary);
+	const bool progress = _progress_world_frame(world_id, *world, delta);
+	_process_command_handlers(world_id);
 
 	RS::get_singleton()->call_on_render_thread(command_handler_callback);
 
 	return progress;
 }
 
+bool FlecsServer::progress_worlds(const TypedArray<RID> &world_ids, const double delta) {
+	struct WorldFrame {
+		RID world_id;
+		flecs::world *world = nullptr;
+		bool progress = false;
+	};
+	LocalVector<WorldFrame> frames;
+	frames.reserve(world_ids.size());
+	// Indices into frames of worlds without script callbacks
+	LocalVector<uint32_t> native_frames;
+	HashSet<RID> listed;
+	bool all_progressed = true;
+	for (int i = 0; i < world_ids.size(); i++) {
+		const RID world_id = world_ids[i];
+		flecs::world *world = _get_world(world_id);
+		if (!world) {
+			ERR_PRINT("FlecsServer::progress_worlds: world not found");
+			all_progressed = false;
+			continue;
+		}
+		if (listed.has(world_id)) {
+			// Progressing a world on two threads at once would corrupt it
+			ERR_PRINT("FlecsServer::progress_worlds: world listed more than once");
+			continue;
+		}
+		listed.insert(world_id);
+		WorldFrame frame;
+		frame.world_id = world_id;
+		frame.world = world;
+		if (!_world_runs_scripts(world_id, *world)) {
+			native_frames.push_back(frames.size());
+		}
+		frames.push_back(frame);
+	}
+	if (frames.is_empty()) {
+		return false;
+	}
+
+	FlecsWorkerPool::get_singleton()->parallel_for(native_frames.size(), [&](uint32_t p_index) {
+		WorldFrame &frame = frames[native_frames[p_index]];
+		frame.progress = _progress_world_frame(frame.world_id, *frame.world, delta);
+	});
+
+	// Script callbacks can call back into the server, so those worlds run
+	// one after another on the calling thread
+	uint32_t next_native = 0;
+	for (uint32_t i = 0; i < frames.size(); i++) {
+		if (next_native < native_frames.size() && native_frames[next_native] == i) {
+			next_native++;
+			continue;
+		}
+		frames[i].progress = _progress_world_frame(frames[i].world_id, *frames[i].world, delta);
+	}
+
+	// Each world records its summary in its own history; shared server state
+	// is only touched back on the calling thread
+	for (const WorldFrame &frame : frames) {
+		all_progressed = all_progressed && frame.progress;
+		_process_command_handlers(frame.world_id);
+	}
+	RS::get_singleton()->call_on_render_thread(command_handler_callback);
+
+	return all_progressed;
+}
+
+bool FlecsServer::_world_runs_scripts(const RID &world_id, flecs::world &world) {
+	// Covers script systems created outside add_script_system and runner systems
+	if (world.count<ScriptCallbackSystem>() > 0) {
+		return true;
+	}
+	WorldRegistry **registry = world_registries.getptr(world_id);
+	return registry && (*registry)->script_system_owner.get_rid_count() > 0;
+}
+
+bool FlecsServer::_progress_world_frame(const RID &world_id, flecs::world &world, const double delta) {
+	// Script writes batched without a flush phase are applied at the start of the frame
+	if (WorldWriteBatch **batch = write_batches.getptr(world_id)) {
+		if ((*batch)->flush_phase == 0) {
+			_apply_write_batch(world, **batch);
+		}
+	}
+
+	// Fixed-step physics runs before the variable-rate phases, which can then
+	// read the interpolation alpha from the PhysicsInterpolation singleton
+	if (FixedTimestep **fixed_timestep = fixed_timesteps.getptr(world_id)) {
+		(*fixed_timestep)->advance(world, delta);
+	}
+
+	const bool progress = world.progress(delta);
+	if (FrameSummaryHistory **history = frame_histories.getptr(world_id)) {
+		_record_frame_summary(world_id, world, delta, **history);
+	}
+	return progress;
+}
+
+void FlecsServer::_record_frame_summary(const RID &world_id, const flecs::world &world, const double delta, FrameSummaryHistory &history) {
+	RID_Owner<FlecsScriptSystem, true> &owner = world_registries.get(world_id)->script_system_owner;
+	LocalVector<RID> &rids = history.scratch_rids;
+	rids.resize(owner.get_rid_count());
+	if (rids.is_empty()) {
+		return;
+	}
+	owner.fill_owned_buffer(rids.ptr());
+
+	// Dispatch counters only move for instrumented systems; without any there
+	// is nothing to record
+	bool instrumented = false;
+	for (const RID &ss_rid : rids) {
+		const FlecsScriptSystem *ss = owner.get_or_null(ss_rid);
+		if (ss && ss->get_instrumentation_enabled()) {
+			instrumented = true;
+			break;
+		}
+	}
+	if (!instrumented) {
+		return;
+	}
+
+	// Aggregate per-frame summary: totals across script systems + breakdown
+	WorldFrameSummary &summary = history.begin_frame();
+	summary.frame = world.get_info()->frame_count_total;
+	summary.delta = delta;
+	summary.script_systems = 0;
+	summary.total_entities = 0;
+	summary.total_callbacks_all_time = 0;
+	summary.batch_system_count = 0;
+	summary.max_dispatch_usec = 0;
+	summary.dispatch_invocations = 0;
+	summary.dispatch_accum_usec = 0;
+	for (const RID &ss_rid : rids) {
+		FlecsScriptSystem *ss = owner.get_or_null(ss_rid);
+		if (!ss) { continue; }
+		++summary.script_systems;
+		if (ss->get_dispatch_mode() == FlecsScriptSystem::DISPATCH_BATCH) { summary.batch_system_count += 1; }
+		if (!ss->get_instrumentation_enabled()) { continue; }
+		ScriptSystemFrameStats stats;
+		stats.rid = ss_rid;
+		stats.entities = ss->get_last_frame_entity_count();
+		stats.last_dispatch_usec = ss->get_last_frame_dispatch_usec();
+		stats.dispatch_invocations = ss->get_frame_dispatch_invocations();
+		stats.dispatch_accum_usec = ss->get_frame_dispatch_accum_usec();
+		stats.min_dispatch_usec = ss->get_frame_dispatch_min_usec();
+		stats.max_dispatch_usec = ss->get_frame_dispatch_max_usec();
+		stats.mode = ss->get_dispatch_mode();
+		stats.detailed_timing = ss->get_detailed_timing_enabled() && stats.dispatch_invocations > 0;
+		if (stats.detailed_timing) {
+			stats.median_dispatch_usec = ss->get_frame_dispatch_median_usec();
+			stats.p99_dispatch_usec = ss->get_frame_dispatch_percentile_usec(99.0);
+			stats.stddev_dispatch_usec = ss->get_frame_dispatch_stddev_usec();
+		}
+		stats.onadd = ss->get_last_frame_onadd();
+		stats.onset = ss->get_last_frame_onset();
+		stats.onremove = ss->get_last_frame_onremove();
+
+		summary.total_entities += stats.entities;
+		summary.total_callbacks_all_time += ss->get_total_callbacks_invoked();
+		summary.dispatch_invocations += stats.dispatch_invocations;
+		summary.dispatch_accum_usec += stats.dispatch_accum_usec;
+		summary.max_dispatch_usec = MAX(summary.max_dispatch_usec, stats.last_dispatch_usec);
+		summary.systems.push_back(stats);
+	}
+}
+
 
 
 RID FlecsServer::create_entity(const RID &world_id) {
 	CHECK_WORLD_VALIDITY_V(world_id, RID(), create_entity);
 	flecs::world &world = world_variant->get_world();
 	flecs::entity entity = world.entity();
-	RID rid = flecs_variant_owners.get(world_id).entity_owner.make_rid(FlecsEntityVariant(entity));
+	RID rid = _make_entity_rid(world_id, entity);
 	// Add to reverse lookup map for O(1) lookups
-	flecs_variant_owners.get(world_id).entity_id_to_rid[entity.id()] = rid;
+	if (!FlecsEntityHandle::is_handle(rid)) {
+		world_registries.get(world_id)->entity_id_to_rid.set(entity.id(), rid);
+	}
 
 	// Trace entity creation for neural visualizer
 	ECS_TRACE_ENTITY_CREATE(entity.id());
@@ -1271,7 +1599,7 @@ RID FlecsServer::create_entity(const RID &world_id) {
 RID FlecsServer::create_entity_with_name(const RID &world_id, const String &p_name) {
 	CHECK_WORLD_VALIDITY_V(world_id, RID(), create_entity_with_name);
 	RID flecs_entity = create_entity(world_id);
-	FlecsEntityVariant *flecs_entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(flecs_entity);
+	FlecsEntityRef flecs_entity_variant = _resolve_entity(world_id, flecs_entity);
 	if (flecs_entity_variant) {
 		flecs_entity_variant->get_entity().set_name(p_name.ascii().get_data());
 	}
@@ -1282,7 +1610,7 @@ RID FlecsServer::create_entity_with_name_and_comps(const RID& world_id, const St
 	CHECK_WORLD_VALIDITY_V(world_id, RID(), create_entity_with_name);
 	RID flecs_entity = create_entity_with_name(world_id,name);
 	for(const RID comp_type_id : components_type_ids) {
-		FlecsTypeIDVariant *type_id_variant = flecs_variant_owners.get(world_id).type_id_owner.get_or_null(comp_type_id);
+		FlecsTypeIDVariant *type_id_variant = world_registries.get(world_id)->type_id_owner.get_or_null(comp_type_id);
 		if (type_id_variant) {
 			add_component(flecs_entity, comp_type_id);
 		} else {
@@ -1292,6 +1620,334 @@ RID FlecsServer::create_entity_with_name_and_comps(const RID& world_id, const St
 	return flecs_entity;
 }
 
+PackedInt64Array FlecsServer::create_entities_bulk(const RID &world_id, const int count, const PackedStringArray &component_names, const Dictionary &initial_data, const bool create_rids) {
+	CHECK_WORLD_VALIDITY_V(world_id, PackedInt64Array(), create_entities_bulk);
+	return _create_entities_bulk(world_id, world_variant->get_world(), "create_entities_bulk", count, 0, component_names, initial_data, create_rids);
+}
+
+RID FlecsServer::create_prefab(const RID &world_id, const Dictionary &components, const String &name) {
+	CHECK_WORLD_VALIDITY_V(world_id, RID(), create_prefab);
+	flecs::world &world = world_variant->get_world();
+
+	LocalVector<flecs::entity> component_types;
+	Array keys = components.keys();
+	for (int i = 0; i < keys.size(); i++) {
+		const String component_name = keys[i];
+		flecs::entity component = _lookup_component(world, component_name);
+		if (!component.is_valid()) {
+			ERR_PRINT("FlecsServer::create_prefab: component type not found: " + component_name);
+			return RID();
+		}
+		component_types.push_back(component);
+	}
+
+	// Flecs only accepts the trait before the component is used anywhere, so
+	// check every component before changing any of them
+	for (const flecs::entity &component : component_types) {
+		if (!component.has(flecs::OnInstantiate, flecs::Wildcard) && ecs_id_in_use(world.c_ptr(), component.id())) {
+			ERR_PRINT(vformat("FlecsServer::create_prefab: '%s' is already in use and cannot become shared; create the prefab before any entity uses it", String(component.name().c_str())));
+			return RID();
+		}
+	}
+	// The trait is world-wide: every prefab in this world shares the component
+	for (const flecs::entity &component : component_types) {
+		if (!component.has(flecs::OnInstantiate, flecs::Wildcard)) {
+			ecs_add_pair(world.c_ptr(), component.id(), EcsOnInstantiate, EcsInherit);
+		}
+	}
+
+	flecs::entity prefab = name.is_empty() ? world.prefab() : world.prefab(name.utf8().get_data());
+	for (uint32_t i = 0; i < component_types.size(); i++) {
+		const Variant &data = components[keys[i]];
+		if (data.get_type() == Variant::DICTIONARY) {
+			component_from_dict_cursor(prefab, component_types[i].id(), data);
+		} else {
+			prefab.add(component_types[i].id());
+		}
+	}
+	return _get_or_create_rid_for_entity(world_id, prefab);
+}
+
+PackedInt64Array FlecsServer::instantiate_prefab(const RID &world_id, const RID &prefab_id, const int count, const Dictionary &overrides_columns, const bool create_rids) {
+	CHECK_WORLD_VALIDITY_V(world_id, PackedInt64Array(), instantiate_prefab);
+	FlecsEntityRef prefab = _resolve_entity(world_id, prefab_id);
+	if (!prefab || !prefab->get_entity().has(flecs::Prefab)) {
+		ERR_PRINT("FlecsServer::instantiate_prefab: prefab_id is not a prefab of this world");
+		return PackedInt64Array();
+	}
+	return _create_entities_bulk(world_id, world_variant->get_world(), "instantiate_prefab", count, prefab->get_entity().id(), PackedStringArray(), overrides_columns, create_rids);
+}
+
+bool FlecsServer::create_entity_pool(const RID &world_id, const StringName &pool_name, const PackedStringArray &component_names, const int prewarm) {
+	CHECK_WORLD_VALIDITY_V(world_id, false, create_entity_pool);
+	flecs::world &world = world_variant->get_world();
+	EntityPoolMap *pools = entity_pools.get(world_id);
+	if (pools->has(pool_name)) {
+		ERR_PRINT("FlecsServer::create_entity_pool: a pool with this name already exists: " + String(pool_name));
+		return false;
+	}
+
+	LocalVector<flecs::entity_t> components;
+	for (const String &component_name : component_names) {
+		flecs::entity component = _lookup_component(world, component_name);
+		if (!component.is_valid()) {
+			ERR_PRINT("FlecsServer::create_entity_pool: component type not found: " + component_name);
+			return false;
+		}
+		components.push_back(component.id());
+	}
+
+	EntityPool *pool = memnew(EntityPool);
+	pool->setup(world, component_names, components);
+	pools->insert(pool_name, pool);
+
+	if (prewarm > 0) {
+		PackedInt64Array created = _create_entities_bulk(world_id, world, "create_entity_pool", prewarm, 0, component_names, Dictionary(), false);
+		const flecs::entity_t *entities = reinterpret_cast<const flecs::entity_t *>(created.ptr());
+		pool->add_created(entities, created.size());
+		pool->park(world, entities, created.size());
+	}
+	return true;
+}
+
+PackedInt64Array FlecsServer::acquire_pooled_entities(const RID &world_id, const StringName &pool_name, const int count, const Dictionary &initial_data) {
+	CHECK_WORLD_VALIDITY_V(world_id, PackedInt64Array(), acquire_pooled_entities);
+	flecs::world &world = world_variant->get_world();
+	PackedInt64Array entity_ids;
+	EntityPool *pool = _get_entity_pool(world_id, pool_name);
+	if (!pool) {
+		ERR_PRINT("FlecsServer::acquire_pooled_entities: pool not found: " + String(pool_name));
+		return entity_ids;
+	}
+	if (count <= 0) {
+		return entity_ids;
+	}
+	if (world.is_deferred()) {
+		ERR_PRINT("FlecsServer::acquire_pooled_entities: cannot acquire entities while the world is deferred");
+		return entity_ids;
+	}
+
+	LocalVector<BulkColumn> columns;
+	if (!_resolve_bulk_columns(world, "acquire_pooled_entities", count, initial_data, columns)) {
+		return entity_ids;
+	}
+	for (const BulkColumn &column : columns) {
+		// A parked entity only has the pool's components, there is nowhere to write others to
+		if (!pool->has_component(column.layout.component_id)) {
+			ERR_PRINT(vformat("FlecsServer::acquire_pooled_entities: '%s' is not a component of pool '%s'", String(world.entity(column.layout.component_id).name().c_str()), String(pool_name)));
+			return entity_ids;
+		}
+	}
+
+	static_assert(sizeof(int64_t) == sizeof(flecs::entity_t));
+	entity_ids.resize(count);
+	flecs::entity_t *entities = reinterpret_cast<flecs::entity_t *>(entity_ids.ptrw());
+	const uint32_t taken = pool->take(world, count, entities);
+	if (taken < uint32_t(count)) {
+		const PackedInt64Array created = _create_entities_bulk(world_id, world, "acquire_pooled_entities", count - taken, 0, pool->get_component_names(), Dictionary(), false);
+		if (created.size() != count - int(taken)) {
+			// Hand back what was re-enabled rather than a short array
+			pool->park(world, entities, taken);
+			return PackedInt64Array();
+		}
+		const flecs::entity_t *created_entities = reinterpret_cast<const flecs::entity_t *>(created.ptr());
+		memcpy(entities + taken, created_entities, created.size() * sizeof(flecs::entity_t));
+		pool->add_created(created_entities, created.size());
+	}
+
+	for (const BulkColumn &column : columns) {
+		FlecsColumnAccess::write_entities(world, entities, count, column.layout, column.column);
+	}
+	return entity_ids;
+}
+
+int FlecsServer::release_pooled_entities(const RID &world_id, const StringName &pool_name, const PackedInt64Array &entity_ids) {
+	CHECK_WORLD_VALIDITY_V(world_id, 0, release_pooled_entities);
+	EntityPool *pool = _get_entity_pool(world_id, pool_name);
+	if (!pool) {
+		ERR_PRINT("FlecsServer::release_pooled_entities: pool not found: " + String(pool_name));
+		return 0;
+	}
+	const flecs::entity_t *entities = reinterpret_cast<const flecs::entity_t *>(entity_ids.ptr());
+	return pool->park(world_variant->get_world(), entities, entity_ids.size());
+}
+
+void FlecsServer::free_entity_pool(const RID &world_id, const StringName &pool_name) {
+	CHECK_WORLD_VALIDITY(world_id, free_entity_pool);
+	EntityPoolMap *pools = entity_pools.get(world_id);
+	EntityPool **pool = pools->getptr(pool_name);
+	if (!pool) {
+		ERR_PRINT("FlecsServer::free_entity_pool: pool not found: " + String(pool_name));
+		return;
+	}
+	LocalVector<flecs::entity_t> parked;
+	(*pool)->drain(parked);
+	memdelete(*pool);
+	pools->erase(pool_name);
+
+	PackedInt64Array parked_ids;
+	parked_ids.resize(parked.size());
+	memcpy(parked_ids.ptrw(), parked.ptr(), parked.size() * sizeof(flecs::entity_t));
+	free_entities_bulk(world_id, parked_ids, true);
+}
+
+Dictionary FlecsServer::get_entity_pool_stats(const RID &world_id, const StringName &pool_name) {
+	CHECK_WORLD_VALIDITY_V(world_id, Dictionary(), get_entity_pool_stats);
+	EntityPool *pool = _get_entity_pool(world_id, pool_name);
+	if (!pool) {
+		ERR_PRINT("FlecsServer::get_entity_pool_stats: pool not found: " + String(pool_name));
+		return Dictionary();
+	}
+	return pool->get_stats();
+}
+
+EntityPool *FlecsServer::_get_entity_pool(const RID &world_id, const StringName &pool_name) {
+	EntityPoolMap **pools = entity_pools.getptr(world_id);
+	if (!pools) {
+		return nullptr;
+	}
+	EntityPool **pool = (*pools)->getptr(pool_name);
+	return pool ? *pool : nullptr;
+}
+
+PackedInt64Array FlecsServer::_create_entities_bulk(const RID &world_id, flecs::world &world, const char *p_method, const int count, const flecs::entity_t prefab, const PackedStringArray &component_names, const Dictionary &initial_data, const bool create_rids) {
+	PackedInt64Array entity_ids;
+	if (count <= 0) {
+		return entity_ids;
+	}
+	if (world.is_deferred()) {
+		// ecs_bulk_init needs direct table access, which is not available from inside a system
+		ERR_PRINT(vformat("FlecsServer::%s: cannot bulk-create entities while the world is deferred", p_method));
+		return entity_ids;
+	}
+
+	ecs_bulk_desc_t bulk_desc = {};
+	bulk_desc.count = count;
+	int32_t id_count = 0;
+	if (prefab) {
+		// The IsA pair puts shared components in reach without a copy per
+		// entity; the table move also instantiates the prefab's children
+		bulk_desc.ids[id_count++] = ecs_pair(EcsIsA, prefab);
+	}
+	auto add_id = [&](const flecs::entity_t id) {
+		for (int32_t i = 0; i < id_count; i++) {
+			if (bulk_desc.ids[i] == id) {
+				return true;
+			}
+		}
+		if (id_count >= FLECS_ID_DESC_MAX) {
+			return false;
+		}
+		bulk_desc.ids[id_count++] = id;
+		return true;
+	};
+
+	for (const String &component_name : component_names) {
+		flecs::entity component = _lookup_component(world, component_name);
+		if (!component.is_valid()) {
+			ERR_PRINT(vformat("FlecsServer::%s: component type not found: %s", p_method, component_name));
+			return entity_ids;
+		}
+		if (!add_id(component.id())) {
+			ERR_PRINT(vformat("FlecsServer::%s: at most %d component types are supported", p_method, FLECS_ID_DESC_MAX));
+			return entity_ids;
+		}
+	}
+
+	// Resolve and validate every column before anything is created, so a bad
+	// column never leaves half-initialized entities behind
+	LocalVector<BulkColumn> columns;
+	if (!_resolve_bulk_columns(world, p_method, count, initial_data, columns)) {
+		return entity_ids;
+	}
+	for (const BulkColumn &column : columns) {
+		if (!add_id(column.layout.component_id)) {
+			ERR_PRINT(vformat("FlecsServer::%s: at most %d component types are supported", p_method, FLECS_ID_DESC_MAX));
+			return entity_ids;
+		}
+	}
+
+	// All entities land in the same table with a single move; components are
+	// default-constructed (or copied from the prefab when overridden) and then
+	// filled straight from the packed columns
+	const ecs_entity_t *created = ecs_bulk_init(world.c_ptr(), &bulk_desc);
+	if (!created) {
+		ERR_PRINT(vformat("FlecsServer::%s: ecs_bulk_init failed", p_method));
+		return entity_ids;
+	}
+	entity_ids.resize(count);
+	int64_t *ids_w = entity_ids.ptrw();
+	for (int i = 0; i < count; i++) {
+		ids_w[i] = static_cast<int64_t>(created[i]);
+	}
+
+	// The returned id array doubles as the entity list for the column writes
+	static_assert(sizeof(int64_t) == sizeof(flecs::entity_t));
+	const flecs::entity_t *entities = reinterpret_cast<const flecs::entity_t *>(entity_ids.ptr());
+	for (const BulkColumn &column : columns) {
+		FlecsColumnAccess::write_entities(world, entities, count, column.layout, column.column);
+	}
+
+	// Dense handles need no materialization at all
+	if (create_rids && !_is_dense_world(world_id)) {
+		WorldRegistry &owners = *world_registries.get(world_id);
+		owners.entity_id_to_rid.reserve(count);
+		for (int i = 0; i < count; i++) {
+			owners.entity_id_to_rid.set(entities[i], _make_entity_rid(world_id, world.entity(entities[i])));
+		}
+	}
+
+	return entity_ids;
+}
+
+bool FlecsServer::_resolve_bulk_columns(flecs::world &world, const char *p_method, const int count, const Dictionary &initial_data, LocalVector<BulkColumn> &r_columns) {
+	Array data_keys = initial_data.keys();
+	for (int i = 0; i < data_keys.size(); i++) {
+		const String component_name = data_keys[i];
+		flecs::entity component = _lookup_component(world, component_name);
+		if (!component.is_valid()) {
+			ERR_PRINT(vformat("FlecsServer::%s: component type not found: %s", p_method, component_name));
+			return false;
+		}
+
+		// A bare packed array fills the whole component, a Dictionary fills individual fields
+		Dictionary fields;
+		const Variant &data = initial_data[data_keys[i]];
+		if (data.get_type() == Variant::DICTIONARY) {
+			fields = data;
+		} else {
+			fields[String()] = data;
+		}
+		Array field_keys = fields.keys();
+		for (int j = 0; j < field_keys.size(); j++) {
+			const String field = field_keys[j];
+			BulkColumn pending;
+			pending.column = fields[field_keys[j]];
+			if (!FlecsColumnAccess::resolve_field(world, component.id(), field, pending.layout)) {
+				ERR_PRINT(vformat("FlecsServer::%s: '%s.%s' has no packed column representation", p_method, component_name, field));
+				return false;
+			}
+			const int64_t rows = FlecsColumnAccess::get_column_row_count(pending.layout.kind, pending.column);
+			if (rows != count) {
+				ERR_PRINT(vformat("FlecsServer::%s: column '%s.%s' has %d rows, expected %d", p_method, component_name, field, rows, count));
+				return false;
+			}
+			r_columns.push_back(pending);
+		}
+	}
+	return true;
+}
+
+RID FlecsServer::get_entity_rid(const RID &world_id, const int64_t entity_id) {
+	CHECK_WORLD_VALIDITY_V(world_id, RID(), get_entity_rid);
+	flecs::world &world = world_variant->get_world();
+	if (!world.is_alive(static_cast<flecs::entity_t>(entity_id))) {
+		ERR_PRINT(vformat("FlecsServer::get_entity_rid: entity %d is not alive", entity_id));
+		return RID();
+	}
+	return _get_or_create_rid_for_entity(world_id, world.entity(static_cast<flecs::entity_t>(entity_id)));
+}
+
 RID FlecsServer::lookup(const RID &world_id, const String &entity_name) {
 	CHECK_WORLD_VALIDITY_V(world_id, RID(), create_entity_with_name);
 	if (world_variant) {
@@ -1301,7 +1957,7 @@ RID FlecsServer::lookup(const RID &world_id, const String &entity_name) {
 			ERR_PRINT("FlecsServer::lookup: entity not found");
 			return RID();
 		}
-		return flecs_variant_owners.get(world_id).entity_owner.make_rid(FlecsEntityVariant(entity));
+		return _make_entity_rid(world_id, entity);
 	}
 	ERR_FAIL_V_MSG(RID(), "FlecsServer::lookup: world_id is not a valid world");
 }
@@ -1329,13 +1985,21 @@ flecs::world *FlecsServer::_get_world(const RID &world_id) {
 }
 
 RID FlecsServer::get_world_of_entity(const RID &entity_id) {
-	for (auto &pair : flecs_variant_owners) {
-		FlecsEntityVariant *entity_variant = pair.value.entity_owner.get_or_null(entity_id);
-		if (entity_variant) {
-			return pair.key;
+	if (FlecsEntityHandle::is_handle(entity_id)) {
+		// Dense handles carry their world slot
+		const EntityHandleSlot &slot = entity_handle_slots[FlecsEntityHandle::get_slot(entity_id)];
+		if (slot.generation != FlecsEntityHandle::get_generation(entity_id)) {
+			return RID();
 		}
+		FlecsWorldVariant *world_variant = flecs_world_owners.get_or_null(slot.world_id);
+		if (!world_variant || !world_variant->get_world().is_alive(FlecsEntityHandle::get_entity(entity_id))) {
+			return RID();
+		}
+		return slot.world_id;
 	}
-	return RID();
+	// Constant time regardless of the number of worlds: every entity RID is
+	// indexed with its world when it is made and unindexed when it is freed.
+	return entity_world_index.get(entity_id);
 }
 
 
@@ -1479,6 +2143,10 @@ RID FlecsServer::create_runtime_component(const RID& world_id, const String &com
 		return RID();
 	}
 
+	// Build the serialization plan up front so the first get/set doesn't pay for it
+	FlecsReflection::AccessPlanCache::get().get_plan(*world, comp_id);
+	ComponentNameCache::get().insert(*world, component_name, comp_id);
+
 	// Create and return RID for the component type
 	return _create_rid_for_type_id(world_id, comp_id);
 }
@@ -1495,7 +2163,7 @@ RID FlecsServer::add_script_system(const RID& world_id, const Array &component_t
 		count++;
 	}
 	flecs_script_system.init(world_id,component_names,callable);
-	return flecs_variant_owners.get(world_id).script_system_owner.make_rid(flecs_script_system);
+	return world_registries.get(world_id)->script_system_owner.make_rid(flecs_script_system);
 }
 
 
@@ -1516,6 +2184,43 @@ Ref<CommandHandler> FlecsServer::get_render_system_command_handler(const RID &wo
 	return render_system_command_handler;
 }
 
+Ref<CommandHandler> FlecsServer::get_command_handler(const RID &world_id, const String &name) {
+	CHECK_WORLD_VALIDITY_V(world_id, Ref<CommandHandler>(), get_command_handler);
+	const Ref<CommandHandler> *command_handler = world_registries.get(world_id)->command_handlers.getptr(name);
+	return command_handler ? *command_handler : Ref<CommandHandler>();
+}
+
+void FlecsServer::register_command_handler(const RID &world_id, const String &name, const Ref<CommandHandler> &command_handler) {
+	CHECK_WORLD_VALIDITY(world_id, register_command_handler);
+	if (command_handler.is_null()) {
+		ERR_PRINT("FlecsServer::register_command_handler: command_handler is null");
+		return;
+	}
+	world_registries.get(world_id)->command_handlers[name] = command_handler;
+}
+
+void FlecsServer::unregister_command_handler(const RID &world_id, const String &name) {
+	CHECK_WORLD_VALIDITY(world_id, unregister_command_handler);
+	world_registries.get(world_id)->command_handlers.erase(name);
+}
+
+void FlecsServer::_process_command_handlers(const RID &world_id) {
+	WorldRegistry **registry = world_registries.getptr(world_id);
+	if (!registry || (*registry)->command_handlers.is_empty()) {
+		return;
+	}
+	// A command may register handlers or free the world, so run from a copy
+	LocalVector<Ref<CommandHandler>> command_handlers;
+	for (const KeyValue<String, Ref<CommandHandler>> &kv : (*registry)->command_handlers) {
+		command_handlers.push_back(kv.value);
+	}
+	// Commands queued from here on run after the next frame, which is how a
+	// command spreads its work over several frames
+	for (const Ref<CommandHandler> &command_handler : command_handlers) {
+		command_handler->process_pending_commands();
+	}
+}
+
 
 void FlecsServer::remove_all_components_from_entity(const RID &entity_id) {
 	RID world_id = get_world_of_entity(entity_id);
@@ -1529,12 +2234,12 @@ void FlecsServer::remove_all_components_from_entity(const RID &entity_id) {
 }
 
 
-Dictionary FlecsServer::get_component_by_name(const RID &entity_id, const String &component_type)  {
+Dictionary FlecsServer::get_component_by_name(const RID &entity_id, const StringName &component_type)  {
 	Dictionary component_data;
 	
 	// Skip pair/relationship format strings - they can't be looked up by name
 	// These are formatted as "(First, Second)" from get_component_types_as_name
-	if (component_type.begins_with("(")) {
+	if (String(component_type).begins_with("(")) {
 		// Pairs don't have serializable component data in the same way
 		return component_data;
 	}
@@ -1545,7 +2250,7 @@ Dictionary FlecsServer::get_component_by_name(const RID &entity_id, const String
 		return component_data;
 	}
 	
-	FlecsEntityVariant *entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id);
 	if (entity_variant) {
 		flecs::entity entity = entity_variant->get_entity();
 		
@@ -1561,7 +2266,7 @@ Dictionary FlecsServer::get_component_by_name(const RID &entity_id, const String
 			return component_data;
 		}
 
-		flecs::entity component = world->lookup(component_type.utf8().get_data());
+		flecs::entity component = _lookup_component(*world, component_type);
 		if (!component.is_valid()) {
 			ERR_PRINT("FlecsServer::get_component_by_name: component type not found: " + component_type);
 			return component_data;
@@ -1577,7 +2282,7 @@ Dictionary FlecsServer::get_component_by_name(const RID &entity_id, const String
 	ERR_PRINT("FlecsServer::get_component_by_name: entity_id is not a valid entity");
 	return component_data;
 }
-bool FlecsServer::has_component(const RID& entity_id, const String &component_type) {
+bool FlecsServer::has_component(const RID& entity_id, const StringName &component_type) {
 	RID world_id = get_world_of_entity(entity_id);
 	if(!world_id.is_valid()){
 		ERR_PRINT("FlecsServer::has_component: world_id is not valid");
@@ -1588,10 +2293,10 @@ bool FlecsServer::has_component(const RID& entity_id, const String &component_ty
 		ERR_PRINT("FlecsServer::has_component: world not found");
 		return false;
 	}
-	FlecsEntityVariant* entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id);
 	if (entity_variant) {
 		flecs::entity entity = entity_variant->get_entity();
-		flecs::entity comp_type = world->lookup(component_type.utf8().get_data());
+		flecs::entity comp_type = _lookup_component(*world, component_type);
 		return comp_type.is_valid() && entity.has(comp_type);
 	}
 	ERR_PRINT("FlecsServer::has_component: entity_id is not a valid entity");
@@ -1618,7 +2323,7 @@ PackedStringArray FlecsServer::get_component_types_as_name(const RID &entity_id)
 		return PackedStringArray();
 	}
 	
-	FlecsEntityVariant* entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id);
 	if (entity_variant) {
 		flecs::entity entity = entity_variant->get_entity();
 		// Validate entity is still alive in Flecs world before iterating
@@ -1718,7 +2423,7 @@ TypedArray<RID> FlecsServer::get_component_types_as_id(const RID &entity_id) {
 		return TypedArray<RID>();
 	}
 	TypedArray<RID> component_ids;
-	FlecsEntityVariant* entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id);
 	if (entity_variant) {
 		flecs::entity entity = entity_variant->get_entity();
 		// Validate entity is still alive in Flecs world before iterating
@@ -1757,7 +2462,7 @@ String FlecsServer::get_entity_name(const RID &entity_id) {
 		return String();
 	}
 	
-	FlecsEntityVariant* entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id);
 	if (entity_variant) {
 		flecs::entity entity = entity_variant->get_entity();
 		// Validate entity is still alive before accessing name
@@ -1797,7 +2502,7 @@ String FlecsServer::get_entity_name(const RID &entity_id) {
 		ERR_PRINT("FlecsServer::set_component: world_id is not valid");
 		return;
 	}
-	FlecsEntityVariant* entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id);
 	if (entity_variant) {
 		flecs::entity entity = entity_variant->get_entity();
 		entity.set_name(p_name.ascii().get_data());
@@ -1806,7 +2511,7 @@ String FlecsServer::get_entity_name(const RID &entity_id) {
 	}
 }
 
-void FlecsServer::set_component(const RID& entity_id, const String& component_type, const Dictionary &comp_data) {
+void FlecsServer::set_component(const RID& entity_id, const StringName& component_type, const Dictionary &comp_data) {
 	RID world_id = get_world_of_entity(entity_id);
 	if(!world_id.is_valid()){
 		ERR_PRINT("FlecsServer::set_component: world_id is not valid");
@@ -1817,10 +2522,10 @@ void FlecsServer::set_component(const RID& entity_id, const String& component_ty
 		ERR_PRINT("FlecsServer::set_component: world not found");
 		return;
 	}
-	FlecsEntityVariant* entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id);
 	if (entity_variant) {
 		flecs::entity entity = entity_variant->get_entity();
-		flecs::entity comp_type = world->lookup(component_type.utf8().get_data());
+		flecs::entity comp_type = _lookup_component(*world, component_type);
 		if (comp_type.is_valid()) {
 			// Trace component write for neural visualizer
 			ECS_TRACE_WRITE(entity.id(), comp_type.id(), 0);
@@ -1841,10 +2546,10 @@ void FlecsServer::remove_component_from_entity_with_id(const RID &entity_id, con
 		ERR_PRINT("FlecsServer::remove_component_from_entity_with_id: world_id is not valid");
 		return;
 	}
-	FlecsEntityVariant* entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id);
 	if (entity_variant) {
 		flecs::entity entity = entity_variant->get_entity();
-		flecs::entity_t comp_id = flecs_variant_owners.get(world_id).type_id_owner.get_or_null(component_id)->get_type();
+		flecs::entity_t comp_id = world_registries.get(world_id)->type_id_owner.get_or_null(component_id)->get_type();
 		if (comp_id) {
 			// Trace component remove for neural visualizer
 			ECS_TRACE_REMOVE(entity.id(), comp_id);
@@ -1856,7 +2561,7 @@ void FlecsServer::remove_component_from_entity_with_id(const RID &entity_id, con
 	}
 }
 
-void FlecsServer::remove_component_from_entity_with_name(const RID &entity_id, const String &component_type) {
+void FlecsServer::remove_component_from_entity_with_name(const RID &entity_id, const StringName &component_type) {
 	RID world_id = get_world_of_entity(entity_id);
 	if(!world_id.is_valid()){
 		ERR_PRINT("FlecsServer::remove_component_from_entity_with_name: world_id is not valid");
@@ -1867,10 +2572,10 @@ void FlecsServer::remove_component_from_entity_with_name(const RID &entity_id, c
 		ERR_PRINT("FlecsServer::remove_component_from_entity_with_name: world not found");
 		return;
 	}
-	FlecsEntityVariant* entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id);
 	if (entity_variant) {
 		flecs::entity entity = entity_variant->get_entity();
-		flecs::entity component = world->lookup(component_type.utf8().get_data());
+		flecs::entity component = _lookup_component(*world, component_type);
 		if (component.is_valid()) {
 			// Trace component remove for neural visualizer
 			ECS_TRACE_REMOVE(entity.id(), component.id());
@@ -1889,10 +2594,10 @@ Dictionary FlecsServer::get_component_by_id(const RID& entity_id, const RID& com
 		ERR_PRINT("FlecsServer::get_component_by_id: world_id is not valid");
 		return Dictionary();
 	}
-	FlecsEntityVariant* entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id);
 	if (entity_variant) {
 		flecs::entity entity = entity_variant->get_entity();
-		FlecsTypeIDVariant* comp_variant = flecs_variant_owners.get(world_id).type_id_owner.get_or_null(component_type_id);
+		FlecsTypeIDVariant* comp_variant = world_registries.get(world_id)->type_id_owner.get_or_null(component_type_id);
 		if(comp_variant){
 			flecs::entity_t comp_id = comp_variant->get_type();
 			if (comp_id) {
@@ -1908,12 +2613,12 @@ Dictionary FlecsServer::get_component_by_id(const RID& entity_id, const RID& com
 	return Dictionary();
 }
 
-RID FlecsServer::get_component_type_by_name(const RID& entity_id, const String &component_type) {
+RID FlecsServer::get_component_type_by_name(const RID& entity_id, const StringName &component_type) {
 	bool is_world = flecs_world_owners.owns(entity_id);
 	RID world_id = is_world ? entity_id : get_world_of_entity(entity_id);
 	bool is_entity = false;
 	if(!is_world){
-		is_entity = flecs_variant_owners.get(world_id).entity_owner.owns(entity_id);
+		is_entity = FlecsEntityHandle::is_handle(entity_id) ? world_id.is_valid() : world_registries.get(world_id)->entity_owner.owns(entity_id);
 	}
 	if(is_entity){
 		CHECK_ENTITY_VALIDITY_V(entity_id, world_id, RID(), get_component_type_by_name)
@@ -1922,7 +2627,7 @@ RID FlecsServer::get_component_type_by_name(const RID& entity_id, const String &
 		if (!world) {
 			ERR_FAIL_V_MSG(RID(), "World not found for entity");
 		}
-		comp_type = world->lookup(component_type.utf8().get_data());
+		comp_type = _lookup_component(*world, component_type);
 		if (comp_type.is_valid()) {
 			return _create_rid_for_type_id(world_id, comp_type.id());
 		}
@@ -1930,7 +2635,7 @@ RID FlecsServer::get_component_type_by_name(const RID& entity_id, const String &
 	}else if(is_world){
 		CHECK_WORLD_VALIDITY_V(world_id, RID(), get_component_type_by_name)
 		flecs::world &world = world_variant->get_world();
-		flecs::entity comp_type = world.lookup(component_type.utf8().get_data());
+		flecs::entity comp_type = _lookup_component(world, component_type);
 		if (comp_type.is_valid()) {
 			return _create_rid_for_type_id(world_id, comp_type.id());
 		}
@@ -1948,12 +2653,12 @@ RID FlecsServer::get_component_type_by_name(const RID& entity_id, const String &
 
 RID FlecsServer::get_parent(const RID& entity_id) {
 	RID world_id = get_world_of_entity(entity_id);
-	FlecsEntityVariant* flecs_entity = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
+	FlecsEntityRef flecs_entity = _resolve_entity(world_id, entity_id);
 	if (flecs_entity) {
 		flecs::entity entity = flecs_entity->get_entity();
 		flecs::entity parent = entity.parent();
 		if (parent.is_valid()) {
-			return flecs_variant_owners.get(world_id).entity_owner.make_rid(FlecsEntityVariant(parent));
+			return _make_entity_rid(world_id, parent);
 		}
 	}
 	ERR_FAIL_V_MSG(RID(), "Parent not found for entity_id: " + itos(entity_id.get_id()));
@@ -1961,8 +2666,8 @@ RID FlecsServer::get_parent(const RID& entity_id) {
 
 void FlecsServer::set_parent(const RID& entity_id, const RID& parent_id) {
 	RID world_id = get_world_of_entity(entity_id);
-	FlecsEntityVariant* flecs_entity = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
-	FlecsEntityVariant* parent_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(parent_id);
+	FlecsEntityRef flecs_entity = _resolve_entity(world_id, entity_id);
+	FlecsEntityRef parent_variant = _resolve_entity(world_id, parent_id);
 	if (flecs_entity && parent_variant) {
 		flecs::entity entity = flecs_entity->get_entity();
 		flecs::entity parent = parent_variant->get_entity();
@@ -1976,7 +2681,7 @@ void FlecsServer::set_parent(const RID& entity_id, const RID& parent_id) {
 
 RID FlecsServer::get_child(const RID& entity_id, int index) {
 	RID world_id = get_world_of_entity(entity_id);
-	FlecsEntityVariant* flecs_entity = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
+	FlecsEntityRef flecs_entity = _resolve_entity(world_id, entity_id);
 	if (flecs_entity) {
 		flecs::entity entity = flecs_entity->get_entity();
 		int i = 0;
@@ -1988,7 +2693,7 @@ RID FlecsServer::get_child(const RID& entity_id, int index) {
 			i++;
 		});
 		if (child.is_valid()) {
-			return flecs_variant_owners.get(world_id).entity_owner.make_rid(FlecsEntityVariant(child));
+			return _make_entity_rid(world_id, child);
 		}
 	}
 	ERR_FAIL_V_MSG(RID(), "Child not found for entity_id: " + itos(entity_id.get_id()) + " at index: " + itos(index));
@@ -2006,13 +2711,13 @@ void FlecsServer::set_children(const RID &parent_id, const TypedArray<RID> &p_ch
 
 RID FlecsServer::get_child_by_name(const RID &parent_id,const String &name){
 	RID world_id = get_world_of_entity(parent_id);
-	FlecsEntityVariant* parent_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(parent_id);
+	FlecsEntityRef parent_variant = _resolve_entity(world_id, parent_id);
 	if (parent_variant) {
 		flecs::entity parent = parent_variant->get_entity();
 		RID child_rid;
 		parent.children([&](flecs::entity child) {
 			if (child.name() == name.ascii().get_data()) {
-				child_rid = flecs_variant_owners.get(world_id).entity_owner.make_rid(FlecsEntityVariant(child));
+				child_rid = _make_entity_rid(world_id, child);
 			}
 		});
 		return child_rid;
@@ -2022,7 +2727,7 @@ RID FlecsServer::get_child_by_name(const RID &parent_id,const String &name){
 
 void FlecsServer::remove_child_by_name(const RID &parent_id, const String &name){
 	RID world_id = get_world_of_entity(parent_id);
-	FlecsEntityVariant* parent_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(parent_id);
+	FlecsEntityRef parent_variant = _resolve_entity(world_id, parent_id);
 	if (parent_variant) {
 		flecs::entity parent = parent_variant->get_entity();
 		parent.children([&](flecs::entity child) {
@@ -2037,7 +2742,7 @@ void FlecsServer::remove_child_by_name(const RID &parent_id, const String &name)
 }
 void FlecsServer::remove_child_by_index(const RID &parent_id, int index) {
 	RID world_id = get_world_of_entity(parent_id);
-	FlecsEntityVariant* parent_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(parent_id);
+	FlecsEntityRef parent_variant = _resolve_entity(world_id, parent_id);
 	if (parent_variant) {
 		flecs::entity parent = parent_variant->get_entity();
 		int i = 0;
@@ -2054,7 +2759,7 @@ void FlecsServer::remove_child_by_index(const RID &parent_id, int index) {
 
 void FlecsServer::remove_all_children(const RID &parent_id) {
 	RID world_id = get_world_of_entity(parent_id);
-	FlecsEntityVariant* parent_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(parent_id);
+	FlecsEntityRef parent_variant = _resolve_entity(world_id, parent_id);
 	if (parent_variant) {
 		flecs::entity parent = parent_variant->get_entity();
 		parent.children([&](flecs::entity child) {
@@ -2068,8 +2773,8 @@ void FlecsServer::remove_all_children(const RID &parent_id) {
 void FlecsServer::add_child(const RID &parent_id, const RID& child_id) {
 	// Implementation for adding a child entity
 	RID world_id = get_world_of_entity(parent_id);
-	FlecsEntityVariant* parent_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(parent_id);
-	FlecsEntityVariant* child_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(child_id);
+	FlecsEntityRef parent_variant = _resolve_entity(world_id, parent_id);
+	FlecsEntityRef child_variant = _resolve_entity(world_id, child_id);
 	if (parent_variant && child_variant) {
 		flecs::entity parent = parent_variant->get_entity();
 		flecs::entity child = child_variant->get_entity();
@@ -2081,8 +2786,8 @@ void FlecsServer::add_child(const RID &parent_id, const RID& child_id) {
 
 void FlecsServer::remove_child(const RID& parent_id, const RID &child_id) {
 	RID world_id = get_world_of_entity(parent_id);
-	FlecsEntityVariant* parent_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(parent_id);
-	FlecsEntityVariant* child_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(child_id);
+	FlecsEntityRef parent_variant = _resolve_entity(world_id, parent_id);
+	FlecsEntityRef child_variant = _resolve_entity(world_id, child_id);
 	if (parent_variant && child_variant) {
 		flecs::entity parent = parent_variant->get_entity();
 		flecs::entity child = child_variant->get_entity();
@@ -2099,11 +2804,11 @@ void FlecsServer::remove_child(const RID& parent_id, const RID &child_id) {
 TypedArray<RID> FlecsServer::get_children(const RID &parent_id) {
 	TypedArray<RID> child_array;
 	RID world_id = get_world_of_entity(parent_id);
-	FlecsEntityVariant *parent_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(parent_id);
+	FlecsEntityRef parent_variant = _resolve_entity(world_id, parent_id);
 	if (parent_variant) {
 		flecs::entity parent = parent_variant->get_entity();
 		parent.children([&](flecs::entity child) {
-			child_array.push_back(flecs_variant_owners.get(world_id).entity_owner.make_rid(FlecsEntityVariant(child)).get_id());
+			child_array.push_back(_make_entity_rid(world_id, child).get_id());
 		});
 	}
 	return child_array;
@@ -2111,8 +2816,8 @@ TypedArray<RID> FlecsServer::get_children(const RID &parent_id) {
 
 void FlecsServer::add_component(const RID& entity_id, const RID& component_id) {
 	RID world_id = get_world_of_entity(entity_id);
-	FlecsEntityVariant* entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
-	FlecsTypeIDVariant* type_id_variant = flecs_variant_owners.get(world_id).type_id_owner.get_or_null(component_id);
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id);
+	FlecsTypeIDVariant* type_id_variant = world_registries.get(world_id)->type_id_owner.get_or_null(component_id);
 	if (entity_variant && type_id_variant) {
 		flecs::entity entity = entity_variant->get_entity();
 		flecs::entity component_type = entity.world().component(type_id_variant->get_type());
@@ -2132,8 +2837,8 @@ void FlecsServer::add_component(const RID& entity_id, const RID& component_id) {
 
 void FlecsServer::add_relationship(const RID& entity_id, const RID &relationship) {
 	RID world_id = get_world_of_entity(entity_id);
-	FlecsEntityVariant* entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
-	FlecsEntityVariant* relationship_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(relationship);
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id);
+	FlecsEntityRef relationship_variant = _resolve_entity(world_id, relationship);
 	if (entity_variant && relationship_variant) {
 		flecs::entity entity = entity_variant->get_entity();
 		flecs::entity rel_entity = relationship_variant->get_entity();
@@ -2145,8 +2850,8 @@ void FlecsServer::add_relationship(const RID& entity_id, const RID &relationship
 
 void FlecsServer::remove_relationship(const RID& entity_id, const RID &relationship) {
 	RID world_id = get_world_of_entity(entity_id);
-	FlecsEntityVariant* entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
-	FlecsEntityVariant* relationship_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(relationship);
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id);
+	FlecsEntityRef relationship_variant = _resolve_entity(world_id, relationship);
 	if (entity_variant && relationship_variant) {
 		flecs::entity entity = entity_variant->get_entity();
 		flecs::entity rel_entity = relationship_variant->get_entity();
@@ -2159,7 +2864,7 @@ void FlecsServer::remove_relationship(const RID& entity_id, const RID &relations
 
 RID FlecsServer::get_relationship(const RID &entity_id, const String& first_entity, const String& second_entity) {
 	RID world_id = get_world_of_entity(entity_id);
-	FlecsEntityVariant* entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id);
 	if (!entity_variant) {
 		ERR_PRINT("FlecsServer::get_relationship: entity_id is not valid");
 		return RID();
@@ -2185,7 +2890,7 @@ RID FlecsServer::get_relationship(const RID &entity_id, const String& first_enti
 
 TypedArray<RID> FlecsServer::get_relationships(const RID &entity_id) {
 	RID world_id = get_world_of_entity(entity_id);
-	FlecsEntityVariant* entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id);
 	if (!entity_variant) {
 		ERR_PRINT("FlecsServer::get_relationships: entity_id is not valid");
 		return TypedArray<RID>();
@@ -2193,8 +2898,8 @@ TypedArray<RID> FlecsServer::get_relationships(const RID &entity_id) {
 	flecs::entity entity = entity_variant->get_entity();
 	TypedArray<RID> relationships;
 	Vector<flecs::entity_t> relationship_ids;
-	for (const RID& rid : flecs_variant_owners.get(world_id).type_id_owner.get_owned_list()) {
-			FlecsTypeIDVariant* type_variant = flecs_variant_owners.get(world_id).type_id_owner.get_or_null(rid);
+	for (const RID& rid : world_registries.get(world_id)->type_id_owner.get_owned_list()) {
+			FlecsTypeIDVariant* type_variant = world_registries.get(world_id)->type_id_owner.get_or_null(rid);
 			if(!type_variant) {
 				continue;
 			}
@@ -2221,12 +2926,271 @@ TypedArray<RID> FlecsServer::get_relationships(const RID &entity_id) {
 	return relationships;
 }
 
+WorldWriteBatch *FlecsServer::_get_write_batch_target(const RID &entity_id, const StringName &component_type, const char *func_name, flecs::entity_t &r_entity, flecs::entity_t &r_component) {
+	RID world_id = get_world_of_entity(entity_id);
+	flecs::world *world = _get_world(world_id);
+	if (!world) {
+		ERR_PRINT(vformat("FlecsServer::%s: world_id is not valid", func_name));
+		return nullptr;
+	}
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id);
+	if (!entity_variant) {
+		ERR_PRINT(vformat("FlecsServer::%s: entity_id is not a valid entity", func_name));
+		return nullptr;
+	}
+	flecs::entity component = _lookup_component(*world, component_type);
+	if (!component.is_valid()) {
+		ERR_PRINT(vformat("FlecsServer::%s: component type not found: %s", func_name, component_type));
+		return nullptr;
+	}
+	WorldWriteBatch **batch = write_batches.getptr(world_id);
+	if (!batch) {
+		ERR_PRINT(vformat("FlecsServer::%s: world has no write batch", func_name));
+		return nullptr;
+	}
+	r_entity = entity_variant->get_entity().id();
+	r_component = component.id();
+	return *batch;
+}
+
+void FlecsServer::batch_set_component(const RID &entity_id, const StringName &component_type, const Dictionary &comp_data) {
+	flecs::entity_t entity = 0;
+	flecs::entity_t component = 0;
+	if (WorldWriteBatch *batch = _get_write_batch_target(entity_id, component_type, "batch_set_component", entity, component)) {
+		batch->record_set(entity, component, comp_data);
+	}
+}
+
+void FlecsServer::batch_add_component(const RID &entity_id, const StringName &component_type) {
+	flecs::entity_t entity = 0;
+	flecs::entity_t component = 0;
+	if (WorldWriteBatch *batch = _get_write_batch_target(entity_id, component_type, "batch_add_component", entity, component)) {
+		batch->record_add(entity, component);
+	}
+}
+
+void FlecsServer::batch_remove_component(const RID &entity_id, const StringName &component_type) {
+	flecs::entity_t entity = 0;
+	flecs::entity_t component = 0;
+	if (WorldWriteBatch *batch = _get_write_batch_target(entity_id, component_type, "batch_remove_component", entity, component)) {
+		batch->record_remove(entity, component);
+	}
+}
+
+int FlecsServer::_apply_write_batch(flecs::world &world, WorldWriteBatch &batch) {
+	LocalVector<WorldWriteBatch::Op> ops;
+	batch.take(ops);
+	if (ops.is_empty()) {
+		return 0;
+	}
+
+	// Removes coalesced into a later add or set are flushed on their own first:
+	// within one deferred block Flecs would cancel them out and keep the old value
+	bool has_resets = false;
+	for (const WorldWriteBatch::Op &op : ops) {
+		has_resets = has_resets || op.reset;
+	}
+	if (has_resets) {
+		world.defer_begin();
+		for (const WorldWriteBatch::Op &op : ops) {
+			if (op.reset && world.is_alive(op.entity) && world.is_alive(op.component)) {
+				ECS_TRACE_REMOVE(op.entity, op.component);
+				flecs::entity(world, op.entity).remove(op.component);
+			}
+		}
+		world.defer_end();
+	}
+
+	int applied = 0;
+	world.defer_begin();
+	for (const WorldWriteBatch::Op &op : ops) {
+		// Entities destroyed since the write was recorded are skipped
+		if (!world.is_alive(op.entity) || !world.is_alive(op.component)) {
+			continue;
+		}
+		flecs::entity entity(world, op.entity);
+		switch (op.kind) {
+			case WorldWriteBatch::OP_ADD:
+				ECS_TRACE_ADD(op.entity, op.component);
+				entity.add(op.component);
+				break;
+			case WorldWriteBatch::OP_SET:
+				ECS_TRACE_WRITE(op.entity, op.component, 0);
+				component_from_dict_cursor(entity, op.component, op.data);
+				break;
+			case WorldWriteBatch::OP_REMOVE:
+				ECS_TRACE_REMOVE(op.entity, op.component);
+				entity.remove(op.component);
+				break;
+		}
+		applied++;
+	}
+	world.defer_end();
+	return applied;
+}
+
+int FlecsServer::flush_write_batch(const RID &world_id) {
+	CHECK_WORLD_VALIDITY_V(world_id, 0, flush_write_batch);
+	WorldWriteBatch **batch = write_batches.getptr(world_id);
+	if (!batch) {
+		return 0;
+	}
+	return _apply_write_batch(world_variant->get_world(), **batch);
+}
+
+void FlecsServer::clear_write_batch(const RID &world_id) {
+	CHECK_WORLD_VALIDITY(world_id, clear_write_batch);
+	if (WorldWriteBatch **batch = write_batches.getptr(world_id)) {
+		(*batch)->clear();
+	}
+}
+
+int FlecsServer::get_write_batch_pending_count(const RID &world_id) {
+	CHECK_WORLD_VALIDITY_V(world_id, 0, get_write_batch_pending_count);
+	WorldWriteBatch **batch = write_batches.getptr(world_id);
+	return batch ? int((*batch)->get_pending_count()) : 0;
+}
+
+flecs::entity_t FlecsServer::_lookup_phase(flecs::world &world, const String &phase) {
+	flecs::entity phase_entity = world.lookup(phase.utf8().get_data());
+	if (!phase_entity.is_valid()) {
+		phase_entity = world.lookup(("flecs::pipeline::" + phase).utf8().get_data());
+	}
+	if (!phase_entity.is_valid() || !phase_entity.has(flecs::Phase)) {
+		return 0;
+	}
+	return phase_entity.id();
+}
+
+void FlecsServer::set_write_batch_flush_phase(const RID &world_id, const String &phase) {
+	CHECK_WORLD_VALIDITY(world_id, set_write_batch_flush_phase);
+	WorldWriteBatch **batch_ptr = write_batches.getptr(world_id);
+	if (!batch_ptr) {
+		ERR_PRINT("FlecsServer::set_write_batch_flush_phase: world has no write batch");
+		return;
+	}
+	WorldWriteBatch *batch = *batch_ptr;
+	flecs::world &world = world_variant->get_world();
+
+	flecs::entity_t phase_id = 0;
+	if (!phase.is_empty()) {
+		phase_id = _lookup_phase(world, phase);
+		if (phase_id == 0) {
+			ERR_PRINT("FlecsServer::set_write_batch_flush_phase: unknown pipeline phase: " + phase);
+			return;
+		}
+	}
+
+	if (batch->flush_system.is_valid() && world.is_alive(batch->flush_system)) {
+		batch->flush_system.destruct();
+	}
+	batch->flush_system = flecs::entity();
+	batch->flush_phase = phase_id;
+	if (phase_id == 0) {
+		return;
+	}
+
+	// Immediate so the writes are merged at this point of the frame and are
+	// visible to the systems that run after it
+	batch->flush_system = world.system<>("WorldWriteBatchFlush")
+			.kind(phase_id)
+			.immediate()
+			.run([this, batch](flecs::iter &it) {
+				flecs::world world = it.world();
+				_apply_write_batch(world, *batch);
+			});
+}
+
+String FlecsServer::get_write_batch_flush_phase(const RID &world_id) {
+	CHECK_WORLD_VALIDITY_V(world_id, String(), get_write_batch_flush_phase);
+	WorldWriteBatch **batch = write_batches.getptr(world_id);
+	if (!batch || (*batch)->flush_phase == 0) {
+		return String();
+	}
+	return String(world_variant->get_world().entity((*batch)->flush_phase).name().c_str());
+}
+
+RID FlecsServer::_make_entity_rid(const RID &world_id, const flecs::entity &entity) {
+	if (_is_dense_world(world_id) && FlecsEntityHandle::can_encode(entity.id())) {
+		const uint32_t slot = *world_handle_slots.getptr(world_id);
+		return FlecsEntityHandle::encode(slot, entity_handle_slots[slot].generation, entity.id());
+	}
+	RID rid = world_registries.get(world_id)->entity_owner.make_rid(FlecsEntityVariant(entity));
+	_index_entity_rid(rid, world_id);
+	return rid;
+}
+
+bool FlecsServer::_is_dense_world(const RID &world_id) const {
+	const uint32_t *slot = world_handle_slots.getptr(world_id);
+	return slot && entity_handle_slots[*slot].mode == ENTITY_HANDLE_DENSE;
+}
+
+flecs::entity FlecsServer::_lookup_component(const flecs::world &world, const StringName &component_name) {
+	const flecs::entity_t component = ComponentNameCache::get().lookup(world, component_name);
+	return component ? flecs::entity(world.c_ptr(), component) : flecs::entity();
+}
+
+FlecsEntityRef FlecsServer::_resolve_entity(const RID &world_id, const RID &entity_id) {
+	if (FlecsEntityHandle::is_handle(entity_id)) {
+		const EntityHandleSlot &slot = entity_handle_slots[FlecsEntityHandle::get_slot(entity_id)];
+		if (slot.world_id != world_id || slot.generation != FlecsEntityHandle::get_generation(entity_id)) {
+			return FlecsEntityRef();
+		}
+		FlecsWorldVariant *world_variant = flecs_world_owners.get_or_null(world_id);
+		const flecs::entity_t entity = FlecsEntityHandle::get_entity(entity_id);
+		// is_alive() compares the generation, so a recycled index does not resolve
+		if (!world_variant || !world_variant->get_world().is_alive(entity)) {
+			return FlecsEntityRef();
+		}
+		return FlecsEntityRef{ FlecsEntityVariant(world_variant->get_world().entity(entity)), true };
+	}
+	FlecsEntityVariant *owned = world_registries.get(world_id)->entity_owner.get_or_null(entity_id);
+	if (!owned) {
+		return FlecsEntityRef();
+	}
+	return FlecsEntityRef{ *owned, true };
+}
+
+void FlecsServer::set_entity_handle_mode(const RID &world_id, EntityHandleMode mode) {
+	CHECK_WORLD_VALIDITY(world_id, set_entity_handle_mode);
+	uint32_t *slot = world_handle_slots.getptr(world_id);
+	if (!slot) {
+		ERR_PRINT("FlecsServer::set_entity_handle_mode: world has no handle slot");
+		return;
+	}
+	// Handles already given out stay valid: both kinds are always accepted
+	entity_handle_slots[*slot].mode = mode;
+}
+
+FlecsServer::EntityHandleMode FlecsServer::get_entity_handle_mode(const RID &world_id) const {
+	return _is_dense_world(world_id) ? ENTITY_HANDLE_DENSE : ENTITY_HANDLE_RID;
+}
+
+RID FlecsServer::get_entity_handle(const RID &world_id, const int64_t entity_id) {
+	CHECK_WORLD_VALIDITY_V(world_id, RID(), get_entity_handle);
+	const flecs::entity_t entity = static_cast<flecs::entity_t>(entity_id);
+	const uint32_t *slot = world_handle_slots.getptr(world_id);
+	if (!slot || !FlecsEntityHandle::can_encode(entity) || !world_variant->get_world().is_alive(entity)) {
+		ERR_PRINT(vformat("FlecsServer::get_entity_handle: entity %d cannot be given a dense handle", entity_id));
+		return RID();
+	}
+	return FlecsEntityHandle::encode(*slot, entity_handle_slots[*slot].generation, entity);
+}
+
+void FlecsServer::_index_entity_rid(const RID &entity_id, const RID &world_id) {
+	entity_world_index.insert(entity_id, world_id);
+}
+
+void FlecsServer::_unindex_entity_rid(const RID &entity_id) {
+	entity_world_index.erase(entity_id);
+}
+
 RID FlecsServer::_create_rid_for_entity(const RID& world_id, const flecs::entity &entity) {
-	return flecs_variant_owners.get(world_id).entity_owner.make_rid(FlecsEntityVariant(entity));
+	return _make_entity_rid(world_id, entity);
 }
 
 RID FlecsServer::_create_rid_for_system(const RID& world_id, const flecs::system &system) {
-	return flecs_variant_owners.get(world_id).system_owner.make_rid(FlecsSystemVariant(system));
+	return world_registries.get(world_id)->system_owner.make_rid(FlecsSystemVariant(system));
 }
 
 RID FlecsServer::_get_rid_for_world(const flecs::world *world) {
@@ -2247,12 +3211,12 @@ RID FlecsServer::_create_rid_for_type_id(const RID& world_id, const flecs::entit
 	if (type_id == 0) {
 		return RID();
 	}
-	if (!flecs_variant_owners.has(world_id)) {
+	if (!world_registries.has(world_id)) {
 		ERR_PRINT("FlecsServer::_create_rid_for_type_id: world_id is not a valid world");
 		return RID();
 	}
 
-	RID_Owner_Wrapper &owner = flecs_variant_owners.get(world_id);
+	WorldRegistry &owner = *world_registries.get(world_id);
 	if (owner.type_id_to_rid.has(type_id)) {
 		RID existing_rid = owner.type_id_to_rid[type_id];
 		FlecsTypeIDVariant *existing_type = owner.type_id_owner.get_or_null(existing_rid);
@@ -2270,28 +3234,28 @@ RID FlecsServer::_create_rid_for_type_id(const RID& world_id, const flecs::entit
 }
 
 RID FlecsServer::_create_rid_for_script_system(const RID& world_id, const FlecsScriptSystem &system) {
-	return flecs_variant_owners.get(world_id).script_system_owner.make_rid(system);
+	return world_registries.get(world_id)->script_system_owner.make_rid(system);
 }
 
 void FlecsServer::free_world(const RID& rid) {
 	if (flecs_world_owners.owns(rid)) {
-			for (const RID& owned : flecs_variant_owners.get(rid).entity_owner.get_owned_list()) {
-				flecs_variant_owners.get(rid).entity_owner.free(owned);
-			}
-
-			for (const RID& owned : flecs_variant_owners.get(rid).type_id_owner.get_owned_list()) {
-				flecs_variant_owners.get(rid).type_id_owner.free(owned);
-			}
-
-		flecs_variant_owners.get(rid).system_owner.get_owned_list();
-		for (const RID& owned : flecs_variant_owners.get(rid).system_owner.get_owned_list()) {
-			flecs_variant_owners.get(rid).system_owner.free(owned);
+		// Pending conversions are committed through the handlers dropped below
+		SceneObjectUtility::cancel_world_conversions(rid);
+		FlecsReflection::AccessPlanCache::get().forget_world(flecs_world_owners.get_or_null(rid)->get_world());
+		ComponentNameCache::get().forget_world(flecs_world_owners.get_or_null(rid)->get_world());
+		WorldRegistry *registry = world_registries.get(rid);
+		for (const RID& owned : registry->entity_owner.get_owned_list()) {
+			entity_world_index.erase(owned);
 		}
-
-		for (const RID& owned : flecs_variant_owners.get(rid).script_system_owner.get_owned_list()) {
-			flecs_variant_owners.get(rid).script_system_owner.free(owned);
+		// Frees every RID the world still owns
+		memdelete(registry);
+		world_registries.erase(rid);
+
+		if (const uint32_t *slot = world_handle_slots.getptr(rid)) {
+			entity_handle_slots[*slot].world_id = RID();
+			entity_handle_slots[*slot].mode = ENTITY_HANDLE_RID;
+			world_handle_slots.erase(rid);
 		}
-		flecs_variant_owners.erase(rid);
 
 		worlds.erase(rid);
 		flecs_world_owners.free(rid);
@@ -2306,34 +3270,67 @@ void FlecsServer::free_world(const RID& rid) {
 			memdelete(ref_storages.get(rid));
 			ref_storages.erase(rid);
 		}
+		if (write_batches.has(rid)) {
+			memdelete(write_batches.get(rid));
+			write_batches.erase(rid);
+		}
+		if (entity_pools.has(rid)) {
+			EntityPoolMap *pools = entity_pools.get(rid);
+			for (KeyValue<StringName, EntityPool *> &kv : *pools) {
+				memdelete(kv.value);
+			}
+			memdelete(pools);
+			entity_pools.erase(rid);
+		}
+		if (frame_histories.has(rid)) {
+			memdelete(frame_histories.get(rid));
+			frame_histories.erase(rid);
+		}
+		if (fixed_timesteps.has(rid)) {
+			memdelete(fixed_timesteps.get(rid));
+			fixed_timesteps.erase(rid);
+		}
+		world_forks.erase(rid);
+		// Forks of this world outlive it but no longer have a source
+		LocalVector<RID> orphaned_forks;
+		for (const KeyValue<RID, RID> &kv : world_forks) {
+			if (kv.value == rid) {
+				orphaned_forks.push_back(kv.key);
+			}
+		}
+		for (const RID &fork_id : orphaned_forks) {
+			world_forks.erase(fork_id);
+		}
 		return;
 	}
 
 }
 
 void FlecsServer::free_system(const RID& world_id, const RID& system_id, const bool include_flecs_world) {
-	if (flecs_variant_owners.has(world_id)) {
+	if (world_registries.has(world_id)) {
 		if (include_flecs_world) {
-			FlecsSystemVariant* system_variant = flecs_variant_owners.get(world_id).system_owner.get_or_null(system_id);
+			FlecsSystemVariant* system_variant = world_registries.get(world_id)->system_owner.get_or_null(system_id);
 			system_variant->get_system().destruct();
 		}
-		flecs_variant_owners.get(world_id).system_owner.free(system_id);
+		world_registries.get(world_id)->system_owner.free(system_id);
 	} else {
 		ERR_PRINT("FlecsServer::free_system: world_id is not a valid world");
 	}
 }
 
 void FlecsServer::free_script_system(const RID& world_id, const RID& script_system_id) {
-	if (flecs_variant_owners.has(world_id)) {
-		flecs_variant_owners.get(world_id).script_system_owner.free(script_system_id);
+	if (world_registries.has(world_id)) {
+		world_registries.get(world_id)->script_system_owner.free(script_system_id);
 	} else {
 		ERR_PRINT("FlecsServer::free_script_system: world_id is not a valid world");
 	}
 }
 
 void FlecsServer::free_entity(const RID& world_id, const RID& entity_id, bool include_flecs_world) {
-	if (flecs_variant_owners.has(world_id)) {
-		FlecsEntityVariant* entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id);
+	if (world_registries.has(world_id)) {
+		// Dense handles own no slot; only the Flecs entity can be destroyed
+		const bool is_handle = FlecsEntityHandle::is_handle(entity_id);
+		FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id);
 		if (entity_variant) {
 			// Remove from reverse lookup map before freeing
 			flecs::entity entity = entity_variant->get_entity();
@@ -2341,7 +3338,9 @@ void FlecsServer::free_entity(const RID& world_id, const RID& entity_id, bool in
 				// Trace entity destruction for neural visualizer
 				ECS_TRACE_ENTITY_DESTROY(entity.id());
 				
-				flecs_variant_owners.get(world_id).entity_id_to_rid.erase(entity.id());
+				if (!is_handle) {
+					world_registries.get(world_id)->entity_id_to_rid.erase(entity.id());
+				}
 			}
 			if (include_flecs_world) {
 				entity.destruct();
@@ -2349,20 +3348,377 @@ void FlecsServer::free_entity(const RID& world_id, const RID& entity_id, bool in
 		} else {
 			ERR_PRINT("FlecsServer::free_entity: entity_id is not a valid entity");
 		}
-		flecs_variant_owners.get(world_id).entity_owner.free(entity_id);
+		if (!is_handle) {
+			_unindex_entity_rid(entity_id);
+			world_registries.get(world_id)->entity_owner.free(entity_id);
+		}
 	} else {
 		ERR_PRINT("FlecsServer::free_entity: world_id is not a valid world");
 	}
 }
 
+void FlecsServer::free_entities_bulk(const RID &world_id, const PackedInt64Array &entity_ids, const bool free_server_resources) {
+	CHECK_WORLD_VALIDITY(world_id, free_entities_bulk);
+	flecs::world &world = world_variant->get_world();
+	WorldRegistry &owners = *world_registries.get(world_id);
+
+	// Server objects created by the utilities for this entity. Entities mirrored
+	// from a scene node borrow the node's RIDs and leave them alone, as do
+	// prefab instances for the components they inherit.
+	Vector<RID> rendering_rids;
+	Vector<RID> physics_2d_rids;
+	Vector<RID> physics_3d_rids;
+	LocalVector<RID> entity_rids;
+	entity_rids.reserve(entity_ids.size());
+	// Entities already swept, so a child listed next to its parent (or a
+	// parent listed twice) does not have its RIDs freed twice
+	HashSet<flecs::entity_t> swept;
+	LocalVector<flecs::entity> pending;
+
+	world.defer_begin();
+	for (const int64_t id : entity_ids) {
+		const flecs::entity_t root_id = static_cast<flecs::entity_t>(id);
+		if (!world.is_alive(root_id) || swept.has(root_id)) {
+			continue;
+		}
+
+		// Destroying the root also deletes its ChildOf descendants, so they
+		// are swept here as well while the hierarchy can still be walked
+		pending.clear();
+		pending.push_back(world.entity(root_id));
+		while (!pending.is_empty()) {
+			flecs::entity entity = pending[pending.size() - 1];
+			pending.remove_at(pending.size() - 1);
+			const flecs::entity_t entity_id = entity.id();
+			if (swept.has(entity_id)) {
+				continue;
+			}
+			swept.insert(entity_id);
+			entity.children([&](flecs::entity p_child) {
+				pending.push_back(p_child);
+			});
+
+			if (free_server_resources && !entity.has<ObjectInstanceComponent>() && !entity.has<SceneNodeComponent>()) {
+				if (entity.owns<RenderInstanceComponent>()) {
+					rendering_rids.push_back(entity.get<RenderInstanceComponent>().instance_id);
+				}
+				if (entity.owns<Area3DComponent>()) {
+					physics_3d_rids.push_back(entity.get<Area3DComponent>().area_id);
+				}
+				if (entity.owns<Body3DComponent>()) {
+					physics_3d_rids.push_back(entity.get<Body3DComponent>().body_id);
+				}
+				if (entity.owns<Joint3DComponent>()) {
+					physics_3d_rids.push_back(entity.get<Joint3DComponent>().joint_id);
+				}
+				if (entity.owns<SoftBody3DComponent>()) {
+					physics_3d_rids.push_back(entity.get<SoftBody3DComponent>().soft_body_id);
+				}
+				if (entity.owns<Area2DComponent>()) {
+					physics_2d_rids.push_back(entity.get<Area2DComponent>().area_id);
+				}
+				if (entity.owns<Body2DComponent>()) {
+					physics_2d_rids.push_back(entity.get<Body2DComponent>().body_id);
+				}
+				if (entity.owns<Joint2DComponent>()) {
+					physics_2d_rids.push_back(entity.get<Joint2DComponent>().joint_id);
+				}
+			}
+
+			RID entity_rid;
+			if (owners.entity_id_to_rid.take(entity_id, entity_rid)) {
+				entity_rids.push_back(entity_rid);
+			}
+
+			// Trace entity destruction for neural visualizer
+			ECS_TRACE_ENTITY_DESTROY(entity_id);
+		}
+		world.entity(root_id).destruct();
+	}
+	world.defer_end();
+
+	// One pass over the RID side tables
+	for (const RID &rid : entity_rids) {
+		entity_world_index.erase(rid);
+		owners.entity_owner.free(rid);
+	}
+
+	// All server frees go out as a single job, run with the other render commands
+	if (!rendering_rids.is_empty() || !physics_2d_rids.is_empty() || !physics_3d_rids.is_empty()) {
+		render_system_command_handler->enqueue_command([rendering_rids, physics_2d_rids, physics_3d_rids]() {
+			for (const RID &rid : rendering_rids) {
+				if (rid.is_valid()) {
+					RS::get_singleton()->free_rid(rid);
+				}
+			}
+			for (const RID &rid : physics_2d_rids) {
+				if (rid.is_valid()) {
+					PhysicsServer2D::get_singleton()->free_rid(rid);
+				}
+			}
+			for (const RID &rid : physics_3d_rids) {
+				if (rid.is_valid()) {
+					PhysicsServer3D::get_singleton()->free_rid(rid);
+				}
+			}
+		});
+	}
+}
+
+// Recreates the reflected components of p_source that p_fork does not know
+// yet (runtime components). They keep their entity id when it is free, so
+// their ids do not collide with entities copied over from the source.
+static void _clone_runtime_components(flecs::world &p_source, flecs::world &p_fork) {
+	LocalVector<flecs::entity_t> components;
+	p_source.query_builder<>()
+			.with<EcsStruct>()
+			.with<flecs::Component>()
+			.build()
+			.each([&](flecs::entity p_component) {
+				components.push_back(p_component.id());
+			});
+	// A struct can only use member types created before it
+	components.sort();
+
+	for (flecs::entity_t source_id : components) {
+		flecs::entity source_component(p_source.c_ptr(), source_id);
+		const flecs::string path = source_component.path();
+		flecs::entity existing = p_fork.lookup(path.c_str());
+		if (existing.is_valid() && existing.has<flecs::Component>()) {
+			continue;
+		}
+
+		const EcsStruct &source_struct = source_component.get<EcsStruct>();
+		const ecs_member_t *source_members = ecs_vec_first_t(&source_struct.members, ecs_member_t);
+		const int32_t member_count = ecs_vec_count(&source_struct.members);
+		// A truncated struct would have a different layout than the source's
+		// rows; it is skipped like a component with unresolved member types
+		if (member_count > ECS_MEMBER_DESC_CACHE_SIZE) {
+			ERR_PRINT(vformat("FlecsServer::fork_world: component '%s' has %d members, more than the %d a fork can recreate", String(path.c_str()), member_count, ECS_MEMBER_DESC_CACHE_SIZE));
+			continue;
+		}
+
+		ecs_struct_desc_t struct_desc = {};
+		bool resolved = true;
+		for (int32_t i = 0; i < member_count; i++) {
+			flecs::entity member_type = p_fork.lookup(flecs::entity(p_source.c_ptr(), source_members[i].type).path().c_str());
+			if (!member_type.is_valid()) {
+				resolved = false;
+				break;
+			}
+			struct_desc.members[i].name = source_members[i].name;
+			struct_desc.members[i].type = member_type.id();
+			struct_desc.members[i].count = source_members[i].count;
+			struct_desc.members[i].offset = source_members[i].offset;
+		}
+		if (!resolved) {
+			ERR_PRINT(vformat("FlecsServer::fork_world: cannot resolve the members of component '%s'", String(path.c_str())));
+			continue;
+		}
+
+		flecs::entity_t fork_id = 0;
+		if (!ecs_get_alive(p_fork.c_ptr(), source_id)) {
+			ecs_make_alive(p_fork.c_ptr(), source_id);
+			fork_id = source_id;
+		}
+		ecs_entity_desc_t entity_desc = {};
+		entity_desc.id = fork_id;
+		entity_desc.name = path.c_str();
+		entity_desc.sep = "::";
+		entity_desc.root_sep = "::";
+		struct_desc.entity = ecs_entity_init(p_fork.c_ptr(), &entity_desc);
+
+		const flecs::entity_t comp_id = ecs_struct_init(p_fork.c_ptr(), &struct_desc);
+		if (comp_id && source_component.name().c_str()) {
+			ComponentNameCache::get().insert(p_fork, StringName(source_component.name().c_str()), comp_id);
+		}
+	}
+}
+
+// Copies singletons (components set on their own component entity)
+static void _clone_singletons(flecs::world &p_source, flecs::world &p_fork) {
+	p_source.query_builder<>()
+			.with<flecs::Component>()
+			.build()
+			.each([&](flecs::entity p_component) {
+				const flecs::entity_t id = p_component.id();
+				if (!p_component.has(id)) {
+					return;
+				}
+				const ecs_type_info_t *info = ecs_get_type_info(p_source.c_ptr(), id);
+				flecs::entity target = p_fork.lookup(p_component.path().c_str());
+				if (!info || !target.is_valid()) {
+					return;
+				}
+				const ecs_type_info_t *target_info = ecs_get_type_info(p_fork.c_ptr(), target.id());
+				if (!target_info || target_info->size != info->size) {
+					return;
+				}
+				ecs_set_id(p_fork.c_ptr(), target.id(), target.id(), info->size, ecs_get_id(p_source.c_ptr(), id, id));
+			});
+}
+
+RID FlecsServer::fork_world(const RID &world_id) {
+	CHECK_WORLD_VALIDITY_V(world_id, RID(), fork_world);
+	flecs::world &source = world_variant->get_world();
+	if (source.is_deferred()) {
+		ERR_PRINT("FlecsServer::fork_world: cannot fork a world while it is progressing");
+		return RID();
+	}
+	// Native systems (pipeline manager ones included) and command handlers are
+	// C++ bound to the source world, so there is nothing to rebuild them from
+	const WorldRegistry &source_registry = *world_registries.get(world_id);
+	if (source_registry.system_owner.get_rid_count() > 0) {
+		ERR_PRINT(vformat("FlecsServer::fork_world: the world has %d native systems, which cannot be copied to a fork", source_registry.system_owner.get_rid_count()));
+		return RID();
+	}
+	if (!source_registry.command_handlers.is_empty()) {
+		ERR_PRINT(vformat("FlecsServer::fork_world: the world has %d command handlers, which cannot be copied to a fork", source_registry.command_handlers.size()));
+		return RID();
+	}
+
+	const RID fork_id = create_world();
+	flecs::world *fork = _get_world(fork_id);
+	if (!fork) {
+		ERR_PRINT("FlecsServer::fork_world: failed to create the fork");
+		return RID();
+	}
+
+	_clone_runtime_components(source, *fork);
+
+	FlecsWorldSnapshot::Restore restore;
+	String error;
+	if (!restore.parse(*fork, FlecsWorldSnapshot::save(source), error)) {
+		ERR_PRINT("FlecsServer::fork_world: " + error);
+		free_world(fork_id);
+		return RID();
+	}
+	restore.apply(*fork);
+	_clone_singletons(source, *fork);
+
+	// Systems are created after the entities so their ids come after the copied ones
+	WorldRegistry &source_owners = *world_registries.get(world_id);
+	for (const RID &script_system_id : source_owners.script_system_owner.get_owned_list()) {
+		const FlecsScriptSystem *source_system = source_owners.script_system_owner.get_or_null(script_system_id);
+		if (!source_system) {
+			continue;
+		}
+		FlecsScriptSystem script_system;
+		script_system.set_system_name(source_system->get_system_name());
+		script_system.init(fork_id, source_system->get_required_components(), source_system->get_callback());
+		script_system.set_projection(source_system->get_projection());
+		script_system.set_flush_phase(source_system->get_flush_phase());
+		script_system.set_change_only(source_system->is_change_only());
+		script_system.set_dispatch_mode(source_system->get_dispatch_mode());
+		script_system.set_change_observe_add_and_set(source_system->get_change_observe_add_and_set());
+		script_system.set_change_observe_remove(source_system->get_change_observe_remove());
+		script_system.set_multi_threaded(source_system->get_multi_threaded());
+		script_system.set_batch_flush_chunk_size(source_system->get_batch_flush_chunk_size());
+		script_system.set_flush_min_interval_msec(source_system->get_flush_min_interval_msec());
+		script_system.set_use_deferred_calls(source_system->get_use_deferred_calls());
+		script_system.set_auto_reset_per_frame(source_system->get_auto_reset_per_frame());
+		script_system.set_is_paused(source_system->get_is_paused());
+		script_system.set_instrumentation_enabled(source_system->get_instrumentation_enabled());
+		script_system.set_detailed_timing_enabled(source_system->get_detailed_timing_enabled());
+		script_system.set_max_sample_count(source_system->get_max_sample_count());
+		world_registries.get(fork_id)->script_system_owner.make_rid(script_system);
+	}
+
+	const int32_t stage_count = ecs_get_stage_count(source.c_ptr());
+	if (stage_count > 1) {
+		set_world_thread_count(fork_id, stage_count);
+	}
+	set_entity_handle_mode(fork_id, get_entity_handle_mode(world_id));
+	if (FixedTimestep **source_timestep = fixed_timesteps.getptr(world_id)) {
+		fixed_timesteps.get(fork_id)->copy_timing(**source_timestep);
+	}
+	// Entity ids are the same in the fork, so the pools carry over as they are
+	if (EntityPoolMap **source_pools = entity_pools.getptr(world_id)) {
+		EntityPoolMap *fork_pools = entity_pools.get(fork_id);
+		for (const KeyValue<StringName, EntityPool *> &kv : **source_pools) {
+			fork_pools->insert(kv.key, memnew(EntityPool(*kv.value)));
+		}
+	}
+
+	world_forks.insert(fork_id, world_id);
+	return fork_id;
+}
+
+void FlecsServer::discard_fork(const RID &fork_id) {
+	if (!world_forks.has(fork_id)) {
+		ERR_PRINT("FlecsServer::discard_fork: fork_id is not a forked world");
+		return;
+	}
+	world_forks.erase(fork_id);
+	free_world(fork_id);
+}
+
+RID FlecsServer::get_fork_source(const RID &fork_id) const {
+	const RID *source = world_forks.getptr(fork_id);
+	return source ? *source : RID();
+}
+
+PackedByteArray FlecsServer::snapshot_world(const RID &world_id) {
+	CHECK_WORLD_VALIDITY_V(world_id, PackedByteArray(), snapshot_world);
+	flecs::world &world = world_variant->get_world();
+	if (world.is_deferred()) {
+		ERR_PRINT("FlecsServer::snapshot_world: cannot snapshot a world while it is progressing");
+		return PackedByteArray();
+	}
+	return FlecsWorldSnapshot::save(world);
+}
+
+bool FlecsServer::restore_world(const RID &world_id, const PackedByteArray &snapshot) {
+	CHECK_WORLD_VALIDITY_V(world_id, false, restore_world);
+	flecs::world &world = world_variant->get_world();
+	if (world.is_deferred()) {
+		ERR_PRINT("FlecsServer::restore_world: cannot restore a world while it is progressing");
+		return false;
+	}
+
+	FlecsWorldSnapshot::Restore restore;
+	String error;
+	if (!restore.parse(world, snapshot, error)) {
+		ERR_PRINT("FlecsServer::restore_world: " + error);
+		return false;
+	}
+
+	// Entities created since the snapshot go through the regular bulk path so
+	// their RIDs and server objects are released
+	LocalVector<flecs::entity_t> stale;
+	restore.get_stale_entities(world, stale);
+	if (!stale.is_empty()) {
+		PackedInt64Array stale_ids;
+		stale_ids.resize(stale.size());
+		int64_t *w = stale_ids.ptrw();
+		for (uint32_t i = 0; i < stale.size(); i++) {
+			w[i] = int64_t(stale[i]);
+		}
+		free_entities_bulk(world_id, stale_ids, true);
+	}
+
+	// Writes batched against the old state would not make sense anymore
+	if (WorldWriteBatch **batch = write_batches.getptr(world_id)) {
+		(*batch)->clear();
+	}
+
+	restore.apply(world);
+	if (EntityPoolMap **pools = entity_pools.getptr(world_id)) {
+		for (KeyValue<StringName, EntityPool *> &kv : **pools) {
+			kv.value->resync(world);
+		}
+	}
+	return true;
+}
+
 flecs::entity FlecsServer::_get_entity(const RID& entity_id, const RID& world_id) {
 	CHECK_ENTITY_VALIDITY_V(entity_id, world_id, flecs::entity(), _get_entity);
 	return entity;
 }
 
 void FlecsServer::free_type_id(const RID& world_id, const RID& type_id) {
-	if (flecs_variant_owners.has(world_id)) {
-		RID_Owner_Wrapper &owner = flecs_variant_owners.get(world_id);
+	if (world_registries.has(world_id)) {
+		WorldRegistry &owner = *world_registries.get(world_id);
 		FlecsTypeIDVariant *type_variant = owner.type_id_owner.get_or_null(type_id);
 		if (type_variant) {
 			flecs::entity_t flecs_type_id = type_variant->get_type();
@@ -2440,29 +3796,37 @@ RID FlecsServer::_get_or_create_rid_for_entity(const RID &world_id, const flecs:
 		return RID();
 	}
 	
-	if (flecs_variant_owners.has(world_id)) {
+	if (world_registries.has(world_id)) {
 		uint64_t entity_id = entity.id();
-		
-		// O(1) lookup using reverse map
-		if (flecs_variant_owners.get(world_id).entity_id_to_rid.has(entity_id)) {
-			RID existing_rid = flecs_variant_owners.get(world_id).entity_id_to_rid[entity_id];
-			// Verify the RID is still valid
-			FlecsEntityVariant* owned_entity = flecs_variant_owners.get(world_id).entity_owner.get_or_null(existing_rid);
-			if (owned_entity) {
-				flecs::entity owned_flecs_entity = owned_entity->get_entity();
-				if (owned_flecs_entity.is_valid() && owned_flecs_entity.id() == entity_id) {
-					return existing_rid;
-				}
-			}
-			// RID was stale, remove from map
-			flecs_variant_owners.get(world_id).entity_id_to_rid.erase(entity_id);
+		if (_is_dense_world(world_id) && FlecsEntityHandle::can_encode(entity_id)) {
+			return _make_entity_rid(world_id, entity);
 		}
-		
-		// Entity not found in existing RIDs, create new one
-		RID new_rid = flecs_variant_owners.get(world_id).entity_owner.make_rid(FlecsEntityVariant(entity));
-		// Add to reverse lookup map
-		flecs_variant_owners.get(world_id).entity_id_to_rid[entity_id] = new_rid;
-		return new_rid;
+		WorldRegistry &owners = *world_registries.get(world_id);
+
+		// O(1) lookup using reverse map. May run on worker threads of
+		// multi-threaded systems: only the map's shard lock is held, and only
+		// to read and publish the entry; entity_owner and the sharded world
+		// index are thread-safe.
+		return owners.entity_id_to_rid.get_or_create(entity_id,
+				[&](const RID &existing_rid) {
+					// Verify the RID is still valid, a stale one gets replaced
+					FlecsEntityVariant *owned_entity = owners.entity_owner.get_or_null(existing_rid);
+					if (!owned_entity) {
+						return false;
+					}
+					flecs::entity owned_flecs_entity = owned_entity->get_entity();
+					return owned_flecs_entity.is_valid() && owned_flecs_entity.id() == entity_id;
+				},
+				[&]() {
+					return _make_entity_rid(world_id, entity);
+				},
+				[&](const RID &discarded_rid) {
+					// A replaced stale RID or a lost race: free it and drop its index entry
+					_unindex_entity_rid(discarded_rid);
+					if (owners.entity_owner.owns(discarded_rid)) {
+						owners.entity_owner.free(discarded_rid);
+					}
+				});
 	} else {
 		ERR_PRINT("FlecsServer::_get_or_create_rid_for_entity: world_id is not a valid world");
 		return RID();
@@ -2480,6 +3844,14 @@ FlecsScriptSystem FlecsServer::_get_script_system(const RID &script_system_id, c
 	return *script_system;
 }
 
+Dictionary FlecsServer::_component_to_dict_with_cursor(const flecs::entity &entity, flecs::entity_t component_id) {
+	if (!entity.is_alive() || !entity.has(component_id)) {
+		return Dictionary();
+	}
+	flecs::world world = entity.world();
+	return component_to_dict_cursor_walk(world, component_id, entity.get(component_id));
+}
+
 flecs::entity_t FlecsServer::_get_type_id(const RID &entity_id, const RID &world_id) {
 	CHECK_TYPE_ID_VALIDITY_V(entity_id, world_id, flecs::entity_t(), _get_type_id);
 	flecs::entity_t type_id = type_id_variant->get_type();
@@ -2496,7 +3868,7 @@ void FlecsServer::set_world_singleton_with_name(const RID &world_id, const Strin
 }
 void FlecsServer::set_world_singleton_with_id(const RID &world_id, const RID &comp_type_id, const Dictionary& comp_data){
 	CHECK_WORLD_VALIDITY(world_id, set_world_singleton_with_id);
-	FlecsTypeIDVariant* type_variant = flecs_variant_owners.get(world_id).type_id_owner.get_or_null(comp_type_id);
+	FlecsTypeIDVariant* type_variant = world_registries.get(world_id)->type_id_owner.get_or_null(comp_type_id);
 	if (!type_variant) {
 		ERR_PRINT("FlecsServer::set_world_singleton_with_id: Component type ID not found: " + itos(comp_type_id.get_id()));
 		return;
@@ -2525,7 +3897,7 @@ Dictionary FlecsServer::get_world_singleton_with_name(const RID &world_id, const
 }
 Dictionary FlecsServer::get_world_singleton_with_id(const RID &world_id, const RID &comp_type_id){
 	CHECK_WORLD_VALIDITY_V(world_id, Dictionary(), get_world_singleton_with_id);
-	FlecsTypeIDVariant* type_variant = flecs_variant_owners.get(world_id).type_id_owner.get_or_null(comp_type_id);
+	FlecsTypeIDVariant* type_variant = world_registries.get(world_id)->type_id_owner.get_or_null(comp_type_id);
 	if (!type_variant) {
 		ERR_PRINT("FlecsServer::get_world_singleton_with_id: Component type ID not found: " + itos(comp_type_id.get_id()));
 		return Dictionary();
@@ -2546,7 +3918,7 @@ Dictionary FlecsServer::get_world_singleton_with_id(const RID &world_id, const R
 
 void FlecsServer::set_script_system_dispatch_mode(const RID &world_id, const RID &script_system_id, int mode) {
 	CHECK_SCRIPT_SYSTEM_VALIDITY(script_system_id, world_id, set_script_system_dispatch_mode);
-	if (mode < 0 || mode > 1) { ERR_PRINT("Invalid dispatch mode"); return; }
+	if (mode < 0 || mode > FlecsScriptSystem::DISPATCH_COLUMNAR) { ERR_PRINT("Invalid dispatch mode"); return; }
 	script_system->set_dispatch_mode(static_cast<FlecsScriptSystem::DispatchMode>(mode));
 }
 
@@ -2578,6 +3950,8 @@ Dictionary FlecsServer::get_script_system_instrumentation(const RID &world_id, c
 	d["last_frame_dispatch_usec"] = (int64_t)script_system->get_last_frame_dispatch_usec();
 	d["total_entities_processed"] = (int64_t)script_system->get_total_entities_processed();
 	d["total_callbacks_invoked"] = (int64_t)script_system->get_total_callbacks_invoked();
+	d["total_columns_written"] = (int64_t)script_system->get_total_columns_written();
+	d["total_change_events_coalesced"] = (int64_t)script_system->get_total_change_events_coalesced();
 	d["change_only"] = script_system->is_change_only();
 	d["dispatch_mode"] = (int64_t)script_system->get_dispatch_mode();
 	return d;
@@ -2608,16 +3982,16 @@ Dictionary FlecsServer::get_all_systems(const RID &world_id) {
 	Dictionary result;
 	Array cpp_list; Array script_list;
 	// C++ systems
-	for (RID rid : flecs_variant_owners.get(world_id).system_owner.get_owned_list()) {
-		FlecsSystemVariant *sv = flecs_variant_owners.get(world_id).system_owner.get_or_null(rid);
+	for (RID rid : world_registries.get(world_id)->system_owner.get_owned_list()) {
+		FlecsSystemVariant *sv = world_registries.get(world_id)->system_owner.get_or_null(rid);
 		if (!sv) { continue; }
 		flecs::system sys = sv->get_system();
 		Dictionary d; d["rid"] = rid; d["name"] = String("cpp_system_") + itos((int64_t)sys.id()); d["depends_on"] = Variant(); d["type"] = String("cpp");
 		cpp_list.push_back(d);
 	}
 	// Script systems
-	for (RID rid : flecs_variant_owners.get(world_id).script_system_owner.get_owned_list()) {
-		FlecsScriptSystem *ss = flecs_variant_owners.get(world_id).script_system_owner.get_or_null(rid);
+	for (RID rid : world_registries.get(world_id)->script_system_owner.get_owned_list()) {
+		FlecsScriptSystem *ss = world_registries.get(world_id)->script_system_owner.get_or_null(rid);
 		if (!ss) { continue; }
 		Dictionary d; d["rid"] = rid; d["name"] = String("ScriptSystem#") + itos(ss->get_system_id());
 		uint32_t dep = ss->get_system_dependency_id();
@@ -2657,14 +4031,50 @@ bool FlecsServer::get_script_system_auto_reset(const RID &world_id, const RID &s
 
 Dictionary FlecsServer::get_world_frame_summary(const RID &world_id) {
 	CHECK_WORLD_VALIDITY_V(world_id, Dictionary(), get_world_frame_summary);
-	Dictionary *found = last_frame_summaries.getptr(world_id);
-	if (!found) { return Dictionary(); }
-	return *found;
+	FrameSummaryHistory **history = frame_histories.getptr(world_id);
+	if (!history) { return Dictionary(); }
+	const WorldFrameSummary *latest = (*history)->get(0);
+	if (!latest) { return Dictionary(); }
+	return latest->to_dictionary();
+}
+
+Array FlecsServer::get_world_frame_history(const RID &world_id, int max_frames) {
+	CHECK_WORLD_VALIDITY_V(world_id, Array(), get_world_frame_history);
+	Array result;
+	FrameSummaryHistory **history = frame_histories.getptr(world_id);
+	if (!history) { return result; }
+	uint32_t frame_count = (*history)->size();
+	if (max_frames >= 0) {
+		frame_count = MIN(frame_count, (uint32_t)max_frames);
+	}
+	for (uint32_t age = 0; age < frame_count; age++) {
+		result.push_back((*history)->get(age)->to_dictionary());
+	}
+	return result;
+}
+
+void FlecsServer::set_world_frame_history_size(const RID &world_id, int frame_count) {
+	CHECK_WORLD_VALIDITY(world_id, set_world_frame_history_size);
+	if (frame_count < 1) {
+		ERR_PRINT("FlecsServer::set_world_frame_history_size: frame_count must be at least 1");
+		return;
+	}
+	if (FrameSummaryHistory **history = frame_histories.getptr(world_id)) {
+		(*history)->set_capacity(frame_count);
+	}
+}
+
+int FlecsServer::get_world_frame_history_size(const RID &world_id) {
+	CHECK_WORLD_VALIDITY_V(world_id, 0, get_world_frame_history_size);
+	FrameSummaryHistory **history = frame_histories.getptr(world_id);
+	return history ? (int)(*history)->get_capacity() : 0;
 }
 
 void FlecsServer::reset_world_frame_summary(const RID &world_id) {
 	CHECK_WORLD_VALIDITY(world_id, reset_world_frame_summary);
-	last_frame_summaries.erase(world_id);
+	if (FrameSummaryHistory **history = frame_histories.getptr(world_id)) {
+		(*history)->clear();
+	}
 }
 
 void FlecsServer::set_script_system_detailed_timing(const RID &world_id, const RID &script_system_id, bool enabled) {
@@ -2867,8 +4277,8 @@ Dictionary FlecsServer::get_world_distribution_summary(const RID &world_id) {
 	Vector<double> merged;
 	int total_invocations = 0;
 	const int MERGE_CAP = 4096;
-	for (RID ss_rid : flecs_variant_owners.get(world_id).script_system_owner.get_owned_list()) {
-		FlecsScriptSystem *ss = flecs_variant_owners.get(world_id).script_system_owner.get_or_null(ss_rid);
+	for (RID ss_rid : world_registries.get(world_id)->script_system_owner.get_owned_list()) {
+		FlecsScriptSystem *ss = world_registries.get(world_id)->script_system_owner.get_or_null(ss_rid);
 		if (!ss || !ss->get_detailed_timing_enabled()) { continue; }
 		const Vector<uint64_t> &samples = ss->_get_frame_dispatch_samples();
 		for (int i = 0; i < samples.size() && merged.size() < MERGE_CAP; ++i) {
@@ -2923,8 +4333,8 @@ Dictionary FlecsServer::get_system_metrics(const RID &world_id) {
 	HashSet<uint64_t> added_system_ids;
 	
 	// Collect metrics for script systems
-	for (RID ss_rid : flecs_variant_owners.get(world_id).script_system_owner.get_owned_list()) {
-		FlecsScriptSystem *ss = flecs_variant_owners.get(world_id).script_system_owner.get_or_null(ss_rid);
+	for (RID ss_rid : world_registries.get(world_id)->script_system_owner.get_owned_list()) {
+		FlecsScriptSystem *ss = world_registries.get(world_id)->script_system_owner.get_or_null(ss_rid);
 		if (!ss) { continue; }
 		
 		// Track this system's entity ID if it has one
@@ -2983,8 +4393,8 @@ Dictionary FlecsServer::get_system_metrics(const RID &world_id) {
 	// Get world pointer for stats queries
 	flecs::world* world_ptr = &world_variant->get_world();
 	
-	for (RID sys_rid : flecs_variant_owners.get(world_id).system_owner.get_owned_list()) {
-		FlecsSystemVariant *sv = flecs_variant_owners.get(world_id).system_owner.get_or_null(sys_rid);
+	for (RID sys_rid : world_registries.get(world_id)->system_owner.get_owned_list()) {
+		FlecsSystemVariant *sv = world_registries.get(world_id)->system_owner.get_or_null(sys_rid);
 		if (!sv) { continue; }
 		
 		flecs::system sys = sv->get_system();
@@ -3176,8 +4586,18 @@ Dictionary FlecsServer::get_system_metrics(const RID &world_id) {
 		}
 	}
 	
+	Array pools_array;
+	if (EntityPoolMap **pools = entity_pools.getptr(world_id)) {
+		for (const KeyValue<StringName, EntityPool *> &kv : **pools) {
+			Dictionary pool_metric = kv.value->get_stats();
+			pool_metric["name"] = kv.key;
+			pools_array.push_back(pool_metric);
+		}
+	}
+
 	result["systems"] = systems_array;
 	result["system_count"] = (int64_t)systems_array.size();
+	result["entity_pools"] = pools_array;
 	result["total_time_usec"] = (int64_t)total_time_usec;
 	result["frame_count"] = Engine::get_singleton()->get_frames_drawn();
 	
@@ -3204,6 +4624,37 @@ bool FlecsServer::get_script_system_multi_threaded(const RID &world_id, const RI
 	return script_system->get_multi_threaded();
 }
 
+void FlecsServer::set_script_system_projection(const RID &world_id, const RID &script_system_id, const PackedStringArray &paths) {
+	CHECK_SCRIPT_SYSTEM_VALIDITY(script_system_id, world_id, set_script_system_projection);
+	script_system->set_projection(paths);
+}
+
+PackedStringArray FlecsServer::get_script_system_projection(const RID &world_id, const RID &script_system_id) {
+	CHECK_SCRIPT_SYSTEM_VALIDITY_V(script_system_id, world_id, PackedStringArray(), get_script_system_projection);
+	return script_system->get_projection();
+}
+
+void FlecsServer::set_script_system_flush_phase(const RID &world_id, const RID &script_system_id, const String &phase) {
+	CHECK_SCRIPT_SYSTEM_VALIDITY(script_system_id, world_id, set_script_system_flush_phase);
+	flecs::entity_t phase_id = 0;
+	if (!phase.is_empty()) {
+		phase_id = _lookup_phase(*script_system->_get_world(), phase);
+		if (phase_id == 0) {
+			ERR_PRINT("FlecsServer::set_script_system_flush_phase: unknown pipeline phase: " + phase);
+			return;
+		}
+	}
+	script_system->set_flush_phase(phase_id);
+}
+
+String FlecsServer::get_script_system_flush_phase(const RID &world_id, const RID &script_system_id) {
+	CHECK_SCRIPT_SYSTEM_VALIDITY_V(script_system_id, world_id, String(), get_script_system_flush_phase);
+	if (script_system->get_flush_phase() == 0) {
+		return String();
+	}
+	return String(script_system->_get_world()->entity(script_system->get_flush_phase()).name().c_str());
+}
+
 void FlecsServer::set_script_system_batch_chunk_size(const RID &world_id, const RID &script_system_id, int chunk_size) {
 	CHECK_SCRIPT_SYSTEM_VALIDITY(script_system_id, world_id, set_script_system_batch_chunk_size);
 	script_system->set_batch_flush_chunk_size(chunk_size);
@@ -3276,7 +4727,7 @@ void ScriptSystemInspector::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_total_callbacks"), &ScriptSystemInspector::get_total_callbacks);
 	ClassDB::bind_method(D_METHOD("get_total_entities_processed"), &ScriptSystemInspector::get_total_entities_processed);
 
-	ADD_PROPERTY(PropertyInfo(Variant::INT, "dispatch_mode", PROPERTY_HINT_ENUM, "Per Entity,Batch"), "set_dispatch_mode", "get_dispatch_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "dispatch_mode", PROPERTY_HINT_ENUM, "Per Entity,Batch,Columnar"), "set_dispatch_mode", "get_dispatch_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "change_only", PROPERTY_HINT_NONE, "Observe only component changes"), "set_change_only", "get_change_only");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "observe_add_and_set", PROPERTY_HINT_NONE, "When change_only: also count OnAdd events"), "set_observe_add_and_set", "get_observe_add_and_set");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "observe_remove", PROPERTY_HINT_NONE, "Track removal events (OnRemove observer)"), "set_observe_remove", "get_observe_remove");
@@ -18,7 +18,16 @@
 #include "modules/godot_turbo/ecs/systems/command.h"
 #include "modules/godot_turbo/ecs/systems/pipeline_manager.h"
 #include "core/variant/callable.h"
+#include "modules/godot_turbo/ecs/flecs_types/component_name_cache.h"
+#include "modules/godot_turbo/ecs/flecs_types/entity_pool.h"
+#include "modules/godot_turbo/ecs/flecs_types/entity_rid_map.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_column_access.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_entity_handle.h"
 #include "modules/godot_turbo/ecs/flecs_types/flecs_variant.h"
+#include "modules/godot_turbo/ecs/flecs_types/fixed_timestep.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_worker_pool.h"
+#include "modules/godot_turbo/ecs/flecs_types/frame_summary_history.h"
+#include "modules/godot_turbo/ecs/flecs_types/world_write_batch.h"
 #include "modules/godot_turbo/ecs/systems/utility/node_storage.h"
 #include "modules/godot_turbo/ecs/systems/utility/ref_storage.h"
 #include <limits>
@@ -26,7 +35,7 @@
 
 
 #define CHECK_ENTITY_VALIDITY_V(entity_id, world_id, default_value, func_name) \
-	FlecsEntityVariant* entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id); \
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id); \
 	if (!entity_variant) { \
 		ERR_PRINT("FlecsServer:: " #func_name ": entity_id is not a valid entity"); \
 		return default_value; \
@@ -41,7 +50,7 @@
 	} \
 
 #define CHECK_ENTITY_VALIDITY(entity_id, world_id, func_name) \
-	FlecsEntityVariant* entity_variant = flecs_variant_owners.get(world_id).entity_owner.get_or_null(entity_id); \
+	FlecsEntityRef entity_variant = _resolve_entity(world_id, entity_id); \
 	if (!entity_variant) { \
 		ERR_PRINT("FlecsServer::" #func_name ": entity_id is not a valid entity"); \
 		return; \
@@ -57,7 +66,7 @@
 
 
 #define CHECK_SYSTEM_VALIDITY_V(system_id, world_id, default_value, func_name) \
-	FlecsSystemVariant* system_variant = flecs_variant_owners.get(world_id).system_owner.get_or_null(system_id); \
+	FlecsSystemVariant* system_variant = world_registries.get(world_id)->system_owner.get_or_null(system_id); \
 	if (!system_variant) { \
 		ERR_PRINT("FlecsServer::" #func_name ": system_id is not a valid system"); \
 		return default_value; \
@@ -65,7 +74,7 @@
 
 
 #define CHECK_SYSTEM_VALIDITY(system_id, world_id, func_name) \
-	FlecsSystemVariant* system_variant = flecs_variant_owners.get(world_id).system_owner.get_or_null(system_id); \
+	FlecsSystemVariant* system_variant = world_registries.get(world_id)->system_owner.get_or_null(system_id); \
 	if (!system_variant) { \
 		ERR_PRINT("FlecsServer::" #func_name ": system_id is not a valid system"); \
 		return; \
@@ -73,35 +82,35 @@
 
 
 #define CHECK_SCRIPT_SYSTEM_VALIDITY_V(script_system_id, world_id, default_value, func_name) \
-	FlecsScriptSystem* script_system = flecs_variant_owners.get(world_id).script_system_owner.get_or_null(script_system_id); \
+	FlecsScriptSystem* script_system = world_registries.get(world_id)->script_system_owner.get_or_null(script_system_id); \
 	if (!script_system) { \
 		ERR_PRINT("FlecsServer::" #func_name ": script_system_id is not a valid script system"); \
 		return default_value; \
 	} \
 
 #define CHECK_SCRIPT_SYSTEM_VALIDITY(script_system_id, world_id, func_name) \
-	FlecsScriptSystem* script_system = flecs_variant_owners.get(world_id).script_system_owner.get_or_null(script_system_id); \
+	FlecsScriptSystem* script_system = world_registries.get(world_id)->script_system_owner.get_or_null(script_system_id); \
 	if (!script_system) { \
 		ERR_PRINT("FlecsServer::" #func_name ": script_system_id is not a valid script system"); \
 		return; \
 	} \
 
 #define CHECK_QUERY_VALIDITY_V(query_id, world_id, default_value, func_name) \
-	FlecsQuery* query = flecs_variant_owners.get(world_id).query_owner.get_or_null(query_id); \
+	FlecsQuery* query = world_registries.get(world_id)->query_owner.get_or_null(query_id); \
 	if (!query) { \
 		ERR_PRINT("FlecsServer::" #func_name ": query_id is not a valid query"); \
 		return default_value; \
 	} \
 
 #define CHECK_QUERY_VALIDITY(query_id, world_id, func_name) \
-	FlecsQuery* query = flecs_variant_owners.get(world_id).query_owner.get_or_null(query_id); \
+	FlecsQuery* query = world_registries.get(world_id)->query_owner.get_or_null(query_id); \
 	if (!query) { \
 		ERR_PRINT("FlecsServer::" #func_name ": query_id is not a valid query"); \
 		return; \
 	} \
 
 #define CHECK_TYPE_ID_VALIDITY_V(type_rid, world_id, default_value, func_name) \
-	FlecsTypeIDVariant* type_id_variant = flecs_variant_owners.get(world_id).type_id_owner.get_or_null(type_rid); \
+	FlecsTypeIDVariant* type_id_variant = world_registries.get(world_id)->type_id_owner.get_or_null(type_rid); \
 	if (!type_id_variant) { \
 		ERR_PRINT("FlecsServer::" #func_name ": type_id is not a valid type ID"); \
 		return default_value; \
@@ -109,7 +118,7 @@
 
 
 #define CHECK_TYPE_ID_VALIDITY(type_id, world_id, func_name) \
-	FlecsTypeIDVariant* type_id_variant = flecs_variant_owners.get(world_id).type_id_owner.get_or_null(type_id); \
+	FlecsTypeIDVariant* type_id_variant = world_registries.get(world_id)->type_id_owner.get_or_null(type_id); \
 	if (!type_id_variant) { \
 		ERR_PRINT("FlecsServer::" #func_name ": type_id is not a valid type ID"); \
 		return; \
@@ -224,6 +233,17 @@ public:
 	enum DispatchMode {
 		DISPATCH_PER_ENTITY = FlecsScriptSystem::DISPATCH_PER_ENTITY,
 		DISPATCH_BATCH = FlecsScriptSystem::DISPATCH_BATCH,
+		DISPATCH_COLUMNAR = FlecsScriptSystem::DISPATCH_COLUMNAR,
+	};
+
+	// How entity handles are handed out to scripts for a world.
+	// ENTITY_HANDLE_RID allocates a RID_Owner slot and a reverse-map entry per
+	// entity. ENTITY_HANDLE_DENSE derives the handle from the Flecs entity id
+	// (see FlecsEntityHandle) and allocates nothing. Every entity API accepts
+	// both kinds, whatever the current mode.
+	enum EntityHandleMode {
+		ENTITY_HANDLE_RID,
+		ENTITY_HANDLE_DENSE,
 	};
 
 	static FlecsServer *get_singleton();
@@ -237,12 +257,73 @@ public:
 	int8_t get_world_count() const;
 	TypedArray<RID> get_world_list() const;
 	void init_world(const RID& world_id);
+	// Threads of the FlecsWorkerPool shared by all worlds. Worlds run their
+	// multi-threaded systems on task threads taken from this pool.
+	void set_worker_thread_count(const int count);
+	int get_worker_thread_count() const;
+	// Number of stages a world splits multi-threaded systems over (the caller
+	// plus count - 1 pool tasks); init_world() uses every pool thread
+	void set_world_thread_count(const RID &world_id, const int count);
+	int get_world_thread_count(const RID &world_id);
+	// Fixed-step physics (see FixedTimestep): systems in the
+	// FlecsPhases::OnPhysicsUpdate phase run ticks_per_second times per second
+	// of delta, at most max_steps times per progress_world(). 0 runs them once
+	// per frame with the frame delta.
+	void set_world_tick_rate(const RID &world_id, const double ticks_per_second);
+	double get_world_tick_rate(const RID &world_id);
+	void set_world_max_physics_steps(const RID &world_id, const int max_steps);
+	int get_world_max_physics_steps(const RID &world_id);
+	// Also published as the PhysicsInterpolation world singleton
+	double get_world_interpolation_alpha(const RID &world_id);
 
 	bool progress_world(const RID& world_id, const double delta);
+	// Progresses independent worlds concurrently on the shared worker pool and
+	// returns once all of them are done. The render command handler runs
+	// afterwards on the calling thread. Worlds with script systems, runner
+	// systems or script observers are progressed one at a time on the calling
+	// thread, since their callbacks can call back into the server.
+	// Many small worlds scale best with set_world_thread_count(world, 1).
+	bool progress_worlds(const TypedArray<RID> &world_ids, const double delta);
 	RID add_script_system(const RID& world_id, const Array &component_types, const Callable &callable);
 	RID create_entity(const RID& world_id);
 	RID create_entity_with_name(const RID& world_id, const String &name);
 	RID create_entity_with_name_and_comps(const RID& world_id, const String &name, const TypedArray<RID> &components_type_ids);
+	// Spawns count entities with the same component set in a single table move.
+	// initial_data maps a component name to either a packed column for the whole
+	// component or a Dictionary of field name -> packed column (see
+	// get_component_field_column for the layouts). Returns the Flecs entity ids;
+	// RIDs are only made when create_rids is set, otherwise use get_entity_rid().
+	PackedInt64Array create_entities_bulk(const RID &world_id, const int count, const PackedStringArray &component_names, const Dictionary &initial_data = Dictionary(), const bool create_rids = false);
+	// Prefab entity holding components (component name -> field Dictionary,
+	// or null to add the component with default values). Listed components
+	// become shared: instances read them from the prefab until they set their
+	// own value. Sharing is a world-wide trait of the component, set the first
+	// time a prefab uses it, and fails with an error once any entity already
+	// has the component. Queries and script systems only see shared components
+	// through instances when created after the prefab.
+	RID create_prefab(const RID &world_id, const Dictionary &components, const String &name = String());
+	// Spawns count instances of a prefab in one table move. overrides_columns
+	// has the create_entities_bulk initial_data layout and gives every instance
+	// its own copy of those components.
+	PackedInt64Array instantiate_prefab(const RID &world_id, const RID &prefab_id, const int count, const Dictionary &overrides_columns = Dictionary(), const bool create_rids = false);
+
+	// ===== Entity pools =====
+	// Released entities are parked with the Disabled tag instead of being
+	// destroyed: systems and queries skip them, while their components, ids
+	// and RIDs stay in place. Acquiring re-enables parked entities first and
+	// only creates new ones (through create_entities_bulk) when the pool is
+	// empty. initial_data has the create_entities_bulk column layout and is
+	// written in place over whatever the entities held before.
+	bool create_entity_pool(const RID &world_id, const StringName &pool_name, const PackedStringArray &component_names, const int prewarm = 0);
+	PackedInt64Array acquire_pooled_entities(const RID &world_id, const StringName &pool_name, const int count, const Dictionary &initial_data = Dictionary());
+	// Returns how many entities were parked; ids not acquired from the pool are ignored
+	int release_pooled_entities(const RID &world_id, const StringName &pool_name, const PackedInt64Array &entity_ids);
+	// Destroys the parked entities; entities still in use become regular entities
+	void free_entity_pool(const RID &world_id, const StringName &pool_name);
+	// acquires, hits, misses, hit_rate, releases, active, peak_active, parked,
+	// parked_bytes, bookkeeping_bytes
+	Dictionary get_entity_pool_stats(const RID &world_id, const StringName &pool_name);
+	RID get_entity_rid(const RID &world_id, const int64_t entity_id);
 	RID lookup(const RID& world_id, const String &entity_name);
 	flecs::world *_get_world(const RID &world_id);
 	RID get_world_of_entity(const RID &entity_id);
@@ -261,7 +342,7 @@ public:
 	Ref<CommandHandler> get_render_system_command_handler(const RID &world_id);
 	PipelineManager* _get_pipeline_manager(const RID &world_id);
 	void remove_all_components_from_entity(const RID &entity_id);
-	bool has_component(const RID &entity_id,const String &component_type);
+	bool has_component(const RID &entity_id,const StringName &component_type);
 	PackedStringArray get_component_types_as_name(const RID &entity_id);
 	TypedArray<RID> get_component_types_as_id(const RID &entity_id);
 
@@ -270,12 +351,12 @@ public:
 
 	String get_entity_name(const RID &entity_id);
 	void set_entity_name(const RID& entity_id, const String &p_name);
-	void set_component(const RID& entity_id, const String& component_name, const Dictionary &comp_data);
+	void set_component(const RID& entity_id, const StringName& component_name, const Dictionary &comp_data);
 	void remove_component_from_entity_with_id(const RID &entity_id, const RID &component_type_id);
-	void remove_component_from_entity_with_name(const RID &entity_id,const String &component_type);
-	Dictionary get_component_by_name(const RID &entity_id, const String &component_type);
+	void remove_component_from_entity_with_name(const RID &entity_id,const StringName &component_type);
+	Dictionary get_component_by_name(const RID &entity_id, const StringName &component_type);
 	Dictionary get_component_by_id(const RID& entity_id, const RID& component_type_id);
-	RID get_component_type_by_name(const RID& entity_id, const String &component_type);
+	RID get_component_type_by_name(const RID& entity_id, const StringName &component_type);
 	RID get_parent(const RID &entity_id);
 	void set_parent(const RID& entity_id, const RID& parent_id);
 	void add_component(const RID &entity_id, const RID &comp_rid);
@@ -292,7 +373,45 @@ public:
 	void remove_relationship(const RID& entity_id, const RID &relationship);
 	RID get_relationship(const RID& entity_id, const String& first_entity, const String& second_entity);
 	TypedArray<RID> get_relationships(const RID& entity_id);
+
+	// ===== Write batch API =====
+	// Records writes into the world's WorldWriteBatch instead of applying them.
+	// They are coalesced per entity/component and applied in one deferred block
+	// before the next progress_world(), in the phase set with
+	// set_write_batch_flush_phase(), or on flush_write_batch().
+	void batch_set_component(const RID &entity_id, const StringName &component_type, const Dictionary &comp_data);
+	void batch_add_component(const RID &entity_id, const StringName &component_type);
+	void batch_remove_component(const RID &entity_id, const StringName &component_type);
+	// Applies pending writes now and returns how many ops were applied
+	int flush_write_batch(const RID &world_id);
+	void clear_write_batch(const RID &world_id);
+	int get_write_batch_pending_count(const RID &world_id);
+	// Phase name (OnLoad, PreUpdate, OnUpdate, PostUpdate, PreStore, ... or a
+	// custom phase); an empty name flushes before each progress_world()
+	void set_write_batch_flush_phase(const RID &world_id, const String &phase);
+	String get_write_batch_flush_phase(const RID &world_id);
 	RID _create_rid_for_entity(const RID& world_id, const flecs::entity &entity);
+	// Column of create_entities_bulk() initial data, validated before anything is created
+	struct BulkColumn {
+		FlecsColumnAccess::FieldLayout layout;
+		Variant column;
+	};
+	bool _resolve_bulk_columns(flecs::world &world, const char *p_method, const int count, const Dictionary &initial_data, LocalVector<BulkColumn> &r_columns);
+	EntityPool *_get_entity_pool(const RID &world_id, const StringName &pool_name);
+	// Shared by create_entities_bulk and instantiate_prefab; prefab is 0 for plain entities
+	PackedInt64Array _create_entities_bulk(const RID &world_id, flecs::world &world, const char *p_method, const int count, const flecs::entity_t prefab, const PackedStringArray &component_names, const Dictionary &initial_data, const bool create_rids);
+	void set_entity_handle_mode(const RID &world_id, EntityHandleMode mode);
+	EntityHandleMode get_entity_handle_mode(const RID &world_id) const;
+	// Dense handle for a Flecs entity id, regardless of the world's handle mode
+	RID get_entity_handle(const RID &world_id, const int64_t entity_id);
+	// Component lookup by name through the per-world ComponentNameCache.
+	// Returns an invalid entity when no such name exists.
+	flecs::entity _lookup_component(const flecs::world &world, const StringName &component_name);
+	// Resolves an owned entity RID or a dense handle belonging to world_id
+	FlecsEntityRef _resolve_entity(const RID &world_id, const RID &entity_id);
+	// Entity RID -> world index maintenance (see get_world_of_entity)
+	void _index_entity_rid(const RID &entity_id, const RID &world_id);
+	void _unindex_entity_rid(const RID &entity_id);
 	RID _create_rid_for_system(const RID& world_id, const flecs::system &system);
 	RID _get_rid_for_world(const flecs::world *world);
 	RID _create_rid_for_type_id(const RID& world_id, const flecs::entity_t &type_id);
@@ -301,6 +420,28 @@ public:
 	void free_system(const RID& world_id, const RID& system_id, const bool include_flecs_world);
 	void free_script_system(const RID& world_id, const RID& script_system_id);
 	void free_entity(const RID& world_id, const RID& entity_id, const bool include_flecs_world);
+	// Destroys a batch of entities (ids as returned by create_entities_bulk) in one
+	// deferred block and drops their RIDs in a single sweep. Server objects the
+	// entities own are freed in one command on the render command handler.
+	// Children deleted along with a listed parent are swept the same way.
+	void free_entities_bulk(const RID &world_id, const PackedInt64Array &entity_ids, const bool free_server_resources = true);
+	// Binary checkpoint of every entity of the world (see FlecsWorldSnapshot).
+	// Restoring destroys entities created since the snapshot, brings back the
+	// ones destroyed since, and copies component columns back in place.
+	// Components that own memory (custom copy/move/dtor hooks) but have no
+	// reflection data cannot be encoded: they are saved without values and
+	// come back default constructed, with a warning at save time.
+	PackedByteArray snapshot_world(const RID &world_id);
+	bool restore_world(const RID &world_id, const PackedByteArray &snapshot);
+	// Independent copy of a world for speculative simulation: same components,
+	// script systems, entities and singletons. Progressing or editing the fork
+	// never touches the source. Free it with discard_fork(). Worlds with native
+	// systems or command handlers cannot be forked. Freeing the source turns
+	// its forks into plain worlds, to be freed with free_world().
+	RID fork_world(const RID &world_id);
+	void discard_fork(const RID &fork_id);
+	// World a fork was made from, or an invalid RID for worlds that are not forks
+	RID get_fork_source(const RID &fork_id) const;
 	flecs::entity _get_entity(const RID& entity_id, const RID& world_id);
 	void free_type_id(const RID& world_id, const RID& type_id);
 	void add_to_ref_storage(const Ref<Resource> &resource, const RID &world_id);
@@ -312,6 +453,8 @@ public:
 	RID _get_or_create_rid_for_entity(const RID &world_id, const flecs::entity &entity);
 	flecs::system _get_system(const RID &system_id, const RID &world_id);
 	flecs::entity_t _get_type_id(const RID &type_id, const RID &world_id);
+	// Reference cursor walk that bypasses the cached access plans (fallback/benchmarks)
+	Dictionary _component_to_dict_with_cursor(const flecs::entity &entity, flecs::entity_t component_id);
 	FlecsScriptSystem _get_script_system(const RID &script_system_id, const RID &world_id);
 	void set_world_singleton_with_name(const RID &world_id, const String& comp_type, const Dictionary& comp_data);
 	void set_world_singleton_with_id(const RID &world_id, const RID &comp_type_id, const Dictionary& comp_data);
@@ -328,7 +471,7 @@ public:
 	void set_script_system_world(const RID &world_id, const RID &script_system_id, const RID &script_system_world_id);
 	RID get_script_system_world(const RID &world_id, const RID &script_system_id);
 	// Script system advanced controls
-	void set_script_system_dispatch_mode(const RID &world_id, const RID &script_system_id, int mode); // 0=per_entity,1=batch
+	void set_script_system_dispatch_mode(const RID &world_id, const RID &script_system_id, int mode); // 0=per_entity,1=batch,2=columnar
 	int get_script_system_dispatch_mode(const RID &world_id, const RID &script_system_id);
 	void set_script_system_change_only(const RID &world_id, const RID &script_system_id, bool change_only);
 	bool is_script_system_change_only(const RID &world_id, const RID &script_system_id);
@@ -345,7 +488,12 @@ public:
 	bool get_script_system_change_observe_add_and_set(const RID &world_id, const RID &script_system_id);
 	void set_script_system_auto_reset(const RID &world_id, const RID &script_system_id, bool auto_reset);
 	bool get_script_system_auto_reset(const RID &world_id, const RID &script_system_id);
+	// Frame summaries are recorded while at least one script system of the
+	// world has instrumentation enabled, into a FrameSummaryHistory ring
 	Dictionary get_world_frame_summary(const RID &world_id); // aggregated per-frame summary
+	Array get_world_frame_history(const RID &world_id, int max_frames = -1); // newest first
+	void set_world_frame_history_size(const RID &world_id, int frame_count);
+	int get_world_frame_history_size(const RID &world_id);
 	void reset_world_frame_summary(const RID &world_id);
 	Dictionary get_world_distribution_summary(const RID &world_id); // approximate aggregated distribution stats
 	Dictionary get_system_metrics(const RID &world_id); // returns per-system profiling metrics for EditorProfiler
@@ -356,6 +504,12 @@ public:
 	// Multi-threaded system control and batching behavior
 	void set_script_system_multi_threaded(const RID &world_id, const RID &script_system_id, bool enable);
 	bool get_script_system_multi_threaded(const RID &world_id, const RID &script_system_id);
+	// "Component.field" / "Component" paths rows are limited to; empty serializes everything
+	void set_script_system_projection(const RID &world_id, const RID &script_system_id, const PackedStringArray &paths);
+	PackedStringArray get_script_system_projection(const RID &world_id, const RID &script_system_id);
+	// Phase name batches are flushed in (change-only batches included); empty = PostUpdate
+	void set_script_system_flush_phase(const RID &world_id, const RID &script_system_id, const String &phase);
+	String get_script_system_flush_phase(const RID &world_id, const RID &script_system_id);
 	void set_script_system_batch_chunk_size(const RID &world_id, const RID &script_system_id, int chunk_size);
 	int get_script_system_batch_chunk_size(const RID &world_id, const RID &script_system_id);
 	void set_script_system_flush_min_interval_msec(const RID &world_id, const RID &script_system_id, double msec);
@@ -442,6 +596,12 @@ public:
 	Dictionary query_get_instrumentation_data(const RID &world_id, const RID &query_id);
 	void query_reset_instrumentation(const RID &world_id, const RID &query_id);
 
+	// Columnar field access: copies one component field for every entity matched
+	// by the query straight out of (or into) table storage as a packed array.
+	// Rows follow query_get_entities() order.
+	Variant get_component_field_column(const RID &world_id, const RID &query_id, const String &component_type, const String &field);
+	void set_component_field_column(const RID &world_id, const RID &query_id, const String &component_type, const String &field, const Variant &column);
+
 	// Cleanup
 	void free_query(const RID &world_id, const RID &query_id);
 
@@ -450,7 +610,13 @@ public:
 	RID _create_rid_for_query(const RID &world_id, const FlecsQuery &query);
 
 private:
-	struct RID_Owner_Wrapper {
+	/**
+	 * Everything a world hands out RIDs for. Heap-allocated once per world and
+	 * held by pointer, so growing world_registries moves a pointer instead of
+	 * rebuilding every entity, type, system and query RID. Not copyable: a
+	 * registry owns its RIDs and frees whatever is left when it is deleted.
+	 */
+	struct WorldRegistry {
 		RID world_id;
 		RID_Owner<FlecsEntityVariant, true> entity_owner;
 		RID_Owner<FlecsTypeIDVariant, true> type_id_owner;
@@ -458,118 +624,90 @@ private:
 		RID_Owner<FlecsScriptSystem, true> script_system_owner;
 		RID_Owner<FlecsQuery, true> query_owner;
 		HashMap<String, Ref<CommandHandler>> command_handlers;
-		// Reverse lookup map: Flecs entity ID -> Godot RID (for O(1) lookups)
-		HashMap<uint64_t, RID> entity_id_to_rid;
+		// Reverse lookup map: Flecs entity ID -> Godot RID (for O(1) lookups).
+		// Sharded so worker threads of multi-threaded systems can use it.
+		EntityRIDMap entity_id_to_rid;
 		// Reverse lookup map: Flecs type/component ID -> Godot RID. Type IDs are
 		// frequently resolved by name, so reusing RIDs prevents per-frame leaks.
 		HashMap<uint64_t, RID> type_id_to_rid;
-		RID_Owner_Wrapper() = default;
-		RID_Owner_Wrapper(RID p_world_id) : world_id(p_world_id),
+
+		explicit WorldRegistry(const RID &p_world_id) : world_id(p_world_id),
 			entity_owner(ENTITY_OWNER_CHUNK_SIZE, MAX_ENTITY_COUNT),
 			type_id_owner(TYPE_ID_OWNER_CHUNK_SIZE, MAX_TYPE_ID_COUNT),
 			system_owner(SYSTEM_OWNER_CHUNK_SIZE, MAX_SYSTEM_COUNT),
 			script_system_owner(SCRIPT_SYSTEM_OWNER_CHUNK_SIZE, MAX_SCRIPT_SYSTEM_COUNT),
 			query_owner(QUERY_OWNER_CHUNK_SIZE, MAX_QUERY_COUNT) {}
-		//fun hack to get around the lack of move semantics
-		// Ensure world_id is initialized before using it when rebuilding owners from another wrapper.
-		RID_Owner_Wrapper(const RID_Owner_Wrapper& other) {
-			// Initialize world_id first to ensure lookups use the correct world
-			world_id = other.world_id;
-			for (RID rid : other.entity_owner.get_owned_list()) {
-					flecs::entity e = FlecsServer::get_singleton()->_get_entity(rid, world_id);
-					RID new_rid = entity_owner.make_rid(FlecsEntityVariant(e));
-					if (e.is_valid()) {
-						entity_id_to_rid[e.id()] = new_rid;
-					}
-			}
-			LocalVector<RID> other_type_ids = other.type_id_owner.get_owned_list();
-
-			for (RID rid : other_type_ids) {
-				flecs::entity_t type_id = FlecsServer::get_singleton()->_get_type_id(rid, world_id);
-				RID new_rid = type_id_owner.make_rid(FlecsTypeIDVariant(type_id));
-				if (type_id != 0 && new_rid.is_valid()) {
-					type_id_to_rid[type_id] = new_rid;
-				}
-			}
-
-			LocalVector<RID> other_system_ids = other.system_owner.get_owned_list();
-
-			for (RID rid : other_system_ids) {
-				system_owner.make_rid(FlecsSystemVariant(FlecsServer::get_singleton()->_get_system(rid, world_id)));
-			}
-
-			LocalVector<RID> other_script_ids = other.script_system_owner.get_owned_list();
-			for (RID rid : other_script_ids) {
-				script_system_owner.make_rid(FlecsScriptSystem(FlecsServer::get_singleton()->_get_script_system(rid, world_id)));
-			}
-
-			LocalVector<RID> other_query_ids = other.query_owner.get_owned_list();
-			for (RID rid : other_query_ids) {
-				query_owner.make_rid(FlecsQuery(FlecsServer::get_singleton()->_get_query(rid, world_id)));
-			}
-
-			command_handlers = other.command_handlers;
+		WorldRegistry(const WorldRegistry &) = delete;
+		WorldRegistry &operator=(const WorldRegistry &) = delete;
+		~WorldRegistry() {
+			_free_all(entity_owner);
+			_free_all(type_id_owner);
+			_free_all(system_owner);
+			_free_all(script_system_owner);
+			_free_all(query_owner);
 		}
-		RID_Owner_Wrapper operator=(const RID_Owner_Wrapper& other) {
-			if (this != &other) {
-				world_id = other.world_id;
-				for(RID rid : other.type_id_owner.get_owned_list()) {
-					FlecsServer::get_singleton()->free_type_id(world_id, rid);
-				}
-				for (RID rid : other.system_owner.get_owned_list()) {
-					FlecsServer::get_singleton()->free_system(world_id, rid, true);
-				}
-				for (RID rid : other.script_system_owner.get_owned_list()) {
-					FlecsServer::get_singleton()->free_script_system(world_id, rid);
-				}
-
-				for (RID rid : other.entity_owner.get_owned_list()) {
-					flecs::entity e = get_singleton()->_get_entity(rid, world_id);
-					RID new_rid = entity_owner.make_rid(FlecsEntityVariant(e));
-					if (e.is_valid()) {
-						entity_id_to_rid[e.id()] = new_rid;
-					}
-				}
-
-				for (RID rid : other.type_id_owner.get_owned_list()) {
-					flecs::entity_t type_id = get_singleton()->_get_type_id(rid, world_id);
-					RID new_rid = type_id_owner.make_rid(FlecsTypeIDVariant(type_id));
-					if (type_id != 0 && new_rid.is_valid()) {
-						type_id_to_rid[type_id] = new_rid;
-					}
-				}
-
-				for (RID rid : other.system_owner.get_owned_list()) {
-					system_owner.make_rid(FlecsSystemVariant(get_singleton()->_get_system(rid, world_id)));
-				}
-
-				for (RID rid : other.script_system_owner.get_owned_list()) {
-					script_system_owner.make_rid(FlecsScriptSystem(get_singleton()->_get_script_system(rid, world_id)));
-				}
-
-				for (RID rid : other.query_owner.get_owned_list()) {
-					query_owner.make_rid(FlecsQuery(get_singleton()->_get_query(rid, world_id)));
-				}
 
+	private:
+		template <typename T>
+		static void _free_all(RID_Owner<T, true> &p_owner) {
+			for (const RID &rid : p_owner.get_owned_list()) {
+				p_owner.free(rid);
 			}
-			command_handlers = other.command_handlers;
-			return *this;
 		}
 	};
 
 	RID_Owner<FlecsWorldVariant, true> flecs_world_owners = RID_Owner<FlecsWorldVariant, true>(WORLD_OWNER_CHUNK_SIZE, MAX_WORLD_COUNT);
 	Vector<RID> worlds;
-	AHashMap<RID,RID_Owner_Wrapper> flecs_variant_owners = AHashMap<RID,RID_Owner_Wrapper>(MAX_WORLD_COUNT);
+	AHashMap<RID, WorldRegistry*> world_registries = AHashMap<RID, WorldRegistry*>(MAX_WORLD_COUNT);
 	Ref<CommandHandler> render_system_command_handler;
 	AHashMap<RID, PipelineManager> pipeline_managers = AHashMap<RID, PipelineManager>(MAX_WORLD_COUNT);
 	Callable command_handler_callback;
 	AHashMap<RID, NodeStorage*> node_storages = AHashMap<RID, NodeStorage*>(MAX_WORLD_COUNT);
 	AHashMap<RID, RefStorage*> ref_storages = AHashMap<RID, RefStorage*>(MAX_WORLD_COUNT);
-	AHashMap<RID, Dictionary> last_frame_summaries = AHashMap<RID, Dictionary>(MAX_WORLD_COUNT);
+	AHashMap<RID, FrameSummaryHistory*> frame_histories = AHashMap<RID, FrameSummaryHistory*>(MAX_WORLD_COUNT);
+	AHashMap<RID, FixedTimestep*> fixed_timesteps = AHashMap<RID, FixedTimestep*>(MAX_WORLD_COUNT);
+	AHashMap<RID, WorldWriteBatch*> write_batches = AHashMap<RID, WorldWriteBatch*>(MAX_WORLD_COUNT);
+	AHashMap<RID, EntityPoolMap*> entity_pools = AHashMap<RID, EntityPoolMap*>(MAX_WORLD_COUNT);
+	// Fork world -> world it was forked from
+	AHashMap<RID, RID> world_forks = AHashMap<RID, RID>(MAX_WORLD_COUNT);
+
+	// Global entity RID -> owning world index. RID validators come from a
+	// process-wide counter, so a live RID maps to exactly one world, and
+	// entries are erased on free so a recycled RID slot never resolves to the
+	// wrong world. Sharded, as multi-threaded systems make RIDs from workers.
+	EntityWorldIndex entity_world_index;
+
+	// World slots for dense entity handles. A slot's generation is bumped each
+	// time it is handed to a new world, so handles of a freed world go stale.
+	struct EntityHandleSlot {
+		RID world_id;
+		uint32_t generation = 0;
+		EntityHandleMode mode = ENTITY_HANDLE_RID;
+	};
+	EntityHandleSlot entity_handle_slots[MAX_WORLD_COUNT];
+	AHashMap<RID, uint32_t> world_handle_slots = AHashMap<RID, uint32_t>(MAX_WORLD_COUNT);
+
+	RID _make_entity_rid(const RID &world_id, const flecs::entity &entity);
+	bool _is_dense_world(const RID &world_id) const;
+
+	// Resolves entity/component for a batch_* call; returns null on error
+	WorldWriteBatch *_get_write_batch_target(const RID &entity_id, const StringName &component_type, const char *func_name, flecs::entity_t &r_entity, flecs::entity_t &r_component);
+	int _apply_write_batch(flecs::world &world, WorldWriteBatch &batch);
+	// Looks up a pipeline phase by name, also under flecs::pipeline; 0 when unknown
+	static flecs::entity_t _lookup_phase(flecs::world &world, const String &phase);
+	// True when the world has script systems, runner systems or script observers
+	bool _world_runs_scripts(const RID &world_id, flecs::world &world);
+	// One frame of a world, without the parts that touch shared server state
+	bool _progress_world_frame(const RID &world_id, flecs::world &world, const double delta);
+	// Runs the commands queued on the world's registered handlers; called on
+	// the progressing thread once the frame is over
+	void _process_command_handlers(const RID &world_id);
+	void _record_frame_summary(const RID &world_id, const flecs::world &world, const double delta, FrameSummaryHistory &history);
 
 };
 
 VARIANT_ENUM_CAST(FlecsServer::DispatchMode);
+VARIANT_ENUM_CAST(FlecsServer::EntityHandleMode);
 
 class ScriptSystemInspector : public Resource {
 	GDCLASS(ScriptSystemInspector, Resource);
@@ -114,6 +114,33 @@ struct FlecsEntityVariant {
     }
 };
 
+/**
+ * @struct FlecsEntityRef
+ * @brief Entity resolved from either an owned RID or a dense entity handle
+ * 
+ * Stands in for the FlecsEntityVariant* returned by RID_Owner::get_or_null():
+ * it tests false when the handle did not resolve and forwards -> to the
+ * wrapped variant, so call sites read the same for both handle kinds.
+ * 
+ * @see FlecsServer::_resolve_entity, FlecsEntityHandle
+ */
+struct FlecsEntityRef {
+    FlecsEntityVariant variant{ flecs::entity() }; ///< Resolved entity (null entity when invalid)
+    bool valid = false; ///< Whether the handle resolved
+
+    explicit operator bool() const {
+        return valid;
+    }
+
+    FlecsEntityVariant* operator->() {
+        return &variant;
+    }
+
+    const FlecsEntityVariant* operator->() const {
+        return &variant;
+    }
+};
+
 /**
  * @struct FlecsSystemVariant
  * @brief Wrapper for flecs::system to enable RID storage
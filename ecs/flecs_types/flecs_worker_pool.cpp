@@ -0,0 +1,228 @@
+#include "modules/godot_turbo/ecs/flecs_types/flecs_worker_pool.h"
+
+#include "core/os/memory.h"
+
+FlecsWorkerPool *FlecsWorkerPool::singleton = nullptr;
+ecs_os_api_task_new_t FlecsWorkerPool::previous_task_new = nullptr;
+ecs_os_api_task_join_t FlecsWorkerPool::previous_task_join = nullptr;
+
+void FlecsWorkerPool::install(uint32_t p_thread_count) {
+	if (singleton) {
+		return;
+	}
+	// The platform hooks are normally set by the first ecs_init(), and
+	// ecs_os_set_api() is a no-op once an API is in place. Setting them now
+	// keeps them from replacing the task hooks later on.
+#ifdef FLECS_OS_API_IMPL
+	ecs_set_os_api_impl();
+#else
+	ecs_os_set_api_defaults();
+#endif
+
+	singleton = memnew(FlecsWorkerPool);
+	singleton->set_thread_count(p_thread_count);
+
+	previous_task_new = ecs_os_api.task_new_;
+	previous_task_join = ecs_os_api.task_join_;
+	ecs_os_api.task_new_ = _task_new;
+	ecs_os_api.task_join_ = _task_join;
+}
+
+void FlecsWorkerPool::uninstall() {
+	if (!singleton) {
+		return;
+	}
+	ecs_os_api.task_new_ = previous_task_new;
+	ecs_os_api.task_join_ = previous_task_join;
+	memdelete(singleton);
+	singleton = nullptr;
+}
+
+FlecsWorkerPool::~FlecsWorkerPool() {
+	LocalVector<Worker *> all;
+	{
+		MutexLock lock(mutex);
+		exiting = true;
+		for (Worker *worker : workers) {
+			all.push_back(worker);
+		}
+		for (Worker *worker : retired) {
+			all.push_back(worker);
+		}
+		retired.clear();
+	}
+	wake.notify_all();
+
+	for (Worker *worker : all) {
+		ecs_os_thread_join(worker->thread);
+		memdelete(worker);
+	}
+	for (Task *task : free_tasks) {
+		memdelete(task);
+	}
+}
+
+void FlecsWorkerPool::set_thread_count(uint32_t p_count) {
+	{
+		MutexLock lock(mutex);
+		thread_count = p_count;
+		while (workers.size() < thread_count) {
+			_spawn_worker();
+		}
+	}
+	// Idle threads above the new budget retire
+	wake.notify_all();
+	_join_retired();
+}
+
+uint32_t FlecsWorkerPool::get_thread_count() const {
+	MutexLock lock(mutex);
+	return thread_count;
+}
+
+uint32_t FlecsWorkerPool::get_live_thread_count() const {
+	MutexLock lock(mutex);
+	return workers.size();
+}
+
+uint64_t FlecsWorkerPool::get_overflow_count() const {
+	MutexLock lock(mutex);
+	return overflow_count;
+}
+
+ecs_os_thread_t FlecsWorkerPool::start(ecs_os_thread_callback_t p_callback, void *p_arg) {
+	Task *task = nullptr;
+	{
+		MutexLock lock(mutex);
+		if (free_tasks.is_empty()) {
+			task = memnew(Task);
+		} else {
+			task = free_tasks[free_tasks.size() - 1];
+			free_tasks.resize(free_tasks.size() - 1);
+		}
+		task->callback = p_callback;
+		task->arg = p_arg;
+		task->result = nullptr;
+		task->next = nullptr;
+		if (pending_tail) {
+			pending_tail->next = task;
+		} else {
+			pending_head = task;
+		}
+		pending_tail = task;
+		pending_count++;
+
+		// Grow up to the budget; past it the task waits for the next free worker
+		if (pending_count > idle_count) {
+			if (workers.size() < thread_count) {
+				_spawn_worker();
+			} else {
+				overflow_count++;
+			}
+		}
+	}
+	wake.notify_one();
+	_join_retired();
+	return reinterpret_cast<ecs_os_thread_t>(task);
+}
+
+void *FlecsWorkerPool::join(ecs_os_thread_t p_task) {
+	Task *task = reinterpret_cast<Task *>(p_task);
+	// Help with the queue instead of blocking a thread the queue may need
+	while (!task->done.try_wait()) {
+		Task *other = nullptr;
+		{
+			MutexLock lock(mutex);
+			other = _pop_pending();
+		}
+		if (!other) {
+			// The task is running on another thread
+			task->done.wait();
+			break;
+		}
+		other->result = other->callback(other->arg);
+		other->done.post();
+	}
+	void *result = task->result;
+
+	MutexLock lock(mutex);
+	free_tasks.push_back(task);
+	return result;
+}
+
+void FlecsWorkerPool::_spawn_worker() {
+	// Called with the mutex held: the new thread cannot look at its handle
+	// before it is assigned
+	Worker *worker = memnew(Worker);
+	worker->pool = this;
+	workers.push_back(worker);
+	worker->thread = ecs_os_thread_new(_worker_main, worker);
+}
+
+void FlecsWorkerPool::_join_retired() {
+	LocalVector<Worker *> to_join;
+	{
+		MutexLock lock(mutex);
+		if (retired.is_empty()) {
+			return;
+		}
+		to_join = retired;
+		retired.clear();
+	}
+	for (Worker *worker : to_join) {
+		ecs_os_thread_join(worker->thread);
+		memdelete(worker);
+	}
+}
+
+FlecsWorkerPool::Task *FlecsWorkerPool::_pop_pending() {
+	Task *task = pending_head;
+	if (task) {
+		pending_head = task->next;
+		if (!pending_head) {
+			pending_tail = nullptr;
+		}
+		pending_count--;
+	}
+	return task;
+}
+
+void FlecsWorkerPool::_run(Worker *p_worker) {
+	while (true) {
+		Task *task = nullptr;
+		{
+			MutexLock lock(mutex);
+			while (!pending_head && !exiting && workers.size() <= thread_count) {
+				idle_count++;
+				wake.wait(lock);
+				idle_count--;
+			}
+			if (!pending_head) {
+				workers.erase(p_worker);
+				if (!exiting) {
+					retired.push_back(p_worker);
+				}
+				return;
+			}
+			task = _pop_pending();
+		}
+
+		task->result = task->callback(task->arg);
+		// The joiner recycles the task as soon as it wakes up
+		task->done.post();
+	}
+}
+
+void *FlecsWorkerPool::_worker_main(void *p_worker) {
+	Worker *worker = static_cast<Worker *>(p_worker);
+	worker->pool->_run(worker);
+	return nullptr;
+}
+
+ecs_os_thread_t FlecsWorkerPool::_task_new(ecs_os_thread_callback_t p_callback, void *p_arg) {
+	return singleton->start(p_callback, p_arg);
+}
+
+void *FlecsWorkerPool::_task_join(ecs_os_thread_t p_task) {
+	return singleton->join(p_task);
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "core/os/condition_variable.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/templates/local_vector.h"
+#include "modules/godot_turbo/thirdparty/flecs/distr/flecs.h"
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @class FlecsWorkerPool
+ * @brief Worker threads shared by every Flecs world of the server
+ *
+ * Worlds run their multi-threaded systems on Flecs task threads (see
+ * ecs_set_task_threads()): every frame, each extra stage is started as a task
+ * and joined when the frame ends. install() routes the Flecs task hooks of the
+ * OS API to this pool, so all worlds draw from one set of threads instead of
+ * each world keeping hardware_concurrency threads of its own.
+ *
+ * The pool never runs more than get_thread_count() threads. When every worker
+ * is busy, start() queues the task on one shared FIFO. A stage task runs one
+ * pipeline operation for its stage and returns without waiting on the other
+ * stages, so queued tasks always drain. join() runs queued tasks itself while
+ * it waits, so a world progressed on a pool thread (see progress_worlds())
+ * still gets its stages run when every worker is busy.
+ *
+ * Pool threads are created through ecs_os_thread_new(), so they go through
+ * whatever thread hooks are installed (the traced OS API included).
+ */
+class FlecsWorkerPool {
+public:
+	static FlecsWorkerPool *get_singleton() { return singleton; }
+
+	/**
+	 * @brief Create the pool and take over the Flecs task hooks
+	 *
+	 * Must run before the first world is created; uninstall() restores the
+	 * previous hooks and stops every thread.
+	 */
+	static void install(uint32_t p_thread_count);
+	static void uninstall();
+
+	void set_thread_count(uint32_t p_count);
+	uint32_t get_thread_count() const;
+
+	// Threads currently alive; above get_thread_count() only while extra ones retire
+	uint32_t get_live_thread_count() const;
+	// Number of tasks that were queued because every worker was busy
+	uint64_t get_overflow_count() const;
+
+	ecs_os_thread_t start(ecs_os_thread_callback_t p_callback, void *p_arg);
+	void *join(ecs_os_thread_t p_task);
+
+	/**
+	 * @brief Call @p p_func(i) for every i in [0, p_count), return when all are done
+	 *
+	 * The calling thread and up to get_thread_count() pool tasks claim indices
+	 * one at a time, so uneven items balance out across threads.
+	 */
+	template <typename F>
+	void parallel_for(uint32_t p_count, F &&p_func);
+
+private:
+	struct Task {
+		ecs_os_thread_callback_t callback = nullptr;
+		void *arg = nullptr;
+		void *result = nullptr;
+		Task *next = nullptr;
+		Semaphore done;
+	};
+
+	struct Worker {
+		FlecsWorkerPool *pool = nullptr;
+		ecs_os_thread_t thread = 0;
+	};
+
+	static FlecsWorkerPool *singleton;
+	static ecs_os_api_task_new_t previous_task_new;
+	static ecs_os_api_task_join_t previous_task_join;
+
+	mutable BinaryMutex mutex;
+	ConditionVariable wake;
+	Task *pending_head = nullptr;
+	Task *pending_tail = nullptr;
+	uint32_t pending_count = 0;
+	LocalVector<Task *> free_tasks;
+	LocalVector<Worker *> workers;
+	LocalVector<Worker *> retired;
+	uint32_t thread_count = 0;
+	uint32_t idle_count = 0;
+	uint64_t overflow_count = 0;
+	bool exiting = false;
+
+	FlecsWorkerPool() = default;
+	~FlecsWorkerPool();
+
+	void _spawn_worker();
+	void _join_retired();
+	// Pops the oldest pending task; called with the mutex held
+	Task *_pop_pending();
+	void _run(Worker *p_worker);
+
+	static void *_worker_main(void *p_worker);
+	static ecs_os_thread_t _task_new(ecs_os_thread_callback_t p_callback, void *p_arg);
+	static void *_task_join(ecs_os_thread_t p_task);
+};
+
+template <typename F>
+void FlecsWorkerPool::parallel_for(uint32_t p_count, F &&p_func) {
+	struct Shared {
+		std::remove_reference_t<F> *func = nullptr;
+		std::atomic<uint32_t> next{ 0 };
+		uint32_t count = 0;
+	};
+	Shared shared;
+	shared.func = &p_func;
+	shared.count = p_count;
+
+	ecs_os_thread_callback_t drain = [](void *p_shared) -> void * {
+		Shared *s = static_cast<Shared *>(p_shared);
+		for (uint32_t i = s->next.fetch_add(1); i < s->count; i = s->next.fetch_add(1)) {
+			(*s->func)(i);
+		}
+		return nullptr;
+	};
+
+	const uint32_t helper_count = p_count > 1 ? MIN(get_thread_count(), p_count - 1) : 0;
+	LocalVector<ecs_os_thread_t> helpers;
+	helpers.resize(helper_count);
+	for (uint32_t i = 0; i < helper_count; i++) {
+		helpers[i] = start(drain, &shared);
+	}
+	drain(&shared);
+	for (ecs_os_thread_t helper : helpers) {
+		join(helper);
+	}
+}
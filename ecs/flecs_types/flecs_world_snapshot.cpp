@@ -0,0 +1,774 @@
+#include "modules/godot_turbo/ecs/flecs_types/flecs_world_snapshot.h"
+
+#include "core/io/marshalls.h"
+#include "core/templates/hash_map.h"
+#include <cstring>
+
+namespace FlecsWorldSnapshot {
+
+static constexpr uint32_t SNAPSHOT_MAGIC = 0x53575447; // "GTWS"
+static constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+// How an id referenced by a table type is stored
+enum RefKind : uint8_t {
+	REF_NONE, // Second half of a plain (non pair) id
+	REF_PATH, // Named entity, stored as an index into the path table
+	REF_ENTITY, // Unnamed or state entity, stored as its full id
+	REF_LITERAL, // Pair target that is not an entity
+};
+
+// ----------------------------------------------------------------------------
+// Buffers
+// ----------------------------------------------------------------------------
+
+struct Writer {
+	LocalVector<uint8_t> data;
+
+	void put_u8(uint8_t p_value) { data.push_back(p_value); }
+	void put_u32(uint32_t p_value) { put_bytes(&p_value, sizeof(p_value)); }
+	void put_u64(uint64_t p_value) { put_bytes(&p_value, sizeof(p_value)); }
+	void put_bytes(const void *p_src, int64_t p_size) {
+		const uint32_t at = data.size();
+		data.resize(at + p_size);
+		memcpy(data.ptr() + at, p_src, p_size);
+	}
+	void put_string(const String &p_string) {
+		const CharString utf8 = p_string.utf8();
+		put_u32(utf8.length());
+		put_bytes(utf8.get_data(), utf8.length());
+	}
+	void put_variant(const Variant &p_value) {
+		int len = 0;
+		encode_variant(p_value, nullptr, len);
+		put_u32(len);
+		const uint32_t at = data.size();
+		data.resize(at + len);
+		encode_variant(p_value, data.ptr() + at, len);
+	}
+	// Reserves a u64 to be filled in once the size of what follows is known
+	uint32_t begin_block() {
+		put_u64(0);
+		return data.size();
+	}
+	void end_block(uint32_t p_start) {
+		const uint64_t size = data.size() - p_start;
+		memcpy(data.ptr() + p_start - sizeof(uint64_t), &size, sizeof(size));
+	}
+};
+
+struct Reader {
+	const uint8_t *data = nullptr;
+	int64_t size = 0;
+	int64_t pos = 0;
+	bool failed = false;
+
+	bool has(int64_t p_size) {
+		if (failed || p_size < 0 || pos + p_size > size) {
+			failed = true;
+			return false;
+		}
+		return true;
+	}
+	template <typename T>
+	T get() {
+		T value = 0;
+		if (has(sizeof(T))) {
+			memcpy(&value, data + pos, sizeof(T));
+			pos += sizeof(T);
+		}
+		return value;
+	}
+	const uint8_t *get_bytes(int64_t p_size) {
+		if (!has(p_size)) {
+			return nullptr;
+		}
+		const uint8_t *ptr = data + pos;
+		pos += p_size;
+		return ptr;
+	}
+	String get_string() {
+		const uint32_t len = get<uint32_t>();
+		const uint8_t *bytes = get_bytes(len);
+		return bytes ? String::utf8(reinterpret_cast<const char *>(bytes), len) : String();
+	}
+	Variant get_variant() {
+		const uint32_t len = get<uint32_t>();
+		const uint8_t *bytes = get_bytes(len);
+		Variant value;
+		if (bytes && decode_variant(value, bytes, len) != OK) {
+			failed = true;
+		}
+		return value;
+	}
+};
+
+// ----------------------------------------------------------------------------
+// Entity classification
+// ----------------------------------------------------------------------------
+
+static bool _is_schema_entity(const ecs_world_t *p_world, flecs::entity_t p_entity) {
+	return ecs_has_id(p_world, p_entity, ecs_id(EcsComponent)) ||
+			ecs_has_id(p_world, p_entity, EcsModule) ||
+			ecs_has_id(p_world, p_entity, EcsPhase) ||
+			ecs_has_id(p_world, p_entity, ecs_id(EcsPipeline)) ||
+			// Systems, observers and named queries
+			ecs_has_id(p_world, p_entity, ecs_pair(ecs_id(EcsPoly), EcsWildcard));
+}
+
+bool is_state_entity(const flecs::world &p_world, flecs::entity_t p_entity) {
+	const ecs_world_t *world = p_world.c_ptr();
+	if (p_entity < EcsFirstUserEntityId || !ecs_is_alive(world, p_entity) || _is_schema_entity(world, p_entity)) {
+		return false;
+	}
+	// Scopes that hold components or systems are part of the schema too
+	bool has_schema_child = false;
+	flecs::entity(world, p_entity).children([&](flecs::entity p_child) {
+		if (!has_schema_child && !is_state_entity(p_world, p_child.id())) {
+			has_schema_child = true;
+		}
+	});
+	return !has_schema_child;
+}
+
+// Unlike ECS_IS_PAIR, also true for pairs that carry other id flags
+static bool _is_pair(flecs::id_t p_id) {
+	return (p_id & ECS_PAIR) != 0;
+}
+
+static bool _skip_id(flecs::id_t p_id) {
+	// Names are stored per row instead of as (Identifier, *) pairs
+	return _is_pair(p_id) && ECS_PAIR_FIRST(p_id) == EcsIdentifier;
+}
+
+static bool _is_trivially_copyable(const ecs_type_info_t *p_info) {
+	return !p_info->hooks.copy && !p_info->hooks.move && !p_info->hooks.dtor;
+}
+
+// ----------------------------------------------------------------------------
+// Member encoding
+// ----------------------------------------------------------------------------
+
+static uint32_t _count_members(const FlecsReflection::AccessPlan &p_plan) {
+	uint32_t count = 0;
+	for (const FlecsReflection::MemberAccess &member : p_plan.members) {
+		count += member.nested ? _count_members(*member.nested) : 1;
+	}
+	return count;
+}
+
+static void _encode_members(Writer &p_writer, const FlecsReflection::AccessPlan &p_plan, const uint8_t *p_data) {
+	for (const FlecsReflection::MemberAccess &member : p_plan.members) {
+		const uint8_t *field = p_data + member.offset;
+		if (member.nested) {
+			_encode_members(p_writer, *member.nested, field);
+		} else {
+			p_writer.put_variant(member.read ? member.read(field) : Variant());
+		}
+	}
+}
+
+static void _skip_members(Reader &p_reader, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		p_reader.get_bytes(p_reader.get<uint32_t>());
+	}
+}
+
+static void _decode_members(Reader &p_reader, const FlecsReflection::AccessPlan &p_plan, uint8_t *p_data) {
+	for (const FlecsReflection::MemberAccess &member : p_plan.members) {
+		uint8_t *field = p_data + member.offset;
+		if (member.nested) {
+			_decode_members(p_reader, *member.nested, field);
+			continue;
+		}
+		const Variant value = p_reader.get_variant();
+		if (member.write && value.get_type() != Variant::NIL) {
+			member.write(field, value);
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------
+// Save
+// ----------------------------------------------------------------------------
+
+struct SnapshotRow {
+	int32_t row = 0;
+	flecs::entity_t entity = 0;
+
+	bool operator<(const SnapshotRow &p_other) const { return row < p_other.row; }
+};
+
+struct SnapshotTable {
+	ecs_table_t *table = nullptr;
+	LocalVector<SnapshotRow> rows;
+};
+
+struct PathTable {
+	HashMap<flecs::entity_t, uint32_t> indices;
+	LocalVector<String> paths;
+
+	uint32_t get_index(const flecs::world &p_world, flecs::entity_t p_entity) {
+		if (const uint32_t *index = indices.getptr(p_entity)) {
+			return *index;
+		}
+		const uint32_t index = paths.size();
+		paths.push_back(String::utf8(flecs::entity(p_world.c_ptr(), p_entity).path().c_str()));
+		indices.insert(p_entity, index);
+		return index;
+	}
+};
+
+static void _write_ref(Writer &p_writer, PathTable &p_paths, const flecs::world &p_world, flecs::entity_t p_entity, bool p_is_state) {
+	if (p_is_state || !ecs_get_name(p_world.c_ptr(), p_entity)) {
+		p_writer.put_u8(REF_ENTITY);
+		p_writer.put_u64(p_entity);
+		return;
+	}
+	p_writer.put_u8(REF_PATH);
+	p_writer.put_u32(p_paths.get_index(p_world, p_entity));
+}
+
+PackedByteArray save(flecs::world &p_world) {
+	ecs_world_t *world = p_world.c_ptr();
+
+	// Group state entities by the table they live in
+	HashMap<ecs_table_t *, uint32_t> table_indices;
+	LocalVector<SnapshotTable> tables;
+	HashSet<flecs::entity_t> state_entities;
+	const ecs_entities_t all = ecs_get_entities(world);
+	for (int32_t i = 0; i < all.alive_count; i++) {
+		const flecs::entity_t entity = all.ids[i];
+		if (!is_state_entity(p_world, entity)) {
+			continue;
+		}
+		const ecs_record_t *record = ecs_record_find(world, entity);
+		if (!record || !record->table) {
+			continue;
+		}
+		uint32_t index = 0;
+		if (const uint32_t *existing = table_indices.getptr(record->table)) {
+			index = *existing;
+		} else {
+			index = tables.size();
+			table_indices.insert(record->table, index);
+			SnapshotTable table;
+			table.table = record->table;
+			tables.push_back(table);
+		}
+		SnapshotRow row;
+		row.row = ECS_RECORD_TO_ROW(record->row);
+		row.entity = entity;
+		tables[index].rows.push_back(row);
+		state_entities.insert(entity);
+	}
+
+	Writer body;
+	PathTable paths;
+	body.put_u32(tables.size());
+	for (SnapshotTable &snapshot_table : tables) {
+		ecs_table_t *table = snapshot_table.table;
+		LocalVector<SnapshotRow> &rows = snapshot_table.rows;
+		rows.sort();
+
+		body.put_u32(rows.size());
+		for (const SnapshotRow &row : rows) {
+			body.put_u64(row.entity);
+		}
+
+		LocalVector<uint32_t> named_rows;
+		for (uint32_t i = 0; i < rows.size(); i++) {
+			if (ecs_get_name(world, rows[i].entity)) {
+				named_rows.push_back(i);
+			}
+		}
+		body.put_u32(named_rows.size());
+		for (uint32_t i : named_rows) {
+			body.put_u32(i);
+			body.put_string(String::utf8(ecs_get_name(world, rows[i].entity)));
+		}
+
+		// Type, minus the ids that are restored some other way
+		const ecs_type_t *type = ecs_table_get_type(table);
+		LocalVector<flecs::id_t> ids;
+		for (int32_t i = 0; i < type->count; i++) {
+			if (!_skip_id(type->array[i])) {
+				ids.push_back(type->array[i]);
+			}
+		}
+		body.put_u32(ids.size());
+		for (flecs::id_t id : ids) {
+			if (_is_pair(id)) {
+				body.put_u64(id & ECS_ID_FLAGS_MASK);
+				const flecs::entity_t first = ecs_pair_first(world, id);
+				const flecs::entity_t second = ecs_pair_second(world, id);
+				_write_ref(body, paths, p_world, first, state_entities.has(first));
+				if (second) {
+					_write_ref(body, paths, p_world, second, state_entities.has(second));
+				} else {
+					body.put_u8(REF_LITERAL);
+					body.put_u64(ECS_PAIR_SECOND(id));
+				}
+			} else {
+				const flecs::entity_t entity = id & ECS_COMPONENT_MASK;
+				body.put_u64(id & ECS_ID_FLAGS_MASK);
+				_write_ref(body, paths, p_world, entity, state_entities.has(entity));
+				body.put_u8(REF_NONE);
+			}
+		}
+
+		// Component data
+		LocalVector<uint32_t> data_ids;
+		for (uint32_t i = 0; i < ids.size(); i++) {
+			if (ecs_table_get_column_index(world, table, ids[i]) >= 0) {
+				data_ids.push_back(i);
+			}
+		}
+		body.put_u32(data_ids.size());
+		for (uint32_t id_index : data_ids) {
+			const flecs::id_t id = ids[id_index];
+			const ecs_type_info_t *info = ecs_get_type_info(world, id);
+			const int32_t column = ecs_table_get_column_index(world, table, id);
+			const uint8_t *base = static_cast<const uint8_t *>(ecs_table_get_column(table, column, 0));
+			const int32_t size = info->size;
+
+			body.put_u32(id_index);
+			body.put_u32(size);
+			if (_is_trivially_copyable(info)) {
+				body.put_u8(ENCODING_RAW);
+				body.put_u32(0);
+				const uint32_t block = body.begin_block();
+				uint32_t i = 0;
+				while (i < rows.size()) {
+					uint32_t run = 1;
+					while (i + run < rows.size() && rows[i + run].row == rows[i].row + int32_t(run)) {
+						run++;
+					}
+					body.put_bytes(base + int64_t(rows[i].row) * size, int64_t(run) * size);
+					i += run;
+				}
+				body.end_block(block);
+				continue;
+			}
+
+			const std::shared_ptr<const FlecsReflection::AccessPlan> plan = FlecsReflection::AccessPlanCache::get().get_plan(p_world, ecs_get_typeid(world, id));
+			if (!plan) {
+				// Written without data: the component comes back default constructed
+				WARN_PRINT(vformat("FlecsWorldSnapshot: '%s' owns memory and has no reflection data, its values are not saved", String(flecs::entity(world, id).str().c_str())));
+				body.put_u8(ENCODING_MEMBERS);
+				body.put_u32(UINT32_MAX);
+				body.end_block(body.begin_block());
+				continue;
+			}
+			body.put_u8(ENCODING_MEMBERS);
+			body.put_u32(_count_members(*plan));
+			const uint32_t block = body.begin_block();
+			for (const SnapshotRow &row : rows) {
+				_encode_members(body, *plan, base + int64_t(row.row) * size);
+			}
+			body.end_block(block);
+		}
+	}
+
+	Writer header;
+	header.put_u32(SNAPSHOT_MAGIC);
+	header.put_u32(SNAPSHOT_VERSION);
+	header.put_u32(paths.paths.size());
+	for (const String &path : paths.paths) {
+		header.put_string(path);
+	}
+
+	PackedByteArray bytes;
+	bytes.resize(header.data.size() + body.data.size());
+	uint8_t *w = bytes.ptrw();
+	memcpy(w, header.data.ptr(), header.data.size());
+	memcpy(w + header.data.size(), body.data.ptr(), body.data.size());
+	return bytes;
+}
+
+// ----------------------------------------------------------------------------
+// Restore
+// ----------------------------------------------------------------------------
+
+// A plain user entity: no id flags and an index past the builtin range
+static bool _is_user_entity(flecs::entity_t p_entity) {
+	return (p_entity & ~(ECS_ENTITY_MASK | ECS_GENERATION_MASK)) == 0 && (p_entity & ECS_ENTITY_MASK) >= EcsFirstUserEntityId;
+}
+
+static bool _read_ref(Reader &p_reader, const LocalVector<flecs::entity_t> &p_paths, LocalVector<flecs::entity_t> &r_referenced, flecs::entity_t &r_entity, uint8_t &r_kind, String &r_error) {
+	const uint8_t kind = p_reader.get<uint8_t>();
+	r_kind = kind;
+	switch (kind) {
+		case REF_PATH: {
+			const uint32_t index = p_reader.get<uint32_t>();
+			if (index >= p_paths.size()) {
+				r_error = "path index out of range";
+				return false;
+			}
+			r_entity = p_paths[index];
+			return true;
+		}
+		case REF_ENTITY:
+			r_entity = p_reader.get<uint64_t>();
+			if (!p_reader.failed && !_is_user_entity(r_entity)) {
+				r_error = vformat("invalid entity id %d in a table type", int64_t(r_entity));
+				return false;
+			}
+			r_referenced.push_back(r_entity);
+			return true;
+		case REF_LITERAL:
+			r_entity = p_reader.get<uint64_t>();
+			if (!p_reader.failed && (r_entity == 0 || (r_entity & ~ECS_ENTITY_MASK) != 0)) {
+				r_error = vformat("invalid pair target %d in a table type", int64_t(r_entity));
+				return false;
+			}
+			return true;
+		case REF_NONE:
+			r_entity = 0;
+			return true;
+		default:
+			r_error = "invalid id reference";
+			return false;
+	}
+}
+
+bool Restore::parse(flecs::world &p_world, const PackedByteArray &p_snapshot, String &r_error) {
+	ecs_world_t *world = p_world.c_ptr();
+	snapshot = p_snapshot;
+	tables.clear();
+	entities.clear();
+	entity_set.clear();
+
+	Reader reader;
+	reader.data = snapshot.ptr();
+	reader.size = snapshot.size();
+	if (reader.get<uint32_t>() != SNAPSHOT_MAGIC || reader.get<uint32_t>() != SNAPSHOT_VERSION) {
+		r_error = "not a world snapshot, or written by an incompatible version";
+		return false;
+	}
+
+	LocalVector<flecs::entity_t> paths;
+	const uint32_t path_count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < path_count && !reader.failed; i++) {
+		const String path = reader.get_string();
+		const flecs::entity entity = p_world.lookup(path.utf8().get_data());
+		if (!entity.is_valid()) {
+			r_error = "unknown component or entity: " + path;
+			return false;
+		}
+		paths.push_back(entity.id());
+	}
+
+	// Entities referenced by id from table types, checked once all entities are known
+	LocalVector<flecs::entity_t> referenced;
+
+	const uint32_t table_count = reader.get<uint32_t>();
+	for (uint32_t t = 0; t < table_count && !reader.failed; t++) {
+		Table table;
+		const uint32_t row_count = reader.get<uint32_t>();
+		if (!reader.has(int64_t(row_count) * sizeof(uint64_t))) {
+			break;
+		}
+		table.entities.resize(row_count);
+		for (uint32_t i = 0; i < row_count; i++) {
+			const flecs::entity_t entity = reader.get<uint64_t>();
+			if (!_is_user_entity(entity)) {
+				r_error = vformat("invalid entity id %d", int64_t(entity));
+				return false;
+			}
+			// The index may be taken by a schema entity created since the snapshot
+			const flecs::entity_t alive = ecs_get_alive(world, entity);
+			if (alive && alive != entity && !is_state_entity(p_world, alive)) {
+				r_error = vformat("entity %d is in use by a component or system", int64_t(entity));
+				return false;
+			}
+			table.entities[i] = entity;
+			entities.push_back(entity);
+			entity_set.insert(entity);
+		}
+
+		const uint32_t named_count = reader.get<uint32_t>();
+		for (uint32_t i = 0; i < named_count && !reader.failed; i++) {
+			NamedRow named;
+			named.row = reader.get<uint32_t>();
+			named.name = reader.get_string();
+			table.names.push_back(named);
+		}
+
+		const uint32_t id_count = reader.get<uint32_t>();
+		for (uint32_t i = 0; i < id_count && !reader.failed; i++) {
+			const flecs::id_t flags = reader.get<uint64_t>();
+			flecs::entity_t first = 0;
+			flecs::entity_t second = 0;
+			uint8_t first_kind = REF_NONE;
+			uint8_t second_kind = REF_NONE;
+			if (!_read_ref(reader, paths, referenced, first, first_kind, r_error) || !_read_ref(reader, paths, referenced, second, second_kind, r_error)) {
+				return false;
+			}
+			if (reader.failed) {
+				break;
+			}
+			// Only the flags save() writes, an entity first and a target for pairs only
+			const bool is_pair = _is_pair(flags);
+			if ((flags & ~(ECS_PAIR | ECS_AUTO_OVERRIDE | ECS_TOGGLE)) != 0 ||
+					(first_kind != REF_PATH && first_kind != REF_ENTITY) ||
+					is_pair != (second_kind != REF_NONE)) {
+				r_error = "invalid id in a table type";
+				return false;
+			}
+			table.type.push_back(_is_pair(flags) ? (ecs_pair(first, second) | (flags & ~ECS_PAIR)) : (first | flags));
+		}
+
+		const uint32_t column_count = reader.get<uint32_t>();
+		for (uint32_t i = 0; i < column_count && !reader.failed; i++) {
+			const uint32_t id_index = reader.get<uint32_t>();
+			Column column;
+			column.size = reader.get<uint32_t>();
+			column.encoding = ColumnEncoding(reader.get<uint8_t>());
+			const uint32_t member_count = reader.get<uint32_t>();
+			column.data_size = reader.get<uint64_t>();
+			column.data = reader.get_bytes(column.data_size);
+			if (reader.failed) {
+				break;
+			}
+			if (id_index >= table.type.size()) {
+				r_error = "column refers to an id outside of its table";
+				return false;
+			}
+			column.id = table.type[id_index];
+
+			const ecs_type_info_t *info = ecs_get_type_info(world, column.id);
+			const String name = String::utf8(flecs::entity(world, column.id).str().c_str());
+			if (!info || info->size != column.size) {
+				r_error = vformat("layout of '%s' does not match the snapshot", name);
+				return false;
+			}
+			if (column.encoding != ENCODING_RAW && column.encoding != ENCODING_MEMBERS) {
+				r_error = vformat("column of '%s' has an unknown encoding", name);
+				return false;
+			}
+			if (column.encoding == ENCODING_RAW) {
+				if (column.data_size != int64_t(column.size) * row_count || !_is_trivially_copyable(info)) {
+					r_error = vformat("column of '%s' does not match the snapshot", name);
+					return false;
+				}
+			} else if (member_count != UINT32_MAX) {
+				column.plan = FlecsReflection::AccessPlanCache::get().get_plan(p_world, ecs_get_typeid(world, column.id));
+				if (!column.plan || _count_members(*column.plan) != member_count) {
+					r_error = vformat("members of '%s' do not match the snapshot", name);
+					return false;
+				}
+				column.member_count = member_count;
+			}
+			table.columns.push_back(column);
+		}
+		tables.push_back(table);
+	}
+
+	if (reader.failed || reader.pos != reader.size) {
+		r_error = "snapshot is truncated or corrupt";
+		return false;
+	}
+	for (flecs::entity_t entity : referenced) {
+		if (!entity_set.has(entity) && !ecs_is_alive(world, entity)) {
+			r_error = vformat("referenced entity %d does not exist", int64_t(entity));
+			return false;
+		}
+	}
+	return true;
+}
+
+void Restore::get_stale_entities(const flecs::world &p_world, LocalVector<flecs::entity_t> &r_entities) const {
+	const ecs_entities_t all = ecs_get_entities(p_world.c_ptr());
+	for (int32_t i = 0; i < all.alive_count; i++) {
+		const flecs::entity_t entity = all.ids[i];
+		if (!entity_set.has(entity) && is_state_entity(p_world, entity)) {
+			r_entities.push_back(entity);
+		}
+	}
+}
+
+// Destination table of a snapshot table. Named rows get the name pair up
+// front, so setting their names does not move them a second time.
+static ecs_table_t *_find_table(ecs_world_t *p_world, const LocalVector<flecs::id_t> &p_type, bool p_named) {
+	ecs_table_t *table = nullptr;
+	for (flecs::id_t id : p_type) {
+		table = ecs_table_add_id(p_world, table, id);
+	}
+	if (p_named) {
+		table = ecs_table_add_id(p_world, table, ecs_pair(ecs_id(EcsIdentifier), EcsName));
+	}
+	return table;
+}
+
+// Ids to add and remove to go from one table to another; types are sorted
+struct TableDiff {
+	LocalVector<flecs::id_t> added;
+	LocalVector<flecs::id_t> removed;
+};
+
+static void _diff_tables(ecs_table_t *p_from, ecs_table_t *p_to, TableDiff &r_diff) {
+	const ecs_type_t *from = p_from ? ecs_table_get_type(p_from) : nullptr;
+	const ecs_type_t *to = p_to ? ecs_table_get_type(p_to) : nullptr;
+	const int32_t from_count = from ? from->count : 0;
+	const int32_t to_count = to ? to->count : 0;
+	int32_t f = 0;
+	int32_t t = 0;
+	while (f < from_count || t < to_count) {
+		if (t == to_count || (f < from_count && from->array[f] < to->array[t])) {
+			r_diff.removed.push_back(from->array[f++]);
+		} else if (f == from_count || to->array[t] < from->array[f]) {
+			r_diff.added.push_back(to->array[t++]);
+		} else {
+			f++;
+			t++;
+		}
+	}
+}
+
+// One modified() on the first row flags the table for change detection and
+// a single OnSet covers the rest of the range. Components with an on_set
+// hook are notified per row, since emitting an event does not run hooks.
+static void _notify_range(ecs_world_t *p_world, flecs::id_t p_id, ecs_table_t *p_table, int32_t p_row, const flecs::entity_t *p_entities, uint32_t p_count) {
+	const ecs_type_info_t *info = ecs_get_type_info(p_world, p_id);
+	if (p_count < 2 || (info && info->hooks.on_set)) {
+		for (uint32_t r = 0; r < p_count; r++) {
+			ecs_modified_id(p_world, p_entities[r], p_id);
+		}
+		return;
+	}
+	ecs_modified_id(p_world, p_entities[0], p_id);
+	ecs_id_t id = p_id;
+	ecs_type_t ids = { &id, 1 };
+	ecs_event_desc_t desc = {};
+	desc.event = EcsOnSet;
+	desc.ids = &ids;
+	desc.table = p_table;
+	desc.offset = p_row + 1;
+	desc.count = int32_t(p_count) - 1;
+	desc.observable = p_world;
+	ecs_emit(p_world, &desc);
+}
+
+void Restore::apply(flecs::world &p_world) {
+	ecs_world_t *world = p_world.c_ptr();
+
+	// Tables none of whose entities exist yet (forks, fresh worlds) are
+	// inserted in one bulk operation
+	LocalVector<bool> fresh;
+	fresh.resize(tables.size());
+	for (uint32_t t = 0; t < tables.size(); t++) {
+		fresh[t] = true;
+		for (flecs::entity_t entity : tables[t].entities) {
+			if (ecs_is_alive(world, entity)) {
+				fresh[t] = false;
+				break;
+			}
+		}
+	}
+	// Pair targets must be alive before the destination tables are resolved
+	for (flecs::entity_t entity : entities) {
+		ecs_make_alive(world, entity);
+	}
+
+	// Every entity moves straight to its destination table: one bulk insert
+	// per fresh table, one commit per entity that is elsewhere, and nothing
+	// for entities whose type did not change
+	HashMap<ecs_table_t *, TableDiff> diffs;
+	for (uint32_t t = 0; t < tables.size(); t++) {
+		const Table &table = tables[t];
+		ecs_table_t *target = _find_table(world, table.type, !table.names.is_empty());
+		if (fresh[t] && target) {
+			ecs_bulk_desc_t desc = {};
+			desc.entities = const_cast<flecs::entity_t *>(table.entities.ptr());
+			desc.count = table.entities.size();
+			desc.table = target;
+			ecs_bulk_init(world, &desc);
+		} else if (!fresh[t]) {
+			diffs.clear();
+			for (flecs::entity_t entity : table.entities) {
+				ecs_record_t *record = ecs_record_find(world, entity);
+				ecs_table_t *current = record ? record->table : nullptr;
+				if (current == target) {
+					continue;
+				}
+				if (!target) {
+					ecs_clear(world, entity);
+					continue;
+				}
+				TableDiff *diff = diffs.getptr(current);
+				if (!diff) {
+					diff = &diffs.insert(current, TableDiff())->value;
+					_diff_tables(current, target, *diff);
+				}
+				const ecs_type_t added = { diff->added.ptr(), int32_t(diff->added.size()) };
+				const ecs_type_t removed = { diff->removed.ptr(), int32_t(diff->removed.size()) };
+				ecs_commit(world, entity, record, target, &added, &removed);
+			}
+		}
+
+		uint32_t next_named = 0;
+		for (uint32_t row = 0; row < table.entities.size(); row++) {
+			const char *name = nullptr;
+			CharString utf8;
+			if (next_named < table.names.size() && table.names[next_named].row == row) {
+				utf8 = table.names[next_named++].name.utf8();
+				name = utf8.get_data();
+			}
+			const char *current = ecs_get_name(world, table.entities[row]);
+			if ((name == nullptr) != (current == nullptr) || (name && strcmp(name, current) != 0)) {
+				ecs_set_name(world, table.entities[row], name);
+			}
+		}
+	}
+
+	// Component data, one memcpy and one notification per run of rows that
+	// are adjacent in the destination table (a whole table after a bulk insert)
+	p_world.defer_begin();
+	for (const Table &table : tables) {
+		for (const Column &column : table.columns) {
+			Reader reader;
+			reader.data = column.data;
+			reader.size = column.data_size;
+			const uint32_t count = table.entities.size();
+			uint32_t i = 0;
+			while (i < count) {
+				const ecs_record_t *record = ecs_record_find(world, table.entities[i]);
+				if (!record || !record->table) {
+					if (column.plan) {
+						_skip_members(reader, column.member_count);
+					}
+					i++;
+					continue;
+				}
+				const int32_t row = ECS_RECORD_TO_ROW(record->row);
+				uint32_t run = 1;
+				while (i + run < count) {
+					const ecs_record_t *next = ecs_record_find(world, table.entities[i + run]);
+					if (!next || next->table != record->table || ECS_RECORD_TO_ROW(next->row) != row + int32_t(run)) {
+						break;
+					}
+					run++;
+				}
+				uint8_t *dst = static_cast<uint8_t *>(ecs_table_get_id(world, record->table, column.id, row));
+				if (column.encoding == ENCODING_RAW) {
+					if (dst) {
+						memcpy(dst, column.data + int64_t(i) * column.size, int64_t(run) * column.size);
+					}
+				} else if (column.plan) {
+					for (uint32_t r = 0; r < run; r++) {
+						if (dst) {
+							_decode_members(reader, *column.plan, dst + int64_t(r) * column.size);
+						} else {
+							_skip_members(reader, column.member_count);
+						}
+					}
+				}
+				_notify_range(world, column.id, record->table, row, table.entities.ptr() + i, run);
+				i += run;
+			}
+		}
+	}
+	p_world.defer_end();
+}
+
+} // namespace FlecsWorldSnapshot
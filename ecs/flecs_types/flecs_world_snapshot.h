@@ -0,0 +1,99 @@
+#pragma once
+
+#include "core/string/ustring.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+#include "modules/godot_turbo/ecs/components/component_access_plan.h"
+#include "modules/godot_turbo/thirdparty/flecs/distr/flecs.h"
+#include <cstdint>
+#include <memory>
+
+/**
+ * @namespace FlecsWorldSnapshot
+ * @brief Binary checkpoints of a world's entity state
+ *
+ * A snapshot holds every state entity of a world (see is_state_entity()),
+ * grouped by table: their ids, names, type and the raw bytes of each
+ * component column. Columns of trivially copyable components are copied
+ * with one memcpy per run of rows, so saving and restoring them is bounded
+ * by memory bandwidth. Components with Godot members that own memory
+ * (String, Array, Dictionary, ...) are written member by member through
+ * their AccessPlan, using Variant encoding for those members. Components
+ * that own memory but have no reflection data are saved without values and
+ * restored default constructed.
+ *
+ * Snapshots are parsed as untrusted input: ids with unknown flags, builtin
+ * entity ids and malformed table types are rejected before anything is
+ * applied.
+ *
+ * Components, tags and relationships are stored by path, so a snapshot can
+ * be loaded into a freshly created world that registers the same types.
+ * Entity ids, including generations, are preserved.
+ *
+ * Schema entities (components, systems, observers, phases, modules, ...) and
+ * their scopes are not part of a snapshot, and so are singletons stored on
+ * component entities. Server objects referenced through RID fields are not
+ * recreated: RIDs are restored as plain values.
+ */
+namespace FlecsWorldSnapshot {
+
+/** @brief Whether @p p_entity belongs to the world's state rather than its schema. */
+bool is_state_entity(const flecs::world &p_world, flecs::entity_t p_entity);
+
+/** @brief Serialize every state entity of @p p_world. */
+PackedByteArray save(flecs::world &p_world);
+
+enum ColumnEncoding : uint8_t {
+	ENCODING_RAW, // Bitwise copy of the column
+	ENCODING_MEMBERS, // Members encoded one by one through an AccessPlan
+};
+
+/**
+ * @class Restore
+ * @brief A parsed snapshot, ready to be applied to a world
+ *
+ * parse() resolves every path and checks every component layout against the
+ * target world, so a snapshot that cannot be applied is rejected before the
+ * world is touched. The caller removes get_stale_entities() (state entities
+ * created since the snapshot) the way it normally destroys entities, then
+ * calls apply().
+ */
+class Restore {
+public:
+	bool parse(flecs::world &p_world, const PackedByteArray &p_snapshot, String &r_error);
+	void get_stale_entities(const flecs::world &p_world, LocalVector<flecs::entity_t> &r_entities) const;
+	void apply(flecs::world &p_world);
+
+	uint32_t get_entity_count() const { return entities.size(); }
+
+private:
+	struct Column {
+		flecs::id_t id = 0;
+		int32_t size = 0;
+		ColumnEncoding encoding = ENCODING_RAW;
+		std::shared_ptr<const FlecsReflection::AccessPlan> plan;
+		uint32_t member_count = 0;
+		const uint8_t *data = nullptr;
+		int64_t data_size = 0;
+	};
+
+	struct NamedRow {
+		uint32_t row = 0;
+		String name;
+	};
+
+	struct Table {
+		LocalVector<flecs::entity_t> entities;
+		LocalVector<flecs::id_t> type;
+		LocalVector<Column> columns;
+		LocalVector<NamedRow> names;
+	};
+
+	PackedByteArray snapshot; // Keeps column data alive
+	LocalVector<Table> tables;
+	LocalVector<flecs::entity_t> entities;
+	HashSet<flecs::entity_t> entity_set;
+};
+
+} // namespace FlecsWorldSnapshot
@@ -0,0 +1,75 @@
+#include "modules/godot_turbo/ecs/flecs_types/frame_summary_history.h"
+
+#include "core/variant/variant.h"
+
+Dictionary WorldFrameSummary::to_dictionary() const {
+	Array systems_breakdown;
+	for (const ScriptSystemFrameStats &stats : systems) {
+		Dictionary row;
+		row["rid"] = stats.rid;
+		row["entities"] = (int64_t)stats.entities;
+		row["last_dispatch_usec"] = (int64_t)stats.last_dispatch_usec;
+		row["dispatch_invocations"] = (int64_t)stats.dispatch_invocations;
+		row["dispatch_accum_usec"] = (int64_t)stats.dispatch_accum_usec;
+		row["dispatch_avg_usec"] = stats.dispatch_invocations == 0 ? Variant() : Variant((int64_t)(stats.dispatch_accum_usec / stats.dispatch_invocations));
+		row["mode"] = stats.mode;
+		row["min_dispatch_usec"] = (int64_t)stats.min_dispatch_usec;
+		row["max_dispatch_usec_system"] = (int64_t)stats.max_dispatch_usec;
+		if (stats.detailed_timing) {
+			row["median_dispatch_usec"] = stats.median_dispatch_usec;
+			row["p99_dispatch_usec"] = stats.p99_dispatch_usec;
+			row["stddev_dispatch_usec"] = stats.stddev_dispatch_usec;
+		}
+		row["onadd"] = (int64_t)stats.onadd;
+		row["onset"] = (int64_t)stats.onset;
+		row["onremove"] = (int64_t)stats.onremove;
+		systems_breakdown.push_back(row);
+	}
+
+	Dictionary summary;
+	summary["frame"] = (int64_t)frame;
+	summary["delta"] = delta;
+	summary["script_systems"] = (int64_t)script_systems;
+	summary["total_entities_this_frame"] = (int64_t)total_entities;
+	summary["total_callbacks_all_time"] = (int64_t)total_callbacks_all_time;
+	summary["batch_system_count"] = (int64_t)batch_system_count;
+	summary["max_dispatch_usec"] = (int64_t)max_dispatch_usec;
+	summary["dispatch_invocations"] = (int64_t)dispatch_invocations;
+	summary["dispatch_accum_usec"] = (int64_t)dispatch_accum_usec;
+	summary["dispatch_avg_usec"] = dispatch_invocations == 0 ? Variant() : Variant((int64_t)(dispatch_accum_usec / dispatch_invocations));
+	// Median/p99 are not merged across systems (that needs the full distributions);
+	// the per-system rows carry them
+	summary["systems"] = systems_breakdown;
+	return summary;
+}
+
+WorldFrameSummary &FrameSummaryHistory::begin_frame() {
+	WorldFrameSummary &summary = frames[head];
+	head = (head + 1) % frames.size();
+	if (count < frames.size()) {
+		count++;
+	}
+	// clear() keeps the rows' capacity
+	summary.systems.clear();
+	return summary;
+}
+
+const WorldFrameSummary *FrameSummaryHistory::get(uint32_t p_age) const {
+	if (p_age >= count) {
+		return nullptr;
+	}
+	const uint32_t capacity = frames.size();
+	return &frames[(head + capacity - 1 - p_age) % capacity];
+}
+
+void FrameSummaryHistory::set_capacity(uint32_t p_capacity) {
+	frames.clear();
+	frames.resize(MAX(p_capacity, 1u));
+	head = 0;
+	count = 0;
+}
+
+void FrameSummaryHistory::clear() {
+	head = 0;
+	count = 0;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "core/templates/local_vector.h"
+#include "core/templates/rid.h"
+#include "core/variant/array.h"
+#include "core/variant/dictionary.h"
+#include <cstdint>
+
+/** @brief Dispatch counters of one instrumented script system for one frame. */
+struct ScriptSystemFrameStats {
+	RID rid;
+	uint64_t entities = 0;
+	uint64_t last_dispatch_usec = 0;
+	uint64_t dispatch_invocations = 0;
+	uint64_t dispatch_accum_usec = 0;
+	uint64_t min_dispatch_usec = 0;
+	uint64_t max_dispatch_usec = 0;
+	int64_t mode = 0;
+	bool detailed_timing = false;
+	double median_dispatch_usec = 0.0;
+	double p99_dispatch_usec = 0.0;
+	double stddev_dispatch_usec = 0.0;
+	uint64_t onadd = 0;
+	uint64_t onset = 0;
+	uint64_t onremove = 0;
+};
+
+/** @brief Totals across the script systems of a world for one frame. */
+struct WorldFrameSummary {
+	uint64_t frame = 0;
+	double delta = 0.0;
+	uint64_t script_systems = 0;
+	uint64_t total_entities = 0;
+	uint64_t total_callbacks_all_time = 0;
+	uint64_t batch_system_count = 0;
+	uint64_t max_dispatch_usec = 0;
+	uint64_t dispatch_invocations = 0;
+	uint64_t dispatch_accum_usec = 0;
+	LocalVector<ScriptSystemFrameStats> systems;
+
+	Dictionary to_dictionary() const;
+};
+
+/**
+ * @class FrameSummaryHistory
+ * @brief Ring buffer of the last frame summaries of a world
+ *
+ * progress_world() fills the next slot in place: slots and their system rows
+ * are reused, so once the buffer has wrapped recording a frame allocates
+ * nothing. Dictionaries are only built when a summary is read.
+ */
+class FrameSummaryHistory {
+public:
+	static constexpr uint32_t DEFAULT_CAPACITY = 120;
+
+	FrameSummaryHistory() { frames.resize(DEFAULT_CAPACITY); }
+
+	// Slot for a new frame, overwriting the oldest one once the buffer is full
+	WorldFrameSummary &begin_frame();
+
+	// p_age 0 is the latest frame; returns nullptr past the recorded history
+	const WorldFrameSummary *get(uint32_t p_age) const;
+	uint32_t size() const { return count; }
+
+	// Drops the recorded history
+	void set_capacity(uint32_t p_capacity);
+	uint32_t get_capacity() const { return frames.size(); }
+	void clear();
+
+	// Script system RIDs of the world, reused every frame
+	LocalVector<RID> scratch_rids;
+
+private:
+	LocalVector<WorldFrameSummary> frames;
+	uint32_t head = 0; // Next slot to write
+	uint32_t count = 0;
+};
@@ -0,0 +1,107 @@
+#include "modules/godot_turbo/ecs/flecs_types/transform_propagation.h"
+
+#include "core/templates/local_vector.h"
+#include "modules/godot_turbo/ecs/components/all_components.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_worker_pool.h"
+
+namespace {
+
+template <typename TLocal, typename TGlobal>
+struct PropagationSlice {
+	const TLocal *local = nullptr;
+	// Null for roots
+	const TGlobal *parent = nullptr;
+	TGlobal *global = nullptr;
+	uint32_t count = 0;
+};
+
+struct PropagationChunk {
+	uint32_t slice = 0;
+	uint32_t begin = 0;
+	uint32_t end = 0;
+};
+
+template <typename TLocal, typename TGlobal>
+void compute_slice(const PropagationSlice<TLocal, TGlobal> &p_slice, uint32_t p_begin, uint32_t p_end) {
+	if (p_slice.parent) {
+		const auto &parent_transform = p_slice.parent->transform;
+		for (uint32_t i = p_begin; i < p_end; i++) {
+			p_slice.global[i].transform = parent_transform * p_slice.local[i].transform;
+		}
+	} else {
+		for (uint32_t i = p_begin; i < p_end; i++) {
+			p_slice.global[i].transform = p_slice.local[i].transform;
+		}
+	}
+}
+
+// Computes one depth level; its rows only read the level above
+template <typename TLocal, typename TGlobal>
+void flush_level(LocalVector<PropagationSlice<TLocal, TGlobal>> &r_level, LocalVector<PropagationChunk> &r_chunks) {
+	r_chunks.clear();
+	for (uint32_t s = 0; s < r_level.size(); s++) {
+		for (uint32_t begin = 0; begin < r_level[s].count; begin += TransformPropagation::CHUNK_SIZE) {
+			r_chunks.push_back({ s, begin, MIN(begin + TransformPropagation::CHUNK_SIZE, r_level[s].count) });
+		}
+	}
+	if (r_chunks.size() == 1) {
+		compute_slice(r_level[0], r_chunks[0].begin, r_chunks[0].end);
+	} else if (r_chunks.size() > 1) {
+		FlecsWorkerPool::get_singleton()->parallel_for(r_chunks.size(), [&](uint32_t p_index) {
+			const PropagationChunk &chunk = r_chunks[p_index];
+			compute_slice(r_level[chunk.slice], chunk.begin, chunk.end);
+		});
+	}
+	r_level.clear();
+}
+
+template <typename TLocal, typename TGlobal>
+void propagate(flecs::iter &it) {
+	LocalVector<PropagationSlice<TLocal, TGlobal>> level;
+	LocalVector<PropagationChunk> chunks;
+	uint64_t depth = UINT64_MAX;
+	while (it.next()) {
+		ecs_iter_t *iter = it.c_ptr();
+		// Cascade groups tables by depth, parents first
+		if (iter->group_id != depth) {
+			flush_level(level, chunks);
+			depth = iter->group_id;
+		}
+		// Skipping also leaves the global column clean, so the children of
+		// this table are skipped as well
+		if (!it.changed()) {
+			it.skip();
+			continue;
+		}
+		PropagationSlice<TLocal, TGlobal> slice;
+		slice.local = ecs_field(iter, TLocal, 0);
+		slice.parent = ecs_field(iter, TGlobal, 1);
+		slice.global = ecs_field(iter, TGlobal, 2);
+		slice.count = iter->count;
+		level.push_back(slice);
+	}
+	flush_level(level, chunks);
+}
+
+template <typename TLocal, typename TGlobal>
+void create_system(flecs::world &p_world, const char *p_name) {
+	// The own global transform is write-only, so writing it does not count
+	// as a change of the table on the next frame
+	p_world.system<const TLocal, const TGlobal, TGlobal>(p_name)
+			.term_at(1)
+			.parent()
+			.cascade()
+			.optional()
+			.term_at(2)
+			.out()
+			.detect_changes()
+			.kind(flecs::PostUpdate)
+			.run(propagate<TLocal, TGlobal>);
+}
+
+} // namespace
+
+void TransformPropagation::setup(flecs::world &p_world) {
+	create_system<LocalTransform3D, GlobalTransform3D>(p_world, "TransformPropagation3D");
+	create_system<LocalTransform2D, GlobalTransform2D>(p_world, "TransformPropagation2D");
+}
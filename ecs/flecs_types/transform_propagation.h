@@ -0,0 +1,32 @@
+#pragma once
+
+#include "modules/godot_turbo/thirdparty/flecs/distr/flecs.h"
+#include <cstdint>
+
+/**
+ * @class TransformPropagation
+ * @brief Native systems writing GlobalTransform3D/2D down ChildOf hierarchies
+ *
+ * One PostUpdate system per dimension matches the entities that have a local
+ * and a global transform, with the parent's global transform as an optional
+ * cascade term. Cascade groups the tables by depth, so a level is only
+ * computed once the level above it is done; the rows of one level have no
+ * dependencies between them and are split across the worker pool.
+ *
+ * Change detection works per table: a table is recomputed when its local
+ * transforms were written (set_component / modified()), when entities moved
+ * in or out, or when the table holding its parent's global transform was
+ * recomputed this frame. Subtrees below an unchanged parent are skipped.
+ * Writes through raw pointers without modified() are not seen.
+ *
+ * A parent without a global transform is looked through: its children use
+ * the nearest ancestor that has one, or their local transform as is.
+ */
+class TransformPropagation {
+public:
+	// Rows handed to a pool thread at a time when a level is split up
+	static constexpr uint32_t CHUNK_SIZE = 1024;
+
+	// Creates the TransformPropagation3D and TransformPropagation2D systems
+	static void setup(flecs::world &p_world);
+};
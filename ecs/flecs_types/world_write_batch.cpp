@@ -0,0 +1,73 @@
+#include "modules/godot_turbo/ecs/flecs_types/world_write_batch.h"
+
+WorldWriteBatch::Op &WorldWriteBatch::_get_or_add_op(flecs::entity_t p_entity, flecs::entity_t p_component, OpKind p_kind, bool &r_added) {
+	recorded_count++;
+	const OpKey key(p_entity, p_component);
+	if (const uint32_t *index = op_index.getptr(key)) {
+		r_added = false;
+		return ops[*index];
+	}
+	op_index.insert(key, ops.size());
+	Op op;
+	op.entity = p_entity;
+	op.component = p_component;
+	op.kind = p_kind;
+	ops.push_back(op);
+	r_added = true;
+	return ops[ops.size() - 1];
+}
+
+void WorldWriteBatch::record_add(flecs::entity_t p_entity, flecs::entity_t p_component) {
+	MutexLock lock(mutex);
+	bool added = false;
+	Op &op = _get_or_add_op(p_entity, p_component, OP_ADD, added);
+	if (!added && op.kind == OP_REMOVE) {
+		op.kind = OP_ADD;
+		op.reset = true;
+	}
+}
+
+void WorldWriteBatch::record_set(flecs::entity_t p_entity, flecs::entity_t p_component, const Dictionary &p_data) {
+	MutexLock lock(mutex);
+	bool added = false;
+	Op &op = _get_or_add_op(p_entity, p_component, OP_SET, added);
+	if (added || op.kind != OP_SET) {
+		op.reset = op.reset || op.kind == OP_REMOVE;
+		op.kind = OP_SET;
+		op.data = p_data.duplicate();
+		return;
+	}
+	op.data.merge(p_data, true);
+}
+
+void WorldWriteBatch::record_remove(flecs::entity_t p_entity, flecs::entity_t p_component) {
+	MutexLock lock(mutex);
+	bool added = false;
+	Op &op = _get_or_add_op(p_entity, p_component, OP_REMOVE, added);
+	op.kind = OP_REMOVE;
+	op.reset = false;
+	op.data = Dictionary();
+}
+
+void WorldWriteBatch::take(LocalVector<Op> &r_ops) {
+	MutexLock lock(mutex);
+	r_ops.clear();
+	SWAP(r_ops, ops);
+	op_index.clear();
+}
+
+void WorldWriteBatch::clear() {
+	MutexLock lock(mutex);
+	ops.clear();
+	op_index.clear();
+}
+
+uint32_t WorldWriteBatch::get_pending_count() const {
+	MutexLock lock(mutex);
+	return ops.size();
+}
+
+uint64_t WorldWriteBatch::get_recorded_count() const {
+	MutexLock lock(mutex);
+	return recorded_count;
+}
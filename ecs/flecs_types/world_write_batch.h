@@ -0,0 +1,78 @@
+#pragma once
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+#include "core/variant/dictionary.h"
+#include "modules/godot_turbo/thirdparty/flecs/distr/flecs.h"
+#include <cstdint>
+
+/**
+ * @class WorldWriteBatch
+ * @brief Compact buffer of component writes recorded from scripts
+ *
+ * Every FlecsServer::set_component() call may move the entity to another
+ * archetype and fires OnSet observers right away (script system change
+ * observers, query cache invalidation). Scripts editing thousands of entities
+ * record into this buffer instead, and FlecsServer applies it in a single
+ * defer_begin()/defer_end() block at a chosen pipeline point.
+ *
+ * Writes are coalesced per (entity, component): only the final state is kept,
+ * so each pair produces at most one observer notification when applied.
+ * - set after set merges the dictionaries, later keys win
+ * - set or add after remove becomes that set or add with reset set: the
+ *   component is removed first, so fields the set leaves out start from
+ *   their default values instead of the old ones
+ * - add after set or add is a no-op
+ * - remove discards anything recorded before it
+ *
+ * Ops keep the position of the first write to their pair. Recording is
+ * thread-safe; take() swaps the buffer out so writes recorded while a batch is
+ * being applied land in the next one.
+ */
+class WorldWriteBatch {
+public:
+	enum OpKind : uint8_t {
+		OP_ADD,
+		OP_SET,
+		OP_REMOVE,
+	};
+
+	struct Op {
+		flecs::entity_t entity = 0;
+		flecs::entity_t component = 0;
+		OpKind kind = OP_ADD;
+		bool reset = false; // Remove the component before adding or setting it
+		Dictionary data; // OP_SET only
+	};
+
+	WorldWriteBatch() = default;
+	WorldWriteBatch(const WorldWriteBatch &) = delete;
+	WorldWriteBatch &operator=(const WorldWriteBatch &) = delete;
+
+	void record_add(flecs::entity_t p_entity, flecs::entity_t p_component);
+	void record_set(flecs::entity_t p_entity, flecs::entity_t p_component, const Dictionary &p_data);
+	void record_remove(flecs::entity_t p_entity, flecs::entity_t p_component);
+
+	// Moves the pending ops into r_ops and leaves the batch empty
+	void take(LocalVector<Op> &r_ops);
+	void clear();
+
+	uint32_t get_pending_count() const;
+	uint64_t get_recorded_count() const;
+
+	// Pipeline phase the batch is flushed in; 0 flushes before each progress
+	flecs::entity_t flush_phase = 0;
+	flecs::entity flush_system;
+
+private:
+	typedef Pair<flecs::entity_t, flecs::entity_t> OpKey;
+
+	mutable Mutex mutex;
+	LocalVector<Op> ops;
+	HashMap<OpKey, uint32_t, PairHash<flecs::entity_t, flecs::entity_t>> op_index;
+	uint64_t recorded_count = 0;
+
+	Op &_get_or_add_op(flecs::entity_t p_entity, flecs::entity_t p_component, OpKind p_kind, bool &r_added);
+};
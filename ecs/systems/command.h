@@ -457,6 +457,24 @@ public:
 			destroy_command(cmd);
 		}
 	}
+
+	/**
+	 * @brief Processes the commands queued before the call
+	 * 
+	 * Commands enqueued while these run are left for the next call, so a
+	 * command can re-queue itself to continue on the next frame.
+	 * 
+	 * @note Should be called from a single designated thread (typically main)
+	 */
+	void process_pending() {
+		size_t pending = queue.size_approx();
+		ICommand* cmd = nullptr;
+		while (pending > 0 && queue.try_dequeue(cmd) && cmd) {
+			pending--;
+			cmd->execute();
+			destroy_command(cmd);
+		}
+	}
 	
 	/**
 	 * @brief Default constructor
@@ -581,6 +599,17 @@ public:
 		command_queue.process();
 	}
 
+	/**
+	 * @brief Processes the commands queued before the call
+	 * 
+	 * Commands queued while processing wait for the next call.
+	 * 
+	 * @note Should be called from a single thread (typically main)
+	 */
+	inline void process_pending_commands() {
+		command_queue.process_pending();
+	}
+
 	/**
 	 * @brief Binds methods to Godot's ClassDB
 	 */
@@ -82,8 +82,9 @@ void GDScriptRunnerSystem::init(const RID& p_world_rid, flecs::world* p_world) {
 	
 	// Create physics process system (runs during OnPhysicsUpdate phase)
 	physics_process_system = world->system<GameScriptComponent>()
-		.kind(flecs::OnPhysicsUpdate)
-		.each([this](flecs::entity e, GameScriptComponent& script_comp) {
+		.kind<FlecsPhases::OnPhysicsUpdate>()
+		.each([this](flecs::iter& it, size_t i, GameScriptComponent& script_comp) {
+			flecs::entity e = it.entity(i);
 			ScriptMethodCache local_cache;
 			ScriptMethodCache* cache = &local_cache;
 			const StringName cache_key = get_cache_key(script_comp);
@@ -99,10 +100,8 @@ void GDScriptRunnerSystem::init(const RID& p_world_rid, flecs::world* p_world) {
 				
 				RID entity_rid = server->_get_or_create_rid_for_entity(world_rid, e);
 				
-				// For physics, use fixed physics delta
-				// Note: Flecs doesn't have built-in physics timing, so we use delta_time
-				// In a real implementation, you might want to track physics ticks separately
-				float delta = static_cast<float>(world->delta_time());
+				// The fixed step delta when the world has a tick rate (see FixedTimestep)
+				float delta = static_cast<float>(it.delta_time());
 				const StringName method_name = cache->physics_process_method.is_empty() ?
 						StringName(PHYSICS_PROCESS_METHOD_GDSCRIPT) : cache->physics_process_method;
 				
@@ -115,6 +114,11 @@ void GDScriptRunnerSystem::init(const RID& p_world_rid, flecs::world* p_world) {
 				);
 			}
 		});
+
+	// Script callbacks keep the world on the calling thread in progress_worlds
+	ready_system.add<ScriptCallbackSystem>();
+	process_system.add<ScriptCallbackSystem>();
+	physics_process_system.add<ScriptCallbackSystem>();
 }
 
 bool GDScriptRunnerSystem::check_and_cache_method(const StringName& instance_type,
@@ -381,18 +385,6 @@ void GDScriptRunnerSystem::set_process_enabled(bool enabled) {
 			process_system.disable();
 		}
 	}
-
-	if (physics_process_system.is_valid() && flecs::OnPhysicsUpdate == flecs::OnUpdate) {
-		if (!enabled) {
-			if (physics_process_system.enabled()) {
-				physics_process_system.disable();
-				physics_process_suspended_by_process = true;
-			}
-		} else if (physics_process_suspended_by_process) {
-			physics_process_system.enable();
-			physics_process_suspended_by_process = false;
-		}
-	}
 }
 
 void GDScriptRunnerSystem::set_physics_process_enabled(bool enabled) {
@@ -403,7 +395,6 @@ void GDScriptRunnerSystem::set_physics_process_enabled(bool enabled) {
 			physics_process_system.disable();
 		}
 	}
-	physics_process_suspended_by_process = false;
 }
 
 bool GDScriptRunnerSystem::is_process_enabled() const {
@@ -84,7 +84,6 @@ private:
     flecs::entity physics_process_system;      ///< System running during OnPhysicsUpdate phase
     flecs::world* world = nullptr;             ///< Pointer to Flecs world
     RID world_rid;                             ///< RID of the Flecs world
-    bool physics_process_suspended_by_process = false; ///< Tracks auto-suspend when phases overlap
 
     // Method cache: maps script_path when available, otherwise instance_type, to method availability
     HashMap<StringName, ScriptMethodCache> method_cache;
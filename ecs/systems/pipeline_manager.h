@@ -29,7 +29,8 @@
  * - `flecs::PreStore` - Before storage
  * - `flecs::OnStore` - Store/serialize
  * - `flecs::PostFrame` - End of frame cleanup
- * - `flecs::OnPhysicsUpdate` - Physics simulation
+ * - `FlecsPhases::OnPhysicsUpdate` - Fixed-step physics simulation (tag phase run by
+ *   FixedTimestep from its own pipeline, see flecs_phases.h)
  * 
  * Custom phases can be created with dependencies to control execution order.
  * 
@@ -51,7 +52,7 @@
  *     .iter([](flecs::iter& it, RigidBodyComponent* bodies) {
  *         // Physics logic
  *     });
- * pipeline.add_to_pipeline(physics_system, flecs::OnPhysicsUpdate);
+ * pipeline.add_to_pipeline(physics_system, world->entity<FlecsPhases::OnPhysicsUpdate>());
  * 
  * // Create a custom phase
  * flecs::entity custom_phase = pipeline.create_custom_phase("CustomLogic", "OnUpdate");
@@ -166,7 +167,7 @@ class PipelineManager {
          * The phase determines when the system executes relative to other systems.
          * 
          * @param system The Flecs system to add
-         * @param phase The execution phase (e.g., flecs::OnUpdate, flecs::OnPhysicsUpdate)
+         * @param phase The execution phase (e.g., flecs::OnUpdate, world->entity<FlecsPhases::OnPhysicsUpdate>())
          * 
          * @warning System must have a name assigned or registration will fail
          * @note The system is automatically added to the phase relationship
@@ -262,7 +262,7 @@ TEST_CASE("[PipelineManager] add_to_pipeline with specific phase") {
 		});
 	
 	// Add to pipeline with specific phase
-	manager.add_to_pipeline(physics_system, flecs::OnPhysicsUpdate);
+	manager.add_to_pipeline(physics_system, fixture.world->entity<FlecsPhases::OnPhysicsUpdate>());
 	
 	// Verify system can be found
 	flecs::system* found = manager.try_get_system("PhysicsSystem");
@@ -293,13 +293,13 @@ TEST_CASE("[PipelineManager] add_to_pipeline with multiple systems") {
 		.iter([](flecs::iter& it, TestComponent* comps) {});
 	
 	flecs::system system3 = fixture.world->system<TestComponent>("System3")
-		.kind(flecs::OnPhysicsUpdate)
+		.kind<FlecsPhases::OnPhysicsUpdate>()
 		.iter([](flecs::iter& it, TestComponent* comps) {});
 	
 	// Add all systems
 	manager.add_to_pipeline(system1);
 	manager.add_to_pipeline(system2);
-	manager.add_to_pipeline(system3, flecs::OnPhysicsUpdate);
+	manager.add_to_pipeline(system3, fixture.world->entity<FlecsPhases::OnPhysicsUpdate>());
 	
 	// Verify all can be found
 	CHECK(manager.try_get_system("System1") != nullptr);
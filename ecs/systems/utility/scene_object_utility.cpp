@@ -2,6 +2,8 @@
 
 #include "core/templates/rid.h"
 #include "modules/godot_turbo/ecs/flecs_types/flecs_server.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_worker_pool.h"
+#include "modules/godot_turbo/ecs/systems/command.h"
 #include "modules/godot_turbo/thirdparty/flecs/distr/flecs.h"
 #include "modules/godot_turbo/ecs/components/all_components.h"
 #include "core/math/transform_2d.h"
@@ -16,6 +18,7 @@
 #include "resource_object_utility.h"
 #include "scene/main/scene_tree.h"
 #include "scene/main/window.h"
+#include "scene/2d/camera_2d.h"
 #include "scene/2d/mesh_instance_2d.h"
 #include "scene/3d/navigation/navigation_agent_3d.h"
 #include "scene/3d/navigation/navigation_link_3d.h"
@@ -43,12 +46,16 @@
 #include "core/variant/binder_common.h"
 #include "core/object/script_language.h"
 #include "core/object/script_instance.h"
+#include "scene/3d/camera_3d.h"
 #include "scene/3d/gpu_particles_3d.h"
+#include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/reflection_probe.h"
 #include "scene/3d/skeleton_3d.h"
 #include "scene/3d/world_environment.h"
 #include "scene/3d/light_3d.h"
 #include "scene/3d/voxel_gi.h"
+#include "scene/resources/environment.h"
+#include "servers/rendering_server.h"
 
 namespace {
 
@@ -93,8 +100,117 @@ static GameScriptComponent _make_game_script_component(const Node *p_node, const
     return script_comp;
 }
 
+// How convert_scene_async() builds a node's entity, in create_entity()'s dispatch order
+enum class ConversionKind : uint8_t {
+    GENERIC, // SceneNodeComponent only; created in bulk
+    NAV_AGENT_3D,
+    NAV_LINK_3D,
+    NAV_OBSTACLE_3D,
+    NAV_REGION_3D,
+    NAV_AGENT_2D,
+    NAV_LINK_2D,
+    NAV_OBSTACLE_2D,
+    NAV_REGION_2D,
+    AREA_3D,
+    BODY_3D,
+    JOINT_3D,
+    SOFT_BODY_3D,
+    AREA_2D,
+    BODY_2D,
+    JOINT_2D,
+    MESH_INSTANCE_3D,
+    PARTICLES_3D,
+    REFLECTION_PROBE,
+    SKELETON_3D,
+    ENVIRONMENT,
+    DIRECTIONAL_LIGHT_3D,
+    OMNI_LIGHT_3D,
+    SPOT_LIGHT_3D,
+    VIEWPORT,
+    VOXEL_GI,
+    MESH_INSTANCE_2D,
+    CAMERA_2D,
+    SKELETON_2D,
+    CANVAS_ITEM,
+    // Creators that configure a new server object from many node properties
+    // or fan out into several entities; replayed through create_entity()
+    CREATOR,
+};
+
+// Built by the worker task from a snapshot; the commit only adds server RIDs
+struct StagedNode {
+    CharString name;
+    ObjectInstanceComponent object_instance;
+    SceneNodeComponent scene_node;
+    Transform3DComponent transform_3d;
+    Transform2DComponent transform_2d;
+    VisibilityComponent visibility;
+    MeshComponent mesh;
+    CanvasItemComponent canvas_item;
+    SkeletonComponent skeleton;
+};
+
+template <typename T>
+static void _set_server_rid(flecs::entity &p_entity, RID T::*p_member, const RID &p_rid) {
+    T component;
+    component.*p_member = p_rid;
+    p_entity.set<T>(component);
+}
+
 } // namespace
 
+// Everything the conversion reads from a node, taken on the calling thread so
+// the worker task never touches a live node. Node and Resource getters are not
+// thread safe, so this part of the walk cannot move to the worker.
+struct SceneObjectUtility::NodeSnapshot {
+    ObjectID node_id;
+    ConversionKind kind = ConversionKind::GENERIC;
+    StringName class_name;
+    String name;
+    bool has_script = false;
+    bool visible = true;
+    // Server object the node already owns (body, light, probe, mesh...)
+    RID server_id;
+    // Scenario instance the node already made, for 3D lights
+    RID instance_id;
+    RID canvas_item;
+    // Canvas item of the parent Node2D, if any
+    RID parent_canvas_item;
+    Transform3D transform_3d;
+    Transform2D transform_2d;
+    Vector<RID> material_ids;
+    Vector<Transform3D> bone_poses_3d;
+    Vector<Transform2D> bone_poses_2d;
+    // Kept alive by the world's ref storage once committed
+    LocalVector<Ref<Resource>> resources;
+};
+
+struct SceneObjectUtility::ConversionJob {
+    int64_t id = 0;
+    RID world_id;
+    Ref<CommandHandler> commands;
+    ecs_os_thread_t task = 0;
+
+    // Taken on the calling thread, in create_entities() order
+    LocalVector<NodeSnapshot> snapshots;
+    // Filled by the worker task, one entry per snapshot
+    LocalVector<StagedNode> staged;
+
+    // Snapshots committed so far, and the entities they produced
+    uint32_t committed = 0;
+    TypedArray<RID> entities;
+};
+
+SceneObjectUtility::~SceneObjectUtility() {
+    // Staging tasks still write to their jobs; jobs already committing were reaped
+    for (const KeyValue<int64_t, ConversionJob *> &kv : conversion_jobs) {
+        if (kv.value->task) {
+            FlecsWorkerPool::get_singleton()->join(kv.value->task);
+        }
+        memdelete(kv.value);
+    }
+}
+
 TypedArray<RID> SceneObjectUtility::create_entities_from_scene(const RID &world_id, SceneTree *tree){
     if (tree == nullptr) {
         ERR_FAIL_V(TypedArray<RID>());
@@ -502,12 +618,616 @@ RID SceneObjectUtility::get_node_script(const RID &world_id, const Node *node, c
     return RID();
 }
 
+int64_t SceneObjectUtility::convert_scene_async(const RID &world_id, Node *root, int max_depth) {
+    if (root == nullptr) {
+        ERR_FAIL_COND_V(root == nullptr, -1);
+    }
+    FlecsServer *server = FlecsServer::get_singleton();
+    if (!server) {
+        ERR_FAIL_COND_V(!server, -1);
+    }
+    if (!server->_get_world(world_id)) {
+        ERR_PRINT("SceneObjectUtility::convert_scene_async: world not found");
+        return -1;
+    }
+
+    Ref<CommandHandler> commands = server->get_command_handler(world_id, conversion_command_handler_name);
+    if (commands.is_null()) {
+        commands.instantiate();
+        server->register_command_handler(world_id, conversion_command_handler_name, commands);
+    }
+
+    ConversionJob *job = memnew(ConversionJob);
+    job->id = next_conversion_job_id++;
+    job->world_id = world_id;
+    job->commands = commands;
+
+    // Depth-first, parents before children, like create_entities()
+    struct PendingNode {
+        Node *node = nullptr;
+        int depth = 0;
+    };
+    LocalVector<PendingNode> stack;
+    stack.push_back({ root, 0 });
+    while (!stack.is_empty()) {
+        const PendingNode pending = stack[stack.size() - 1];
+        stack.resize(stack.size() - 1);
+        job->snapshots.push_back(NodeSnapshot());
+        _snapshot_node(pending.node, job->snapshots[job->snapshots.size() - 1]);
+        if (pending.depth >= max_depth) {
+            continue;
+        }
+        for (int i = pending.node->get_child_count() - 1; i >= 0; i--) {
+            stack.push_back({ pending.node->get_child(i), pending.depth + 1 });
+        }
+    }
+
+    conversion_jobs.insert(job->id, job);
+    job->task = FlecsWorkerPool::get_singleton()->start(_stage_conversion, job);
+    return job->id;
+}
+
+void SceneObjectUtility::_snapshot_node(Node *p_node, NodeSnapshot &r_snapshot) {
+    r_snapshot.node_id = p_node->get_instance_id();
+    r_snapshot.class_name = p_node->get_class_name();
+    r_snapshot.name = p_node->get_name();
+    r_snapshot.has_script = !p_node->get_script().is_null();
+    if (const Node3D *node_3d = Object::cast_to<Node3D>(p_node)) {
+        r_snapshot.transform_3d = node_3d->get_transform();
+    }
+    if (const CanvasItem *canvas_item = Object::cast_to<CanvasItem>(p_node)) {
+        r_snapshot.transform_2d = canvas_item->get_transform();
+        r_snapshot.visible = canvas_item->is_visible();
+        r_snapshot.canvas_item = canvas_item->get_canvas_item();
+        if (const Node2D *parent = Object::cast_to<Node2D>(p_node->get_parent())) {
+            r_snapshot.parent_canvas_item = parent->get_canvas_item();
+        }
+    }
+
+    // Keep in sync with create_entity(); every 2D creator takes a CanvasItem
+    if (NavigationAgent3D *nav_agent_3d = Object::cast_to<NavigationAgent3D>(p_node)) {
+        r_snapshot.kind = ConversionKind::NAV_AGENT_3D;
+        r_snapshot.server_id = nav_agent_3d->get_rid();
+    } else if (NavigationLink3D *nav_link_3d = Object::cast_to<NavigationLink3D>(p_node)) {
+        r_snapshot.kind = ConversionKind::NAV_LINK_3D;
+        r_snapshot.server_id = nav_link_3d->get_rid();
+    } else if (NavigationObstacle3D *nav_obstacle_3d = Object::cast_to<NavigationObstacle3D>(p_node)) {
+        r_snapshot.kind = ConversionKind::NAV_OBSTACLE_3D;
+        r_snapshot.server_id = nav_obstacle_3d->get_rid();
+    } else if (NavigationRegion3D *nav_region_3d = Object::cast_to<NavigationRegion3D>(p_node)) {
+        r_snapshot.kind = ConversionKind::NAV_REGION_3D;
+        r_snapshot.server_id = nav_region_3d->get_rid();
+    } else if (NavigationAgent2D *nav_agent_2d = Object::cast_to<NavigationAgent2D>(p_node)) {
+        r_snapshot.kind = ConversionKind::NAV_AGENT_2D;
+        r_snapshot.server_id = nav_agent_2d->get_rid();
+    } else if (NavigationLink2D *nav_link_2d = Object::cast_to<NavigationLink2D>(p_node)) {
+        r_snapshot.kind = ConversionKind::NAV_LINK_2D;
+        r_snapshot.server_id = nav_link_2d->get_rid();
+    } else if (NavigationObstacle2D *nav_obstacle_2d = Object::cast_to<NavigationObstacle2D>(p_node)) {
+        r_snapshot.kind = ConversionKind::NAV_OBSTACLE_2D;
+        r_snapshot.server_id = nav_obstacle_2d->get_rid();
+    } else if (NavigationRegion2D *nav_region_2d = Object::cast_to<NavigationRegion2D>(p_node)) {
+        r_snapshot.kind = ConversionKind::NAV_REGION_2D;
+        r_snapshot.server_id = nav_region_2d->get_rid();
+    } else if (Area3D *area_3d = Object::cast_to<Area3D>(p_node)) {
+        r_snapshot.kind = ConversionKind::AREA_3D;
+        r_snapshot.server_id = area_3d->get_rid();
+    } else if (PhysicsBody3D *body_3d = Object::cast_to<PhysicsBody3D>(p_node)) {
+        // RigidBody3D and the other bodies only differ in their creator's name
+        r_snapshot.kind = ConversionKind::BODY_3D;
+        r_snapshot.server_id = body_3d->get_rid();
+    } else if (Joint3D *joint_3d = Object::cast_to<Joint3D>(p_node)) {
+        r_snapshot.kind = ConversionKind::JOINT_3D;
+        r_snapshot.server_id = joint_3d->get_rid();
+    } else if (SoftBody3D *soft_body_3d = Object::cast_to<SoftBody3D>(p_node)) {
+        r_snapshot.kind = ConversionKind::SOFT_BODY_3D;
+        r_snapshot.server_id = soft_body_3d->get_physics_rid();
+    } else if (Area2D *area_2d = Object::cast_to<Area2D>(p_node)) {
+        r_snapshot.kind = ConversionKind::AREA_2D;
+        r_snapshot.server_id = area_2d->get_rid();
+    } else if (PhysicsBody2D *body_2d = Object::cast_to<PhysicsBody2D>(p_node)) {
+        r_snapshot.kind = ConversionKind::BODY_2D;
+        r_snapshot.server_id = body_2d->get_rid();
+    } else if (Joint2D *joint_2d = Object::cast_to<Joint2D>(p_node)) {
+        r_snapshot.kind = ConversionKind::JOINT_2D;
+        r_snapshot.server_id = joint_2d->get_rid();
+    } else if (MeshInstance3D *mesh_instance_3d = Object::cast_to<MeshInstance3D>(p_node)) {
+        r_snapshot.kind = ConversionKind::MESH_INSTANCE_3D;
+        const Ref<Mesh> mesh = mesh_instance_3d->get_mesh();
+        if (mesh.is_valid()) {
+            r_snapshot.server_id = mesh_instance_3d->get_base();
+            r_snapshot.resources.push_back(mesh);
+            for (int i = 0; i < mesh->get_surface_count(); ++i) {
+                const Ref<Material> material = mesh->surface_get_material(i);
+                r_snapshot.material_ids.push_back(material.is_valid() ? material->get_rid() : RID());
+            }
+        }
+    } else if (Object::cast_to<MultiMeshInstance3D>(p_node)) {
+        r_snapshot.kind = ConversionKind::CREATOR;
+    } else if (GPUParticles3D *particles_3d = Object::cast_to<GPUParticles3D>(p_node)) {
+        r_snapshot.kind = ConversionKind::PARTICLES_3D;
+        r_snapshot.server_id = particles_3d->get_base();
+    } else if (ReflectionProbe *reflection_probe = Object::cast_to<ReflectionProbe>(p_node)) {
+        r_snapshot.kind = ConversionKind::REFLECTION_PROBE;
+        r_snapshot.server_id = reflection_probe->get_base();
+    } else if (Skeleton3D *skeleton_3d = Object::cast_to<Skeleton3D>(p_node)) {
+        r_snapshot.kind = ConversionKind::SKELETON_3D;
+        r_snapshot.bone_poses_3d.resize(skeleton_3d->get_bone_count());
+        for (int i = 0; i < skeleton_3d->get_bone_count(); ++i) {
+            r_snapshot.bone_poses_3d.set(i, skeleton_3d->get_bone_global_pose(i));
+        }
+    } else if (WorldEnvironment *world_environment = Object::cast_to<WorldEnvironment>(p_node)) {
+        r_snapshot.kind = ConversionKind::ENVIRONMENT;
+        const Ref<Environment> environment = world_environment->get_environment();
+        if (environment.is_valid()) {
+            r_snapshot.server_id = environment->get_rid();
+            r_snapshot.resources.push_back(environment);
+        }
+    } else if (Object::cast_to<Camera3D>(p_node)) {
+        r_snapshot.kind = ConversionKind::CREATOR;
+    } else if (DirectionalLight3D *directional_light_3d = Object::cast_to<DirectionalLight3D>(p_node)) {
+        r_snapshot.kind = ConversionKind::DIRECTIONAL_LIGHT_3D;
+        r_snapshot.server_id = directional_light_3d->get_base();
+        r_snapshot.instance_id = directional_light_3d->get_instance();
+    } else if (OmniLight3D *omni_light_3d = Object::cast_to<OmniLight3D>(p_node)) {
+        r_snapshot.kind = ConversionKind::OMNI_LIGHT_3D;
+        r_snapshot.server_id = omni_light_3d->get_base();
+        r_snapshot.instance_id = omni_light_3d->get_instance();
+    } else if (SpotLight3D *spot_light_3d = Object::cast_to<SpotLight3D>(p_node)) {
+        r_snapshot.kind = ConversionKind::SPOT_LIGHT_3D;
+        r_snapshot.server_id = spot_light_3d->get_base();
+    } else if (Viewport *viewport = Object::cast_to<Viewport>(p_node)) {
+        r_snapshot.kind = ConversionKind::VIEWPORT;
+        r_snapshot.server_id = viewport->get_viewport_rid();
+    } else if (VoxelGI *voxel_gi = Object::cast_to<VoxelGI>(p_node)) {
+        r_snapshot.kind = ConversionKind::VOXEL_GI;
+        r_snapshot.server_id = voxel_gi->get_base();
+    } else if (MeshInstance2D *mesh_instance_2d = Object::cast_to<MeshInstance2D>(p_node)) {
+        const Ref<Mesh> mesh = mesh_instance_2d->get_mesh();
+        // Without a mesh it is a plain canvas item
+        r_snapshot.kind = mesh.is_valid() ? ConversionKind::MESH_INSTANCE_2D : ConversionKind::CANVAS_ITEM;
+        if (mesh.is_valid()) {
+            r_snapshot.server_id = mesh->get_rid();
+            r_snapshot.resources.push_back(mesh);
+            for (int i = 0; i < mesh->get_surface_count(); ++i) {
+                const Ref<Material> material = mesh->surface_get_material(i);
+                r_snapshot.material_ids.push_back(material.is_valid() ? material->get_rid() : RID());
+                if (material.is_valid()) {
+                    r_snapshot.resources.push_back(material);
+                }
+            }
+        }
+    } else if (Object::cast_to<MultiMeshInstance2D>(p_node)) {
+        r_snapshot.kind = ConversionKind::CREATOR;
+    } else if (Object::cast_to<Camera2D>(p_node)) {
+        r_snapshot.kind = ConversionKind::CAMERA_2D;
+    } else if (Object::cast_to<DirectionalLight2D>(p_node) || Object::cast_to<PointLight2D>(p_node)) {
+        r_snapshot.kind = ConversionKind::CREATOR;
+    } else if (Skeleton2D *skeleton_2d = Object::cast_to<Skeleton2D>(p_node)) {
+        r_snapshot.kind = ConversionKind::SKELETON_2D;
+        r_snapshot.bone_poses_2d.resize(skeleton_2d->get_bone_count());
+        for (int i = 0; i < skeleton_2d->get_bone_count(); ++i) {
+            const Bone2D *bone = skeleton_2d->get_bone(i);
+            r_snapshot.bone_poses_2d.set(i, bone ? bone->get_transform() : Transform2D());
+        }
+    } else if (Object::cast_to<LightOccluder2D>(p_node) || Object::cast_to<GPUParticles2D>(p_node)) {
+        r_snapshot.kind = ConversionKind::CREATOR;
+    } else if (Object::cast_to<CanvasItem>(p_node)) {
+        r_snapshot.kind = ConversionKind::CANVAS_ITEM;
+    }
+
+    switch (r_snapshot.kind) {
+        case ConversionKind::GENERIC:
+        case ConversionKind::SKELETON_3D:
+        case ConversionKind::CAMERA_2D:
+        case ConversionKind::SKELETON_2D:
+        case ConversionKind::CANVAS_ITEM:
+        case ConversionKind::CREATOR:
+            break;
+        default:
+            // The creator reports why the server object is missing
+            if (!r_snapshot.server_id.is_valid()) {
+                r_snapshot.kind = ConversionKind::CREATOR;
+            }
+            break;
+    }
+}
+
+void *SceneObjectUtility::_stage_conversion(void *p_job) {
+    ConversionJob *job = static_cast<ConversionJob *>(p_job);
+    const int64_t job_id = job->id;
+    const uint32_t total = job->snapshots.size();
+    job->staged.resize(total);
+    for (uint32_t i = 0; i < total; i++) {
+        const NodeSnapshot &snapshot = job->snapshots[i];
+        if (snapshot.kind == ConversionKind::CREATOR) {
+            continue;
+        }
+        StagedNode &staged = job->staged[i];
+        // The instance id keeps names unique without touching the shared RNG
+        staged.name = (snapshot.name + "_" + itos(snapshot.node_id)).ascii();
+        staged.object_instance.object_instance_id = snapshot.node_id;
+        staged.scene_node.node_id = snapshot.node_id;
+        staged.scene_node.class_name = snapshot.class_name;
+        staged.transform_3d.transform = snapshot.transform_3d;
+        staged.transform_2d.transform = snapshot.transform_2d;
+        staged.visibility.visible = snapshot.visible;
+        switch (snapshot.kind) {
+            case ConversionKind::MESH_INSTANCE_3D:
+            case ConversionKind::MESH_INSTANCE_2D:
+                staged.mesh.mesh_id = snapshot.server_id;
+                staged.mesh.material_ids = snapshot.material_ids;
+                // RenderingServer queries are thread safe, so they run here
+                if (snapshot.kind == ConversionKind::MESH_INSTANCE_2D) {
+                    staged.mesh.custom_aabb = RS::get_singleton()->mesh_get_custom_aabb(snapshot.server_id);
+                }
+                // MeshInstance2D entities carry their class name for reflection
+                staged.canvas_item.item_name = snapshot.class_name;
+                break;
+            case ConversionKind::CANVAS_ITEM:
+                staged.canvas_item.item_name = snapshot.name;
+                break;
+            case ConversionKind::SKELETON_3D:
+                staged.skeleton.bone_count = snapshot.bone_poses_3d.size();
+                break;
+            case ConversionKind::SKELETON_2D:
+                staged.skeleton.bone_count = snapshot.bone_poses_2d.size();
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Unpooled: a full pool drops commands, and the commit must not be lost
+    job->commands->enqueue_command_unpooled([job_id]() {
+        if (instance) {
+            instance->_commit_conversion(job_id);
+        }
+    });
+    return nullptr;
+}
+
+void SceneObjectUtility::_commit_conversion(int64_t p_job_id) {
+    ConversionJob **job_ptr = conversion_jobs.getptr(p_job_id);
+    if (!job_ptr) {
+        // Cancelled by cancel_world_conversions()
+        return;
+    }
+    ConversionJob *job = *job_ptr;
+    if (job->task) {
+        // Queueing the commit is the task's last step, so this only reaps it
+        FlecsWorkerPool::get_singleton()->join(job->task);
+        job->task = 0;
+    }
+
+    FlecsServer *server = FlecsServer::get_singleton();
+    flecs::world *flecs_world = server ? server->_get_world(job->world_id) : nullptr;
+    if (!flecs_world) {
+        _finish_conversion(job, "world was freed before the conversion was committed");
+        return;
+    }
+    if (flecs_world->is_deferred()) {
+        // ecs_bulk_init needs direct table access
+        _finish_conversion(job, "cannot commit while the world is deferred");
+        return;
+    }
+
+    const uint32_t total = job->snapshots.size();
+    const uint32_t begin = job->committed;
+    const uint32_t end = MIN(total, begin + (uint32_t)MAX(conversion_budget, 1));
+
+    // The slice's generic nodes land in the SceneNodeComponent table with one move
+    LocalVector<uint32_t> generic_nodes;
+    LocalVector<SceneNodeComponent> generic_components;
+    for (uint32_t i = begin; i < end; i++) {
+        if (job->snapshots[i].kind == ConversionKind::GENERIC && ObjectDB::get_instance(job->snapshots[i].node_id)) {
+            generic_nodes.push_back(i);
+            generic_components.push_back(job->staged[i].scene_node);
+        }
+    }
+    LocalVector<RID> slice_entities;
+    slice_entities.resize(end - begin);
+    if (!generic_nodes.is_empty()) {
+        ecs_bulk_desc_t bulk_desc = {};
+        bulk_desc.count = generic_nodes.size();
+        bulk_desc.ids[0] = flecs_world->component<SceneNodeComponent>().id();
+        void *bulk_data[] = { generic_components.ptr() };
+        bulk_desc.data = bulk_data;
+        const ecs_entity_t *created = ecs_bulk_init(flecs_world->c_ptr(), &bulk_desc);
+        if (!created) {
+            ERR_PRINT("SceneObjectUtility::convert_scene_async: ecs_bulk_init failed");
+        } else {
+            // The returned array is invalidated by the name writes below
+            LocalVector<flecs::entity_t> created_ids;
+            created_ids.resize(generic_nodes.size());
+            memcpy(created_ids.ptr(), created, sizeof(flecs::entity_t) * generic_nodes.size());
+            for (uint32_t g = 0; g < generic_nodes.size(); g++) {
+                flecs::entity e = flecs_world->entity(created_ids[g]);
+                e.set_name(job->staged[generic_nodes[g]].name.get_data());
+                slice_entities[generic_nodes[g] - begin] = server->_create_rid_for_entity(job->world_id, e);
+            }
+        }
+    }
+
+    const RID scenario_id = flecs_world->has<World3DComponent>() ? flecs_world->get<World3DComponent>().scenario_id : RID();
+    for (uint32_t i = begin; i < end; i++) {
+        const NodeSnapshot &snapshot = job->snapshots[i];
+        // Nodes freed since the snapshot are skipped
+        Node *node = Object::cast_to<Node>(ObjectDB::get_instance(snapshot.node_id));
+        if (!node) {
+            continue;
+        }
+        if (snapshot.kind == ConversionKind::CREATOR) {
+            job->entities.append_array(create_entity(job->world_id, node));
+            continue;
+        }
+        const RID entity = snapshot.kind == ConversionKind::GENERIC
+                ? slice_entities[i - begin]
+                : _commit_staged_node(job, i, node, scenario_id);
+        if (!entity.is_valid()) {
+            continue;
+        }
+        const RID script_entity = snapshot.has_script ? get_node_script(job->world_id, node, entity) : RID();
+        // Same order as create_entity(): generic nodes list their script first,
+        // canvas items leave it out
+        if (snapshot.kind == ConversionKind::GENERIC && script_entity.is_valid()) {
+            job->entities.append(script_entity);
+        }
+        job->entities.append(entity);
+        if (snapshot.kind != ConversionKind::GENERIC && snapshot.kind != ConversionKind::CANVAS_ITEM && script_entity.is_valid()) {
+            job->entities.append(script_entity);
+        }
+    }
+
+    job->committed = end;
+    if (end < total) {
+        emit_signal(SNAME("conversion_progress"), p_job_id, end, total);
+        // Queued while the handler runs, so the next slice waits for the next frame
+        job->commands->enqueue_command_unpooled([p_job_id]() {
+            if (instance) {
+                instance->_commit_conversion(p_job_id);
+            }
+        });
+        return;
+    }
+    _finish_conversion(job);
+}
+
+RID SceneObjectUtility::_commit_staged_node(const ConversionJob *p_job, uint32_t p_index, Node *p_node, const RID &p_scenario_id) {
+    const NodeSnapshot &snapshot = p_job->snapshots[p_index];
+    const StagedNode &staged = p_job->staged[p_index];
+    FlecsServer *server = FlecsServer::get_singleton();
+    flecs::world *flecs_world = server->_get_world(p_job->world_id);
+    RenderingServer *rendering_server = RS::get_singleton();
+
+    if (snapshot.kind == ConversionKind::MESH_INSTANCE_3D && !p_scenario_id.is_valid()) {
+        ERR_PRINT("SceneObjectUtility::convert_scene_async: the world has no scenario for " + snapshot.name);
+        return RID();
+    }
+    for (const Ref<Resource> &resource : snapshot.resources) {
+        server->add_to_ref_storage(resource, p_job->world_id);
+    }
+    server->add_to_node_storage(p_node, p_job->world_id);
+
+    flecs::entity e = flecs_world->entity();
+    // Only the server RIDs are made here; everything else was staged
+    switch (snapshot.kind) {
+        case ConversionKind::NAV_AGENT_3D:
+            _set_server_rid(e, &NavAgent3DComponent::agent_id, snapshot.server_id);
+            break;
+        case ConversionKind::NAV_LINK_3D:
+            _set_server_rid(e, &NavLink3DComponent::link_id, snapshot.server_id);
+            break;
+        case ConversionKind::NAV_OBSTACLE_3D:
+            _set_server_rid(e, &NavObstacle3DComponent::obstacle_id, snapshot.server_id);
+            break;
+        case ConversionKind::NAV_REGION_3D:
+            _set_server_rid(e, &NavRegion3DComponent::region_id, snapshot.server_id);
+            break;
+        case ConversionKind::NAV_AGENT_2D:
+            _set_server_rid(e, &NavAgent2DComponent::agent_id, snapshot.server_id);
+            break;
+        case ConversionKind::NAV_LINK_2D:
+            _set_server_rid(e, &NavLink2DComponent::link_id, snapshot.server_id);
+            break;
+        case ConversionKind::NAV_OBSTACLE_2D:
+            _set_server_rid(e, &NavObstacle2DComponent::obstacle_id, snapshot.server_id);
+            break;
+        case ConversionKind::NAV_REGION_2D:
+            _set_server_rid(e, &NavRegion2DComponent::region_id, snapshot.server_id);
+            break;
+        case ConversionKind::AREA_3D:
+            _set_server_rid(e, &Area3DComponent::area_id, snapshot.server_id);
+            break;
+        case ConversionKind::BODY_3D:
+            _set_server_rid(e, &Body3DComponent::body_id, snapshot.server_id);
+            break;
+        case ConversionKind::JOINT_3D:
+            _set_server_rid(e, &Joint3DComponent::joint_id, snapshot.server_id);
+            break;
+        case ConversionKind::SOFT_BODY_3D:
+            _set_server_rid(e, &SoftBody3DComponent::soft_body_id, snapshot.server_id);
+            break;
+        case ConversionKind::AREA_2D:
+            _set_server_rid(e, &Area2DComponent::area_id, snapshot.server_id);
+            break;
+        case ConversionKind::BODY_2D:
+            _set_server_rid(e, &Body2DComponent::body_id, snapshot.server_id);
+            break;
+        case ConversionKind::JOINT_2D:
+            _set_server_rid(e, &Joint2DComponent::joint_id, snapshot.server_id);
+            break;
+        case ConversionKind::VIEWPORT:
+            _set_server_rid(e, &ViewportComponent::viewport_id, snapshot.server_id);
+            break;
+        case ConversionKind::ENVIRONMENT:
+            _set_server_rid(e, &EnvironmentComponent::environment_id, snapshot.server_id);
+            break;
+        case ConversionKind::MESH_INSTANCE_3D:
+            e.set<MeshComponent>(staged.mesh)
+                    .set<Transform3DComponent>(staged.transform_3d)
+                    .set<VisibilityComponent>(staged.visibility)
+                    .add<DirtyTransform>();
+            _set_server_rid(e, &RenderInstanceComponent::instance_id, rendering_server->instance_create2(snapshot.server_id, p_scenario_id));
+            break;
+        case ConversionKind::PARTICLES_3D:
+            _set_server_rid(e, &ParticlesComponent::particles_id, snapshot.server_id);
+            _set_server_rid(e, &RenderInstanceComponent::instance_id, rendering_server->instance_create2(snapshot.server_id, p_scenario_id));
+            e.set<Transform3DComponent>(staged.transform_3d).set<VisibilityComponent>(staged.visibility).add<DirtyTransform>();
+            break;
+        case ConversionKind::REFLECTION_PROBE:
+            _set_server_rid(e, &ReflectionProbeComponent::probe_id, snapshot.server_id);
+            _set_server_rid(e, &RenderInstanceComponent::instance_id, rendering_server->instance_create2(snapshot.server_id, p_scenario_id));
+            e.set<Transform3DComponent>(staged.transform_3d).add<DirtyTransform>();
+            break;
+        case ConversionKind::VOXEL_GI:
+            _set_server_rid(e, &VoxelGIComponent::voxel_gi_id, snapshot.server_id);
+            _set_server_rid(e, &RenderInstanceComponent::instance_id, rendering_server->instance_create2(snapshot.server_id, p_scenario_id));
+            e.set<Transform3DComponent>(staged.transform_3d).set<VisibilityComponent>(staged.visibility).add<DirtyTransform>();
+            break;
+        case ConversionKind::SPOT_LIGHT_3D:
+            _set_server_rid(e, &SpotLightComponent::light_id, snapshot.server_id);
+            _set_server_rid(e, &RenderInstanceComponent::instance_id, rendering_server->instance_create2(snapshot.server_id, p_scenario_id));
+            e.set<Transform3DComponent>(staged.transform_3d).set<VisibilityComponent>(staged.visibility).add<DirtyTransform>();
+            break;
+        case ConversionKind::DIRECTIONAL_LIGHT_3D:
+            // Lights keep the scenario instance their node already made
+            _set_server_rid(e, &DirectionalLight3DComponent::light_id, snapshot.server_id);
+            _set_server_rid(e, &RenderInstanceComponent::instance_id, snapshot.instance_id);
+            e.set<Transform3DComponent>(staged.transform_3d).set<VisibilityComponent>(staged.visibility).add<DirtyTransform>();
+            break;
+        case ConversionKind::OMNI_LIGHT_3D:
+            _set_server_rid(e, &OmniLightComponent::light_id, snapshot.server_id);
+            _set_server_rid(e, &RenderInstanceComponent::instance_id, snapshot.instance_id);
+            e.set<Transform3DComponent>(staged.transform_3d).set<VisibilityComponent>(staged.visibility).add<DirtyTransform>();
+            break;
+        case ConversionKind::SKELETON_3D: {
+            const RID skeleton_id = rendering_server->skeleton_create();
+            rendering_server->skeleton_allocate_data(skeleton_id, snapshot.bone_poses_3d.size(), false);
+            for (int i = 0; i < snapshot.bone_poses_3d.size(); ++i) {
+                rendering_server->skeleton_bone_set_transform(skeleton_id, i, snapshot.bone_poses_3d[i]);
+            }
+            SkeletonComponent skeleton_component = staged.skeleton;
+            skeleton_component.skeleton_id = skeleton_id;
+            e.set<SkeletonComponent>(skeleton_component)
+                    .set<Transform3DComponent>(staged.transform_3d)
+                    .add<DirtyTransform>();
+            _set_server_rid(e, &RenderInstanceComponent::instance_id, rendering_server->instance_create2(skeleton_id, p_scenario_id));
+        } break;
+        case ConversionKind::SKELETON_2D: {
+            const RID skeleton_id = rendering_server->skeleton_create();
+            rendering_server->skeleton_allocate_data(skeleton_id, snapshot.bone_poses_2d.size(), false);
+            for (int i = 0; i < snapshot.bone_poses_2d.size(); ++i) {
+                rendering_server->skeleton_bone_set_transform_2d(skeleton_id, i, snapshot.bone_poses_2d[i]);
+            }
+            SkeletonComponent skeleton_component = staged.skeleton;
+            skeleton_component.skeleton_id = skeleton_id;
+            e.set<SkeletonComponent>(skeleton_component)
+                    .set<Transform2DComponent>(staged.transform_2d)
+                    .set<VisibilityComponent>(staged.visibility)
+                    .add<DirtyTransform>();
+        } break;
+        case ConversionKind::CAMERA_2D: {
+            const RID camera_id = rendering_server->camera_create();
+            if (!camera_id.is_valid()) {
+                ERR_PRINT("SceneObjectUtility::convert_scene_async: camera_create failed for " + snapshot.name);
+                e.destruct();
+                return RID();
+            }
+            _set_server_rid(e, &CameraComponent::camera_id, camera_id);
+            e.set<Transform2DComponent>(staged.transform_2d).add<DirtyTransform>();
+        } break;
+        case ConversionKind::MESH_INSTANCE_2D:
+            if (snapshot.parent_canvas_item.is_valid()) {
+                rendering_server->canvas_item_set_parent(snapshot.canvas_item, snapshot.parent_canvas_item);
+            }
+            e.set<MeshComponent>(staged.mesh)
+                    .set<CanvasItemComponent>(staged.canvas_item)
+                    .set<Transform2DComponent>(staged.transform_2d)
+                    .set<VisibilityComponent>(staged.visibility)
+                    .add<DirtyTransform>();
+            break;
+        case ConversionKind::CANVAS_ITEM:
+            if (snapshot.parent_canvas_item.is_valid()) {
+                rendering_server->canvas_item_set_parent(snapshot.canvas_item, snapshot.parent_canvas_item);
+            }
+            e.set<CanvasItemComponent>(staged.canvas_item)
+                    .set<Transform2DComponent>(staged.transform_2d)
+                    .set<VisibilityComponent>(staged.visibility)
+                    .add<DirtyTransform>();
+            break;
+        default:
+            break;
+    }
+    e.set<ObjectInstanceComponent>(staged.object_instance);
+    e.set_name(staged.name.get_data());
+    return server->_create_rid_for_entity(p_job->world_id, e);
+}
+
+void SceneObjectUtility::_finish_conversion(ConversionJob *p_job, const String &p_error) {
+    const int64_t job_id = p_job->id;
+    const RID world_id = p_job->world_id;
+    const TypedArray<RID> entities = p_job->entities;
+    conversion_jobs.erase(job_id);
+    memdelete(p_job);
+    if (!p_error.is_empty()) {
+        ERR_PRINT("SceneObjectUtility::convert_scene_async: " + p_error);
+    }
+
+    // The handler only lives as long as the world has conversions, so it does
+    // not keep the world from being forked
+    bool world_has_jobs = false;
+    for (const KeyValue<int64_t, ConversionJob *> &kv : conversion_jobs) {
+        world_has_jobs = world_has_jobs || kv.value->world_id == world_id;
+    }
+    FlecsServer *server = FlecsServer::get_singleton();
+    if (!world_has_jobs && server && server->_get_world(world_id)) {
+        server->unregister_command_handler(world_id, conversion_command_handler_name);
+    }
+    emit_signal(SNAME("conversion_completed"), job_id, entities, p_error);
+}
+
+void SceneObjectUtility::cancel_world_conversions(const RID &world_id) {
+    if (!instance) {
+        return;
+    }
+    LocalVector<ConversionJob *> cancelled;
+    for (const KeyValue<int64_t, ConversionJob *> &kv : instance->conversion_jobs) {
+        if (kv.value->world_id == world_id) {
+            cancelled.push_back(kv.value);
+        }
+    }
+    for (ConversionJob *job : cancelled) {
+        if (job->task) {
+            // The staged commit it queues is never run
+            FlecsWorkerPool::get_singleton()->join(job->task);
+            job->task = 0;
+        }
+        instance->_finish_conversion(job, "world was freed before the conversion was committed");
+    }
+}
+
+void SceneObjectUtility::set_conversion_budget(int p_nodes_per_frame) {
+    if (p_nodes_per_frame < 1) {
+        ERR_PRINT("SceneObjectUtility::set_conversion_budget: budget must be at least 1");
+        return;
+    }
+    conversion_budget = p_nodes_per_frame;
+}
+
 void SceneObjectUtility::_bind_methods() {
     ClassDB::bind_static_method(get_class_static(), "get_singleton", &SceneObjectUtility::get_singleton);
     ClassDB::bind_method(D_METHOD("create_entities_from_scene", "world_id", "tree"), &SceneObjectUtility::create_entities_from_scene);
     ClassDB::bind_method(D_METHOD("create_entities", "world_id", "base_node", "entities", "current_depth", "max_depth"), &SceneObjectUtility::create_entities, DEFVAL(0), DEFVAL(10000));
     ClassDB::bind_method(D_METHOD("create_entity", "world_id", "node"), &SceneObjectUtility::create_entity);
     ClassDB::bind_method(D_METHOD("get_node_script", "world_id", "node", "node_entity"), &SceneObjectUtility::get_node_script);
+    ClassDB::bind_method(D_METHOD("convert_scene_async", "world_id", "root", "max_depth"), &SceneObjectUtility::convert_scene_async, DEFVAL(10000));
+    ClassDB::bind_method(D_METHOD("get_pending_conversion_count"), &SceneObjectUtility::get_pending_conversion_count);
+    ClassDB::bind_method(D_METHOD("set_conversion_budget", "nodes_per_frame"), &SceneObjectUtility::set_conversion_budget);
+    ClassDB::bind_method(D_METHOD("get_conversion_budget"), &SceneObjectUtility::get_conversion_budget);
+
+    ADD_SIGNAL(MethodInfo("conversion_progress", PropertyInfo(Variant::INT, "job_id"), PropertyInfo(Variant::INT, "committed_nodes"), PropertyInfo(Variant::INT, "total_nodes")));
+    ADD_SIGNAL(MethodInfo("conversion_completed", PropertyInfo(Variant::INT, "job_id"), PropertyInfo(Variant::ARRAY, "entities"), PropertyInfo(Variant::STRING, "error")));
 
 }
 
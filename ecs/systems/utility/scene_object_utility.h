@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/object/object.h"
+#include "core/templates/hash_map.h"
 #include "scene/main/scene_tree.h"
 #include "core/variant/typed_array.h"
 #include <cassert>
@@ -28,6 +29,8 @@
  * 
  * @note This class uses a singleton pattern and is not thread-safe.
  * @note Entity creation should be done on the main thread due to Godot API constraints.
+ *       convert_scene_async() stages the per-node work on a worker and spreads
+ *       the commit over the following progressed frames.
  * 
  * @example
  * ```
@@ -41,9 +44,32 @@ class SceneObjectUtility : public Object {
 	GDCLASS(SceneObjectUtility, Object)
 private:
 	static inline SceneObjectUtility* instance = nullptr;
+
+	struct NodeSnapshot;
+	struct ConversionJob;
+	HashMap<int64_t, ConversionJob *> conversion_jobs;
+	int64_t next_conversion_job_id = 1;
+	int conversion_budget = 256;
+
+	// Reads what the conversion needs from a node; calling thread only, since
+	// Node and Resource getters are not thread safe
+	static void _snapshot_node(Node *p_node, NodeSnapshot &r_snapshot);
+	// Worker task: builds every node's name and components from its snapshot,
+	// querying the RenderingServer for what the snapshot leaves out
+	static void *_stage_conversion(void *p_job);
+	// Runs at the world's sync point and commits up to conversion_budget
+	// nodes, queueing itself again for the next frame until the job is done
+	void _commit_conversion(int64_t p_job_id);
+	// Makes the node's server RIDs and its entity from the staged components
+	RID _commit_staged_node(const ConversionJob *p_job, uint32_t p_index, Node *p_node, const RID &p_scenario_id);
+	// Drops the job and emits conversion_completed; p_error is empty on success
+	void _finish_conversion(ConversionJob *p_job, const String &p_error = String());
 public:
+	// Name of the per-world CommandHandler staged conversions are committed through
+	constexpr static char conversion_command_handler_name[] = "SceneConversion";
+
 	SceneObjectUtility() = default;
-	~SceneObjectUtility() = default;
+	~SceneObjectUtility();
 	
 	/**
 	 * @brief Creates ECS entities from all root nodes in a SceneTree.
@@ -125,6 +151,53 @@ public:
 	 * @note Establishes a Flecs ChildOf relationship between script and node entity.
 	 */
 	RID get_node_script(const RID &world_id, const Node *node, const RID &node_entity);
+
+	/**
+	 * @brief Converts a node and its descendants without stalling the calling frame.
+	 * 
+	 * The walk snapshots each node on the calling thread: class, name, script,
+	 * transform, and the server RIDs, mesh and materials it already owns. The
+	 * walk cannot leave the calling thread, as scene tree and Resource access
+	 * is not thread safe. A worker task builds the entity names and components
+	 * of every node from those snapshots, plus the RenderingServer queries they
+	 * need (mesh AABBs). The job is then committed through the world's
+	 * "SceneConversion" CommandHandler, at most get_conversion_budget() nodes
+	 * per progressed frame. The commit only makes the server RIDs the entities
+	 * need (scenario instances, skeletons, 2D cameras) and creates the entities;
+	 * generic nodes of a frame are created with a single bulk operation.
+	 * MultiMeshInstance, Camera3D, 2D lights, LightOccluder2D and GPUParticles2D
+	 * set up their server objects from many node properties or spawn several
+	 * entities, so they go through create_entity() within the same budget.
+	 * 
+	 * Entity names are the node name followed by "_" and the node's instance id.
+	 * Emits conversion_progress(job_id, committed_nodes, total_nodes) after each
+	 * frame that leaves nodes to commit, and conversion_completed(job_id, entities, error)
+	 * after the last one, both at the world's sync point. error is empty on
+	 * success; freeing the world first completes the job from free_world() with
+	 * an error and the entities committed so far. Entities come in the
+	 * same order as create_entities(), without the invalid RIDs it lists for
+	 * nodes that have no script.
+	 * 
+	 * @param world_id The RID of the Flecs world to create entities in
+	 * @param root The node to start from (included in the conversion)
+	 * @param max_depth Maximum depth below root (default: 10000)
+	 * @return int64_t Job id passed to the conversion signals, or -1 on error
+	 * 
+	 * @note Changes made to the nodes after the call are not picked up; nodes
+	 *       freed before their commit are skipped.
+	 * @note Nothing is committed until the world is progressed.
+	 */
+	int64_t convert_scene_async(const RID &world_id, Node *root, int max_depth = 10000);
+
+	/** @brief Fails every conversion into @p world_id; called by FlecsServer::free_world(). */
+	static void cancel_world_conversions(const RID &world_id);
+
+	/** @brief Returns how many conversions are staged or waiting for their commit. */
+	int get_pending_conversion_count() const { return conversion_jobs.size(); }
+
+	/** @brief Sets how many nodes a conversion commits per progressed frame (default: 256). */
+	void set_conversion_budget(int p_nodes_per_frame);
+	int get_conversion_budget() const { return conversion_budget; }
 	
 	/** @brief Binds methods for GDScript/engine reflection. */
 	static void _bind_methods();
@@ -0,0 +1,218 @@
+/**************************************************************************/
+/*  test_component_access_plan.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_COMPONENT_ACCESS_PLAN_H
+#define TEST_COMPONENT_ACCESS_PLAN_H
+
+#include "core/os/os.h"
+#include "modules/godot_turbo/ecs/components/all_components.h"
+#include "modules/godot_turbo/ecs/components/component_access_plan.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_server.h"
+#include "test_fixtures.h"
+#include "tests/test_macros.h"
+
+namespace TestComponentAccessPlan {
+
+using namespace TestFixtures;
+
+struct PlanTestBody {
+	Vector3 velocity;
+	float mass = 1.0f;
+	int32_t layer = 0;
+	bool sleeping = false;
+	Transform3D transform;
+};
+
+static void register_plan_test_body(flecs::world *world) {
+	world->component<PlanTestBody>()
+			.member<Vector3>("velocity")
+			.member<float>("mass")
+			.member<int32_t>("layer")
+			.member<bool>("sleeping")
+			.member<Transform3D>("transform");
+}
+
+TEST_SUITE("[Modules][GodotTurbo][ComponentAccessPlan]") {
+	TEST_CASE("[ComponentAccessPlan] Plan output matches the cursor walk") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+		register_plan_test_body(world);
+
+		PlanTestBody body;
+		body.velocity = Vector3(1, 2, 3);
+		body.mass = 4.5f;
+		body.layer = 7;
+		body.sleeping = true;
+		body.transform.origin = Vector3(9, 8, 7);
+		flecs::entity e = world->entity().set<PlanTestBody>(body);
+
+		std::shared_ptr<const FlecsReflection::AccessPlan> plan =
+				FlecsReflection::AccessPlanCache::get().get_plan(*world, world->id<PlanTestBody>());
+		REQUIRE(plan != nullptr);
+		CHECK(plan->is_struct);
+		CHECK(plan->members.size() == 5);
+
+		Dictionary from_plan = plan->to_dict(&e.get<PlanTestBody>());
+		Dictionary from_cursor = fixture.server->_component_to_dict_with_cursor(e, world->id<PlanTestBody>());
+		CHECK(from_plan == from_cursor);
+		CHECK(Vector3(from_plan["velocity"]) == body.velocity);
+		CHECK(int(from_plan["layer"]) == 7);
+		CHECK(bool(from_plan["sleeping"]));
+		CHECK(Transform3D(from_plan["transform"]).origin == body.transform.origin);
+	}
+
+	TEST_CASE("[ComponentAccessPlan] from_dict writes only present members") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+		register_plan_test_body(world);
+
+		std::shared_ptr<const FlecsReflection::AccessPlan> plan =
+				FlecsReflection::AccessPlanCache::get().get_plan(*world, world->id<PlanTestBody>());
+		REQUIRE(plan != nullptr);
+
+		PlanTestBody body;
+		body.mass = 2.0f;
+		Dictionary patch;
+		patch["velocity"] = Vector3(0, -9.8, 0);
+		patch["layer"] = 3;
+		plan->from_dict(&body, patch);
+
+		CHECK(body.velocity.is_equal_approx(Vector3(0, -9.8, 0)));
+		CHECK(body.layer == 3);
+		CHECK(body.mass == doctest::Approx(2.0f));
+	}
+
+	TEST_CASE("[ComponentAccessPlan] Runtime components get a plan and are invalidated on removal") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		Dictionary fields;
+		fields["health"] = 100;
+		fields["speed"] = 2.5;
+		RID type_rid = fixture.server->create_runtime_component(world_id, "PlanRuntimeStats", fields);
+		REQUIRE(type_rid.is_valid());
+
+		flecs::entity_t comp_id = fixture.server->_get_type_id(type_rid, world_id);
+		std::shared_ptr<const FlecsReflection::AccessPlan> first = FlecsReflection::AccessPlanCache::get().get_plan(*world, comp_id);
+		REQUIRE(first != nullptr);
+		CHECK(first->members.size() == 2);
+		// Cached: same plan instance on subsequent lookups
+		CHECK(FlecsReflection::AccessPlanCache::get().get_plan(*world, comp_id) == first);
+
+		// Deleting the type must not leave a stale layout behind
+		flecs::entity(world->c_ptr(), comp_id).destruct();
+		CHECK(FlecsReflection::AccessPlanCache::get().get_plan(*world, comp_id) == nullptr);
+	}
+
+	TEST_CASE("[ComponentAccessPlan] Worker threads read cached plans without registering components") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+		register_plan_test_body(world);
+		fixture.server->set_world_thread_count(world_id, 4);
+
+		const int count = 2000;
+		for (int i = 0; i < count; i++) {
+			world->entity().set<PlanTestBody>({});
+		}
+		const flecs::entity_t comp_id = world->id<PlanTestBody>();
+		REQUIRE(FlecsReflection::AccessPlanCache::get().get_plan(*world, comp_id) != nullptr);
+		const uint64_t builds = FlecsReflection::AccessPlanCache::get().get_build_count();
+		const uint64_t generation = FlecsReflection::AccessPlanCache::get().get_generation();
+		const int32_t component_count = world->count(flecs::Component);
+
+		std::atomic<int> serialized{ 0 };
+		world->system<const PlanTestBody>("PlanWorkerLookup")
+				.multi_threaded()
+				.each([&](flecs::iter &it, size_t, const PlanTestBody &body) {
+					std::shared_ptr<const FlecsReflection::AccessPlan> plan = FlecsReflection::AccessPlanCache::get().get_plan(it.world(), comp_id);
+					if (plan && plan->to_dict(&body).size() == 5) {
+						serialized.fetch_add(1, std::memory_order_relaxed);
+					}
+				});
+		fixture.server->progress_world(world_id, 0.016);
+
+		CHECK(serialized.load() == count);
+		CHECK(FlecsReflection::AccessPlanCache::get().get_build_count() == builds);
+		CHECK(FlecsReflection::AccessPlanCache::get().get_generation() == generation);
+		CHECK(world->count(flecs::Component) == component_count);
+
+		FlecsReflection::AccessPlanCache::get().invalidate(*world);
+		CHECK(FlecsReflection::AccessPlanCache::get().get_generation() > generation);
+	}
+
+	TEST_CASE("[ComponentAccessPlan][Benchmark] Plan vs cursor serialization") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+		register_plan_test_body(world);
+
+		const flecs::entity_t comp_id = world->id<PlanTestBody>();
+		flecs::entity e = world->entity().set<PlanTestBody>({});
+		const int iterations = 20000;
+
+		// Warm the plan so the build isn't part of the measurement
+		std::shared_ptr<const FlecsReflection::AccessPlan> plan = FlecsReflection::AccessPlanCache::get().get_plan(*world, comp_id);
+		REQUIRE(plan != nullptr);
+
+		uint64_t t0 = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < iterations; i++) {
+			Dictionary d = fixture.server->_component_to_dict_with_cursor(e, comp_id);
+		}
+		const uint64_t cursor_usec = OS::get_singleton()->get_ticks_usec() - t0;
+
+		t0 = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < iterations; i++) {
+			Dictionary d = FlecsReflection::Registry::get().serialize(e, comp_id);
+		}
+		const uint64_t plan_usec = OS::get_singleton()->get_ticks_usec() - t0;
+
+		MESSAGE(vformat("serialize x%d: cursor %d usec, plan %d usec (%.2fx)", iterations, cursor_usec, plan_usec,
+				plan_usec > 0 ? double(cursor_usec) / double(plan_usec) : 0.0));
+		CHECK(FlecsReflection::Registry::get().serialize(e, comp_id) == fixture.server->_component_to_dict_with_cursor(e, comp_id));
+	}
+}
+
+} // namespace TestComponentAccessPlan
+
+#endif // TEST_COMPONENT_ACCESS_PLAN_H
@@ -0,0 +1,96 @@
+/**************************************************************************/
+/*  test_component_name_cache.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_COMPONENT_NAME_CACHE_H
+#define TEST_COMPONENT_NAME_CACHE_H
+
+#include "modules/godot_turbo/ecs/components/all_components.h"
+#include "modules/godot_turbo/ecs/flecs_types/component_name_cache.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_server.h"
+#include "test_fixtures.h"
+#include "tests/test_macros.h"
+
+namespace TestComponentNameCache {
+
+using namespace TestFixtures;
+
+TEST_SUITE("[Modules][GodotTurbo][ComponentNameCache]") {
+	TEST_CASE("[ComponentNameCache] Repeated lookups hit the cache") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		ComponentNameCache &cache = ComponentNameCache::get();
+		const StringName name = "Transform3DComponent";
+		const flecs::entity_t expected = world->component<Transform3DComponent>().id();
+		CHECK(cache.lookup(*world, name) == expected);
+
+		const uint64_t misses = cache.get_miss_count();
+		RID entity = fixture.server->create_entity(world_id);
+		Dictionary data;
+		data["transform"] = Transform3D();
+		for (int i = 0; i < 100; i++) {
+			fixture.server->set_component(entity, name, data);
+			CHECK(fixture.server->has_component(entity, name));
+		}
+		CHECK(cache.get_miss_count() == misses);
+
+		// Unknown names are not cached as failures
+		CHECK(cache.lookup(*world, StringName("NoSuchComponent")) == 0);
+	}
+
+	TEST_CASE("[ComponentNameCache] Runtime components are cached and dropped on deletion") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		Dictionary fields;
+		fields["hp"] = 100;
+		RID type_id = fixture.server->create_runtime_component(world_id, "NameCacheHealth", fields);
+		REQUIRE(type_id.is_valid());
+
+		ComponentNameCache &cache = ComponentNameCache::get();
+		const uint64_t misses = cache.get_miss_count();
+		const flecs::entity_t component = cache.lookup(*world, StringName("NameCacheHealth"));
+		CHECK(component != 0);
+		CHECK(cache.get_miss_count() == misses);
+
+		world->entity(component).destruct();
+		CHECK(cache.lookup(*world, StringName("NameCacheHealth")) == 0);
+	}
+}
+
+} // namespace TestComponentNameCache
+
+#endif // TEST_COMPONENT_NAME_CACHE_H
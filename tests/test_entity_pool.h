@@ -0,0 +1,185 @@
+/**************************************************************************/
+/*  test_entity_pool.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_ENTITY_POOL_H
+#define TEST_ENTITY_POOL_H
+
+#include "core/os/os.h"
+#include "modules/godot_turbo/ecs/components/all_components.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_server.h"
+#include "test_fixtures.h"
+#include "tests/test_macros.h"
+
+namespace TestEntityPool {
+
+using namespace TestFixtures;
+
+static PackedStringArray _pool_components() {
+	PackedStringArray components;
+	components.push_back("Transform3DComponent");
+	components.push_back("VisibilityComponent");
+	return components;
+}
+
+static Dictionary _visibility_data(int p_count, bool p_visible) {
+	PackedByteArray visible;
+	visible.resize(p_count);
+	visible.fill(p_visible ? 1 : 0);
+	Dictionary fields;
+	fields["visible"] = visible;
+	Dictionary data;
+	data["VisibilityComponent"] = fields;
+	return data;
+}
+
+TEST_SUITE("[Modules][GodotTurbo][EntityPool]") {
+	TEST_CASE("[EntityPool] Released entities are parked and reused") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+		REQUIRE(fixture.server->create_entity_pool(world_id, "bullets", _pool_components()));
+
+		const int count = 16;
+		PackedInt64Array first = fixture.server->acquire_pooled_entities(world_id, "bullets", count, _visibility_data(count, true));
+		REQUIRE(first.size() == count);
+		flecs::query<VisibilityComponent> visible = world->query<VisibilityComponent>();
+		CHECK(visible.count() == count);
+
+		CHECK(fixture.server->release_pooled_entities(world_id, "bullets", first) == count);
+		for (int i = 0; i < count; i++) {
+			// Parked, not destroyed: queries skip the entity but its data stays
+			flecs::entity e = world->entity(first[i]);
+			REQUIRE(e.is_alive());
+			CHECK(e.has(flecs::Disabled));
+			CHECK(e.get<VisibilityComponent>().visible);
+		}
+		CHECK(visible.count() == 0);
+		// Releasing twice does nothing
+		CHECK(fixture.server->release_pooled_entities(world_id, "bullets", first) == 0);
+
+		PackedInt64Array second = fixture.server->acquire_pooled_entities(world_id, "bullets", count, _visibility_data(count, false));
+		REQUIRE(second.size() == count);
+		for (int i = 0; i < count; i++) {
+			CHECK(first.has(second[i]));
+			flecs::entity e = world->entity(second[i]);
+			CHECK_FALSE(e.has(flecs::Disabled));
+			CHECK_FALSE(e.get<VisibilityComponent>().visible);
+		}
+		CHECK(visible.count() == count);
+
+		Dictionary stats = fixture.server->get_entity_pool_stats(world_id, "bullets");
+		CHECK(int64_t(stats["acquires"]) == 2 * count);
+		CHECK(int64_t(stats["hits"]) == count);
+		CHECK(int64_t(stats["misses"]) == count);
+		CHECK(double(stats["hit_rate"]) == doctest::Approx(0.5));
+		CHECK(int64_t(stats["active"]) == count);
+		CHECK(int64_t(stats["parked"]) == 0);
+	}
+
+	TEST_CASE("[EntityPool] Prewarm, foreign ids and freeing the pool") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+		REQUIRE(fixture.server->create_entity_pool(world_id, "pickups", _pool_components(), 8));
+
+		Dictionary stats = fixture.server->get_entity_pool_stats(world_id, "pickups");
+		CHECK(int64_t(stats["parked"]) == 8);
+		CHECK(int64_t(stats["parked_bytes"]) == 8 * int64_t(sizeof(Transform3DComponent) + sizeof(VisibilityComponent)));
+
+		PackedInt64Array ids = fixture.server->acquire_pooled_entities(world_id, "pickups", 3);
+		REQUIRE(ids.size() == 3);
+		stats = fixture.server->get_entity_pool_stats(world_id, "pickups");
+		CHECK(int64_t(stats["hits"]) == 3);
+		CHECK(int64_t(stats["parked"]) == 5);
+
+		// Entities that were not acquired from the pool are left alone
+		PackedInt64Array foreign;
+		foreign.push_back(int64_t(world->entity().id()));
+		CHECK(fixture.server->release_pooled_entities(world_id, "pickups", foreign) == 0);
+		CHECK_FALSE(world->entity(foreign[0]).has(flecs::Disabled));
+
+		// Columns must target the pool's own components
+		PackedFloat32Array column;
+		column.resize(2 * 8);
+		Dictionary fields;
+		fields["transform"] = column;
+		Dictionary bad;
+		bad["Transform2DComponent"] = fields;
+		ERR_PRINT_OFF;
+		CHECK(fixture.server->acquire_pooled_entities(world_id, "pickups", 2, bad).is_empty());
+		CHECK_FALSE(fixture.server->create_entity_pool(world_id, "pickups", _pool_components()));
+		ERR_PRINT_ON;
+
+		// Parked entities are destroyed with the pool, acquired ones stay
+		fixture.server->free_entity_pool(world_id, "pickups");
+		CHECK(world->count<VisibilityComponent>() == 3);
+		for (int i = 0; i < ids.size(); i++) {
+			CHECK(world->is_alive(ids[i]));
+		}
+	}
+
+	TEST_CASE("[EntityPool][Benchmark] Create/free churn vs pooled acquire/release") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		REQUIRE(fixture.get_world() != nullptr);
+		const int wave = 2000;
+		const int waves = 50;
+		const Dictionary data = _visibility_data(wave, true);
+
+		uint64_t t0 = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < waves; i++) {
+			PackedInt64Array ids = fixture.server->create_entities_bulk(world_id, wave, _pool_components(), data, true);
+			fixture.server->free_entities_bulk(world_id, ids);
+		}
+		const uint64_t churn_usec = OS::get_singleton()->get_ticks_usec() - t0;
+
+		REQUIRE(fixture.server->create_entity_pool(world_id, "wave", _pool_components()));
+		t0 = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < waves; i++) {
+			PackedInt64Array ids = fixture.server->acquire_pooled_entities(world_id, "wave", wave, data);
+			fixture.server->release_pooled_entities(world_id, "wave", ids);
+		}
+		const uint64_t pooled_usec = OS::get_singleton()->get_ticks_usec() - t0;
+
+		const Dictionary stats = fixture.server->get_entity_pool_stats(world_id, "wave");
+		CHECK(int64_t(stats["misses"]) == wave);
+		MESSAGE(vformat("%d waves of %d entities: create/free %d usec, pooled %d usec (hit rate %.2f)",
+				waves, wave, (int64_t)churn_usec, (int64_t)pooled_usec, double(stats["hit_rate"])));
+	}
+}
+
+} // namespace TestEntityPool
+
+#endif // TEST_ENTITY_POOL_H
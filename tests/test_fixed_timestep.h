@@ -0,0 +1,143 @@
+/**************************************************************************/
+/*  test_fixed_timestep.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#ifndef TEST_FIXED_TIMESTEP_H
+#define TEST_FIXED_TIMESTEP_H
+
+#include "modules/godot_turbo/ecs/components/all_components.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_phases.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_server.h"
+#include "test_fixtures.h"
+#include "tests/test_macros.h"
+
+namespace TestFixedTimestep {
+
+using namespace TestFixtures;
+
+struct StepCounter {
+	int physics_steps = 0;
+	int frames = 0;
+	double physics_time = 0.0;
+};
+
+static void _add_counting_systems(flecs::world *p_world, StepCounter *p_counter) {
+	p_world->system("CountPhysicsSteps")
+			.kind<FlecsPhases::OnPhysicsUpdate>()
+			.run([p_counter](flecs::iter &p_it) {
+				p_counter->physics_steps++;
+				p_counter->physics_time += p_it.delta_time();
+			});
+	p_world->system("CountFrames")
+			.kind(flecs::OnUpdate)
+			.run([p_counter](flecs::iter &) {
+				p_counter->frames++;
+			});
+}
+
+TEST_SUITE("[Modules][GodotTurbo][FixedTimestep]") {
+	TEST_CASE("[FixedTimestep] Physics phase runs once per whole tick") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		StepCounter counter;
+		_add_counting_systems(world, &counter);
+		fixture.server->set_world_tick_rate(world_id, 60.0);
+		CHECK(fixture.server->get_world_tick_rate(world_id) == doctest::Approx(60.0));
+
+		// Two ticks in one long frame
+		fixture.server->progress_world(world_id, 1.0 / 30.0);
+		CHECK(counter.physics_steps == 2);
+		CHECK(counter.frames == 1);
+		CHECK(counter.physics_time == doctest::Approx(2.0 / 60.0));
+
+		// Half a tick: no step, alpha halfway to the next one
+		fixture.server->progress_world(world_id, 1.0 / 120.0);
+		CHECK(counter.physics_steps == 2);
+		CHECK(counter.frames == 2);
+		CHECK(fixture.server->get_world_interpolation_alpha(world_id) == doctest::Approx(0.5));
+		CHECK(world->get<PhysicsInterpolation>().alpha == doctest::Approx(0.5));
+		CHECK(world->get<PhysicsInterpolation>().steps == 0);
+
+		fixture.server->progress_world(world_id, 1.0 / 120.0);
+		CHECK(counter.physics_steps == 3);
+		CHECK(world->get<PhysicsInterpolation>().tick == 3);
+		CHECK(world->get<PhysicsInterpolation>().fixed_delta == doctest::Approx(1.0 / 60.0));
+	}
+
+	TEST_CASE("[FixedTimestep] Frame spikes are clamped to max steps") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		StepCounter counter;
+		_add_counting_systems(world, &counter);
+		fixture.server->set_world_tick_rate(world_id, 60.0);
+		fixture.server->set_world_max_physics_steps(world_id, 4);
+		CHECK(fixture.server->get_world_max_physics_steps(world_id) == 4);
+
+		fixture.server->progress_world(world_id, 1.0);
+		CHECK(counter.physics_steps == 4);
+		const double alpha = fixture.server->get_world_interpolation_alpha(world_id);
+		CHECK(alpha >= 0.0);
+		CHECK(alpha < 1.0);
+
+		// The backlog is dropped, the next frame is back to normal
+		fixture.server->progress_world(world_id, 1.0 / 60.0);
+		CHECK(counter.physics_steps == 5);
+	}
+
+	TEST_CASE("[FixedTimestep] Without a tick rate physics runs once per frame") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		StepCounter counter;
+		_add_counting_systems(world, &counter);
+		fixture.server->progress_world(world_id, 0.25);
+		CHECK(counter.physics_steps == 1);
+		CHECK(counter.physics_time == doctest::Approx(0.25));
+		CHECK(fixture.server->get_world_interpolation_alpha(world_id) == doctest::Approx(1.0));
+
+		// The default pipeline does not run the physics phase on its own
+		world->progress(0.25f);
+		CHECK(counter.physics_steps == 1);
+		CHECK(counter.frames == 2);
+	}
+}
+
+} // namespace TestFixedTimestep
+
+#endif // TEST_FIXED_TIMESTEP_H
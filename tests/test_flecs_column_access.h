@@ -0,0 +1,189 @@
+/**************************************************************************/
+/*  test_flecs_column_access.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FLECS_COLUMN_ACCESS_H
+#define TEST_FLECS_COLUMN_ACCESS_H
+
+#include "modules/godot_turbo/ecs/components/all_components.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_column_access.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_server.h"
+#include "test_fixtures.h"
+#include "tests/test_macros.h"
+
+namespace TestFlecsColumnAccess {
+
+using namespace TestFixtures;
+
+struct HookedValue {
+	float value = 0.0f;
+};
+
+static int hooked_value_on_set_calls = 0;
+
+TEST_SUITE("[Modules][GodotTurbo][FlecsColumnAccess]") {
+	TEST_CASE("[FlecsColumnAccess] Read Transform3D column in query order") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		const int count = 8;
+		for (int i = 0; i < count; i++) {
+			Transform3DComponent tc;
+			tc.transform.origin = Vector3(i, i * 2, i * 3);
+			world->entity().set<Transform3DComponent>(tc);
+		}
+
+		PackedStringArray components;
+		components.push_back("Transform3DComponent");
+		RID query_id = fixture.server->create_query(world_id, components);
+		REQUIRE(query_id.is_valid());
+
+		Variant column = fixture.server->get_component_field_column(world_id, query_id, "Transform3DComponent", "transform");
+		REQUIRE(column.get_type() == Variant::PACKED_FLOAT32_ARRAY);
+		PackedFloat32Array floats = column;
+		CHECK(floats.size() == count * 12);
+
+		// Multimesh layout: origin lives in the last element of each basis row
+		Array entities = fixture.server->query_get_entities(world_id, query_id);
+		REQUIRE(entities.size() == count);
+		for (int i = 0; i < count; i++) {
+			flecs::entity e = fixture.get_entity(entities[i]);
+			const Vector3 origin = e.get<Transform3DComponent>().transform.origin;
+			CHECK(floats[i * 12 + 3] == doctest::Approx(origin.x));
+			CHECK(floats[i * 12 + 7] == doctest::Approx(origin.y));
+			CHECK(floats[i * 12 + 11] == doctest::Approx(origin.z));
+			CHECK(floats[i * 12 + 0] == doctest::Approx(1.0f));
+		}
+
+		fixture.server->free_query(world_id, query_id);
+	}
+
+	TEST_CASE("[FlecsColumnAccess] Write column back into storage") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		const int count = 16;
+		for (int i = 0; i < count; i++) {
+			world->entity().set<VisibilityComponent>({ false });
+		}
+
+		PackedStringArray components;
+		components.push_back("VisibilityComponent");
+		RID query_id = fixture.server->create_query(world_id, components);
+
+		PackedByteArray visible;
+		visible.resize(count);
+		for (int i = 0; i < count; i++) {
+			visible.write[i] = (i % 2) ? 1 : 0;
+		}
+		fixture.server->set_component_field_column(world_id, query_id, "VisibilityComponent", "visible", visible);
+
+		PackedByteArray result = fixture.server->get_component_field_column(world_id, query_id, "VisibilityComponent", "visible");
+		REQUIRE(result.size() == count);
+		for (int i = 0; i < count; i++) {
+			CHECK(result[i] == visible[i]);
+		}
+
+		fixture.server->free_query(world_id, query_id);
+	}
+
+	TEST_CASE("[FlecsColumnAccess] Table events still run on_set hooks for every row") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		world->component<HookedValue>()
+				.member<float>("value")
+				.on_set([](HookedValue &) { hooked_value_on_set_calls++; });
+		const int count = 8;
+		for (int i = 0; i < count; i++) {
+			world->entity().set<HookedValue>({});
+		}
+		flecs::query<> query = world->query_builder().with<HookedValue>().build();
+
+		FlecsColumnAccess::FieldLayout layout;
+		REQUIRE(FlecsColumnAccess::resolve_field(*world, world->component<HookedValue>().id(), "value", layout));
+		PackedFloat32Array values;
+		values.resize(count);
+		for (int i = 0; i < count; i++) {
+			values.write[i] = float(i);
+		}
+
+		hooked_value_on_set_calls = 0;
+		CHECK(FlecsColumnAccess::write_column(*world, query, layout, values, true));
+		CHECK(hooked_value_on_set_calls == count);
+
+		query.destruct();
+	}
+
+	TEST_CASE("[FlecsColumnAccess] Mismatched columns are rejected") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		world->entity().set<VisibilityComponent>({ true });
+		world->entity().set<VisibilityComponent>({ true });
+
+		PackedStringArray components;
+		components.push_back("VisibilityComponent");
+		RID query_id = fixture.server->create_query(world_id, components);
+
+		ERR_PRINT_OFF;
+		// Unknown field
+		CHECK(fixture.server->get_component_field_column(world_id, query_id, "VisibilityComponent", "missing").get_type() == Variant::NIL);
+		// Wrong row count leaves storage untouched
+		PackedByteArray too_short;
+		too_short.push_back(0);
+		fixture.server->set_component_field_column(world_id, query_id, "VisibilityComponent", "visible", too_short);
+		// Wrong array type
+		fixture.server->set_component_field_column(world_id, query_id, "VisibilityComponent", "visible", PackedFloat32Array());
+		ERR_PRINT_ON;
+
+		PackedByteArray result = fixture.server->get_component_field_column(world_id, query_id, "VisibilityComponent", "visible");
+		REQUIRE(result.size() == 2);
+		CHECK(result[0] == 1);
+		CHECK(result[1] == 1);
+
+		fixture.server->free_query(world_id, query_id);
+	}
+}
+
+} // namespace TestFlecsColumnAccess
+
+#endif // TEST_FLECS_COLUMN_ACCESS_H
@@ -31,6 +31,10 @@
 #ifndef TEST_FLECS_SCRIPT_SYSTEM_H
 #define TEST_FLECS_SCRIPT_SYSTEM_H
 
+#include "core/object/callable_method_pointer.h"
+#include "core/object/object.h"
+#include "core/os/os.h"
+#include "modules/godot_turbo/ecs/components/all_components.h"
 #include "modules/godot_turbo/ecs/flecs_types/flecs_script_system.h"
 #include "modules/godot_turbo/ecs/flecs_types/flecs_server.h"
 #include "test_fixtures.h"
@@ -74,6 +78,72 @@ public:
 	}
 };
 
+// Receives columnar and change batches through callable_mp
+class ColumnarSink : public Object {
+public:
+	int call_count = 0;
+	Dictionary last_batch;
+
+	void receive(const Dictionary &p_batch) {
+		call_count++;
+		last_batch = p_batch;
+	}
+};
+
+// Counts the rows of every batch it receives
+class RowCounter : public Object {
+public:
+	int64_t rows = 0;
+	Array last_rows;
+
+	void receive(const Array &p_rows) {
+		rows += p_rows.size();
+		last_rows = p_rows;
+	}
+};
+
+// Moves every Transform3DComponent origin up by one and hands the column
+// back, either as the return value or by replacing it inside the batch
+class OffsetSink : public Object {
+public:
+	bool return_columns = true;
+
+	Variant receive(const Dictionary &p_batch) {
+		Dictionary columns = p_batch["columns"];
+		Dictionary transform_columns = columns["Transform3DComponent"];
+		PackedFloat32Array transforms = transform_columns["transform"];
+		const int64_t count = p_batch["count"];
+		for (int64_t i = 0; i < count; i++) {
+			transforms.write[i * 12 + 7] += 1.0f; // origin.y
+		}
+		if (!return_columns) {
+			transform_columns["transform"] = transforms;
+			return Variant();
+		}
+		Dictionary fields;
+		fields["transform"] = transforms;
+		Dictionary result;
+		result["Transform3DComponent"] = fields;
+		return result;
+	}
+};
+
+// Reads every column but changes none, optionally handing the batch back
+class ReadOnlySink : public Object {
+public:
+	bool return_columns = false;
+	double origin_sum = 0.0;
+
+	Variant receive(const Dictionary &p_batch) {
+		Dictionary columns = p_batch["columns"];
+		PackedFloat32Array transforms = Dictionary(columns["Transform3DComponent"])["transform"];
+		for (int i = 0; i < transforms.size(); i += 12) {
+			origin_sum += transforms[i + 3];
+		}
+		return return_columns ? Variant(columns) : Variant();
+	}
+};
+
 TEST_SUITE("[Modules][GodotTurbo][FlecsScriptSystem]") {
 	TEST_CASE("[FlecsScriptSystem] Basic initialization") {
 		REQUIRE_FLECS_SERVER();
@@ -123,6 +193,186 @@ TEST_SUITE("[Modules][GodotTurbo][FlecsScriptSystem]") {
 		// Set to batch mode
 		script_system.set_dispatch_mode(FlecsScriptSystem::DISPATCH_BATCH);
 		CHECK(script_system.get_dispatch_mode() == FlecsScriptSystem::DISPATCH_BATCH);
+
+		// Set to columnar mode
+		script_system.set_dispatch_mode(FlecsScriptSystem::DISPATCH_COLUMNAR);
+		CHECK(script_system.get_dispatch_mode() == FlecsScriptSystem::DISPATCH_COLUMNAR);
+	}
+
+	TEST_CASE("[FlecsScriptSystem] Columnar dispatch sends packed columns") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		const int count = 32;
+		for (int i = 0; i < count; i++) {
+			Transform3DComponent tc;
+			tc.transform.origin = Vector3(i, 0, 0);
+			flecs::entity e = world->entity().set<Transform3DComponent>(tc);
+			// Split the entities over two tables
+			if (i % 2) {
+				e.set<VisibilityComponent>({ true });
+			}
+		}
+
+		ColumnarSink sink;
+		FlecsScriptSystem script_system;
+		PackedStringArray components;
+		components.push_back("Transform3DComponent");
+		script_system.init(world_id, components, callable_mp(&sink, &ColumnarSink::receive));
+		script_system.set_dispatch_mode(FlecsScriptSystem::DISPATCH_COLUMNAR);
+		script_system.set_instrumentation_enabled(true);
+
+		fixture.server->progress_world(world_id, 0.016);
+
+		CHECK(sink.call_count == 1);
+		CHECK(script_system.get_total_entities_processed() == count);
+		REQUIRE(int64_t(sink.last_batch["count"]) == count);
+
+		PackedInt64Array ids = sink.last_batch["entities"];
+		Dictionary columns = sink.last_batch["columns"];
+		REQUIRE(columns.has("Transform3DComponent"));
+		PackedFloat32Array transforms = Dictionary(columns["Transform3DComponent"])["transform"];
+		REQUIRE(ids.size() == count);
+		REQUIRE(transforms.size() == count * 12);
+
+		// Row i of every column belongs to entity ids[i]
+		for (int i = 0; i < count; i++) {
+			flecs::entity e(world->c_ptr(), (flecs::entity_t)ids[i]);
+			REQUIRE(e.is_alive());
+			CHECK(transforms[i * 12 + 3] == doctest::Approx(e.get<Transform3DComponent>().transform.origin.x));
+		}
+	}
+
+	TEST_CASE("[FlecsScriptSystem] Columnar callbacks write columns back") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		const int count = 64;
+		LocalVector<flecs::entity> entities;
+		for (int i = 0; i < count; i++) {
+			flecs::entity e = world->entity().set<Transform3DComponent>({}).set<VisibilityComponent>({ true });
+			if (i % 4 == 0) {
+				// Another table
+				e.set<SceneNodeComponent>({});
+			}
+			entities.push_back(e);
+		}
+
+		int on_set_rows = 0;
+		flecs::observer counter = world->observer<Transform3DComponent>()
+										  .event(flecs::OnSet)
+										  .each([&](flecs::entity, Transform3DComponent &) { on_set_rows++; });
+
+		PackedStringArray components;
+		components.push_back("Transform3DComponent");
+		components.push_back("VisibilityComponent");
+
+		SUBCASE("Returned columns") {
+			OffsetSink sink;
+			sink.return_columns = true;
+			FlecsScriptSystem script_system;
+			script_system.init(world_id, components, callable_mp(&sink, &OffsetSink::receive));
+			script_system.set_dispatch_mode(FlecsScriptSystem::DISPATCH_COLUMNAR);
+			script_system.set_instrumentation_enabled(true);
+
+			fixture.server->progress_world(world_id, 0.016);
+			fixture.server->progress_world(world_id, 0.016);
+
+			CHECK(script_system.get_total_columns_written() == 2);
+			for (const flecs::entity &e : entities) {
+				CHECK(e.get<Transform3DComponent>().transform.origin.y == doctest::Approx(2.0f));
+			}
+		}
+
+		SUBCASE("Columns replaced in the batch") {
+			OffsetSink sink;
+			sink.return_columns = false;
+			FlecsScriptSystem script_system;
+			script_system.init(world_id, components, callable_mp(&sink, &OffsetSink::receive));
+			script_system.set_dispatch_mode(FlecsScriptSystem::DISPATCH_COLUMNAR);
+			script_system.set_instrumentation_enabled(true);
+
+			fixture.server->progress_world(world_id, 0.016);
+
+			// The untouched visibility column is not written
+			CHECK(script_system.get_total_columns_written() == 1);
+			for (const flecs::entity &e : entities) {
+				CHECK(e.get<Transform3DComponent>().transform.origin.y == doctest::Approx(1.0f));
+			}
+		}
+
+		// Every written row is notified, although events go out per table
+		CHECK(on_set_rows >= count);
+		counter.destruct();
+	}
+
+	TEST_CASE("[FlecsScriptSystem] Untouched columns are not written back") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		for (int i = 0; i < 16; i++) {
+			world->entity().set<Transform3DComponent>({}).set<VisibilityComponent>({ true });
+		}
+
+		int on_set_rows = 0;
+		flecs::observer counter = world->observer<Transform3DComponent>()
+										  .event(flecs::OnSet)
+										  .each([&](flecs::entity, Transform3DComponent &) { on_set_rows++; });
+
+		PackedStringArray components;
+		components.push_back("Transform3DComponent");
+		components.push_back("VisibilityComponent");
+
+		ReadOnlySink sink;
+		SUBCASE("Left in the batch") {
+			sink.return_columns = false;
+		}
+		SUBCASE("Returned as sent") {
+			sink.return_columns = true;
+		}
+		FlecsScriptSystem script_system;
+		script_system.init(world_id, components, callable_mp(&sink, &ReadOnlySink::receive));
+		script_system.set_dispatch_mode(FlecsScriptSystem::DISPATCH_COLUMNAR);
+		script_system.set_instrumentation_enabled(true);
+
+		fixture.server->progress_world(world_id, 0.016);
+		fixture.server->progress_world(world_id, 0.016);
+
+		CHECK(script_system.get_total_callbacks_invoked() == 2);
+		CHECK(script_system.get_total_columns_written() == 0);
+		CHECK(on_set_rows == 0);
+		counter.destruct();
+	}
+
+	TEST_CASE("[FlecsScriptSystem] Columnar dispatch is rejected in change-only mode") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		world->component<Position>();
+
+		FlecsScriptSystem script_system;
+		PackedStringArray components;
+		components.push_back("Position");
+		Callable callback;
+		script_system.init(world_id, components, callback);
+		script_system.set_change_only(true);
+
+		ERR_PRINT_OFF;
+		script_system.set_dispatch_mode(FlecsScriptSystem::DISPATCH_COLUMNAR);
+		ERR_PRINT_ON;
+		CHECK(script_system.get_dispatch_mode() == FlecsScriptSystem::DISPATCH_PER_ENTITY);
 	}
 
 	TEST_CASE("[FlecsScriptSystem] Set and get required components") {
@@ -179,6 +429,68 @@ TEST_SUITE("[Modules][GodotTurbo][FlecsScriptSystem]") {
 		CHECK_FALSE(script_system.is_change_only());
 	}
 
+	TEST_CASE("[FlecsScriptSystem] Change-only batches coalesce events per entity") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		ColumnarSink sink;
+		FlecsScriptSystem script_system;
+		PackedStringArray components;
+		components.push_back("VisibilityComponent");
+		script_system.init(world_id, components, callable_mp(&sink, &ColumnarSink::receive));
+		script_system.set_change_only(true);
+		script_system.set_change_observe_remove(true);
+		script_system.set_dispatch_mode(FlecsScriptSystem::DISPATCH_BATCH);
+		REQUIRE(script_system.get_dispatch_mode() == FlecsScriptSystem::DISPATCH_BATCH);
+		script_system.set_instrumentation_enabled(true);
+
+		const int count = 100;
+		LocalVector<flecs::entity> entities;
+		for (int i = 0; i < count; i++) {
+			// OnAdd + two OnSets, one entry
+			flecs::entity e = world->entity().set<VisibilityComponent>({ true });
+			e.set<VisibilityComponent>({ false });
+			entities.push_back(e);
+		}
+		CHECK(sink.call_count == 0);
+
+		fixture.server->progress_world(world_id, 0.016);
+		REQUIRE(sink.call_count == 1);
+		Array added = sink.last_batch["added"];
+		CHECK(added.size() == count);
+		CHECK(Array(sink.last_batch["changed"]).is_empty());
+		CHECK(Array(sink.last_batch["removed"]).is_empty());
+		// Read at flush time: the latest value
+		Dictionary first_components = Dictionary(added[0])["components"];
+		CHECK(bool(Dictionary(first_components["VisibilityComponent"])["visible"]) == false);
+		CHECK(script_system.get_total_change_events_coalesced() == uint64_t(2 * count));
+
+		// Nothing pending, nothing dispatched
+		fixture.server->progress_world(world_id, 0.016);
+		CHECK(sink.call_count == 1);
+
+		for (int i = 0; i < 10; i++) {
+			entities[i].set<VisibilityComponent>({ true });
+			entities[i].set<VisibilityComponent>({ false });
+		}
+		entities[10].remove<VisibilityComponent>();
+		// Changed, then removed: only listed as removed
+		entities[0].remove<VisibilityComponent>();
+
+		fixture.server->progress_world(world_id, 0.016);
+		REQUIRE(sink.call_count == 2);
+		CHECK(Array(sink.last_batch["added"]).is_empty());
+		CHECK(Array(sink.last_batch["changed"]).size() == 9);
+		Array removed = sink.last_batch["removed"];
+		CHECK(removed.size() == 2);
+		// Removed rows keep the data the entity had when it stopped matching
+		CHECK(Dictionary(Dictionary(removed[0])["components"]).has("VisibilityComponent"));
+		CHECK(script_system.get_total_callbacks_invoked() == 2);
+	}
+
 	TEST_CASE("[FlecsScriptSystem] Change observer flags") {
 		REQUIRE_FLECS_SERVER();
 		FlecsServerFixture fixture;
@@ -228,6 +540,229 @@ TEST_SUITE("[Modules][GodotTurbo][FlecsScriptSystem]") {
 		CHECK(script_system.get_multi_threaded());
 	}
 
+	TEST_CASE("[FlecsScriptSystem] Multi-threaded batches deliver every entity once") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+		fixture.server->set_world_thread_count(world_id, 4);
+
+		const int count = 1000;
+		for (int i = 0; i < count; i++) {
+			world->entity().set<Transform3DComponent>({});
+		}
+
+		RowCounter counter;
+		FlecsScriptSystem script_system;
+		PackedStringArray components;
+		components.push_back("Transform3DComponent");
+		script_system.init(world_id, components, callable_mp(&counter, &RowCounter::receive));
+		script_system.set_dispatch_mode(FlecsScriptSystem::DISPATCH_BATCH);
+		script_system.set_multi_threaded(true);
+		script_system.set_instrumentation_enabled(true);
+
+		fixture.server->progress_world(world_id, 0.016);
+		CHECK(counter.rows == count);
+		CHECK(script_system.get_total_entities_processed() == count);
+		// RIDs are filled in by the flush on the main thread
+		int missing_rids = 0;
+		for (int i = 0; i < counter.last_rows.size(); i++) {
+			const RID rid = Dictionary(counter.last_rows[i])["rid"];
+			if (!rid.is_valid() || fixture.server->get_world_of_entity(rid) != world_id) {
+				missing_rids++;
+			}
+		}
+		CHECK(missing_rids == 0);
+
+		// Nothing is carried over into the next flush
+		fixture.server->progress_world(world_id, 0.016);
+		CHECK(counter.rows == 2 * count);
+	}
+
+	TEST_CASE("[FlecsScriptSystem][Benchmark] Multi-threaded batch accumulation at 1/4/16 threads") {
+		REQUIRE_FLECS_SERVER();
+		const int count = 20000;
+		const int frames = 5;
+		const int thread_counts[] = { 1, 4, 16 };
+		uint64_t usec_by_count[3] = {};
+
+		for (int t = 0; t < 3; t++) {
+			const int threads = thread_counts[t];
+			FlecsServerFixture fixture;
+			RID world_id = fixture.create_world();
+			flecs::world *world = fixture.get_world();
+			REQUIRE(world != nullptr);
+			fixture.server->set_world_thread_count(world_id, threads);
+
+			for (int i = 0; i < count; i++) {
+				world->entity().set<Transform3DComponent>({});
+			}
+
+			RowCounter counter;
+			FlecsScriptSystem script_system;
+			PackedStringArray components;
+			components.push_back("Transform3DComponent");
+			script_system.init(world_id, components, callable_mp(&counter, &RowCounter::receive));
+			script_system.set_dispatch_mode(FlecsScriptSystem::DISPATCH_BATCH);
+			script_system.set_multi_threaded(true);
+
+			// Warm-up frame builds the tables' caches and the stage accumulators
+			fixture.server->progress_world(world_id, 0.016);
+			counter.rows = 0;
+
+			const uint64_t t0 = OS::get_singleton()->get_ticks_usec();
+			for (int f = 0; f < frames; f++) {
+				fixture.server->progress_world(world_id, 0.016);
+			}
+			const uint64_t usec = OS::get_singleton()->get_ticks_usec() - t0;
+			usec_by_count[t] = usec;
+
+			MESSAGE(vformat("%d threads: %d entities x %d frames in %d usec (%.1f entities/msec)", threads, count, frames, usec,
+					usec > 0 ? double(count) * frames * 1000.0 / double(usec) : 0.0));
+			CHECK(counter.rows == int64_t(count) * frames);
+		}
+
+		// Reported only: wall-clock timings depend on the machine running the tests
+		MESSAGE(vformat("Speedup over 1 thread: %.2fx at 4 threads, %.2fx at 16 threads",
+				usec_by_count[1] > 0 ? double(usec_by_count[0]) / double(usec_by_count[1]) : 0.0,
+				usec_by_count[2] > 0 ? double(usec_by_count[0]) / double(usec_by_count[2]) : 0.0));
+	}
+
+	TEST_CASE("[FlecsScriptSystem] Projection limits serialized fields") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		CameraComponent camera;
+		camera.far = 123.0f;
+		world->entity().set<CameraComponent>(camera).set<VisibilityComponent>({ false });
+
+		RowCounter counter;
+		FlecsScriptSystem script_system;
+		PackedStringArray components;
+		components.push_back("CameraComponent");
+		components.push_back("VisibilityComponent");
+		script_system.init(world_id, components, callable_mp(&counter, &RowCounter::receive));
+		script_system.set_dispatch_mode(FlecsScriptSystem::DISPATCH_BATCH);
+
+		SUBCASE("Fields") {
+			PackedStringArray projection;
+			projection.push_back("CameraComponent.far");
+			script_system.set_projection(projection);
+			CHECK(script_system.get_projection() == projection);
+
+			fixture.server->progress_world(world_id, 0.016);
+			REQUIRE(counter.last_rows.size() == 1);
+			Dictionary comps = Dictionary(counter.last_rows[0])["components"];
+			Dictionary camera_dict = comps["CameraComponent"];
+			CHECK(camera_dict.size() == 1);
+			CHECK(float(camera_dict["far"]) == doctest::Approx(123.0f));
+			// Not projected: presence only
+			REQUIRE(comps.has("VisibilityComponent"));
+			CHECK(Dictionary(comps["VisibilityComponent"]).is_empty());
+		}
+
+		SUBCASE("Whole component") {
+			PackedStringArray projection;
+			projection.push_back("VisibilityComponent");
+			script_system.set_projection(projection);
+
+			fixture.server->progress_world(world_id, 0.016);
+			REQUIRE(counter.last_rows.size() == 1);
+			Dictionary comps = Dictionary(counter.last_rows[0])["components"];
+			CHECK(Dictionary(comps["CameraComponent"]).is_empty());
+			CHECK(bool(Dictionary(comps["VisibilityComponent"])["visible"]) == false);
+		}
+
+		SUBCASE("Tag only") {
+			PackedStringArray projection;
+			projection.push_back(FlecsScriptSystem::PROJECTION_TAG_ONLY);
+			script_system.set_projection(projection);
+
+			fixture.server->progress_world(world_id, 0.016);
+			REQUIRE(counter.last_rows.size() == 1);
+			Dictionary comps = Dictionary(counter.last_rows[0])["components"];
+			CHECK(comps.size() == 2);
+			CHECK(Dictionary(comps["CameraComponent"]).is_empty());
+			CHECK(Dictionary(comps["VisibilityComponent"]).is_empty());
+		}
+
+		SUBCASE("Unknown member is reported and skipped") {
+			PackedStringArray projection;
+			projection.push_back("CameraComponent.far");
+			projection.push_back("CameraComponent.missing");
+			ERR_PRINT_OFF;
+			script_system.set_projection(projection);
+			ERR_PRINT_ON;
+
+			fixture.server->progress_world(world_id, 0.016);
+			REQUIRE(counter.last_rows.size() == 1);
+			Dictionary camera_dict = Dictionary(Dictionary(counter.last_rows[0])["components"])["CameraComponent"];
+			CHECK(camera_dict.size() == 1);
+			CHECK(camera_dict.has("far"));
+		}
+
+		SUBCASE("Plans are re-taken after invalidation") {
+			PackedStringArray projection;
+			projection.push_back("CameraComponent.far");
+			script_system.set_projection(projection);
+			fixture.server->progress_world(world_id, 0.016);
+
+			FlecsReflection::AccessPlanCache::get().invalidate(*world);
+			fixture.server->progress_world(world_id, 0.016);
+			REQUIRE(counter.last_rows.size() == 1);
+			Dictionary camera_dict = Dictionary(Dictionary(counter.last_rows[0])["components"])["CameraComponent"];
+			CHECK(camera_dict.size() == 1);
+			CHECK(float(camera_dict["far"]) == doctest::Approx(123.0f));
+		}
+	}
+
+	TEST_CASE("[FlecsScriptSystem][Benchmark] Full vs projected CameraComponent rows") {
+		REQUIRE_FLECS_SERVER();
+		const int count = 10000;
+		const int frames = 5;
+
+		for (const bool projected : { false, true }) {
+			FlecsServerFixture fixture;
+			RID world_id = fixture.create_world();
+			flecs::world *world = fixture.get_world();
+			REQUIRE(world != nullptr);
+
+			CameraComponent camera;
+			camera.frustum.resize(6);
+			for (int i = 0; i < count; i++) {
+				world->entity().set<CameraComponent>(camera);
+			}
+
+			RowCounter counter;
+			FlecsScriptSystem script_system;
+			PackedStringArray components;
+			components.push_back("CameraComponent");
+			script_system.init(world_id, components, callable_mp(&counter, &RowCounter::receive));
+			script_system.set_dispatch_mode(FlecsScriptSystem::DISPATCH_BATCH);
+			if (projected) {
+				PackedStringArray projection;
+				projection.push_back("CameraComponent.position");
+				script_system.set_projection(projection);
+			}
+
+			fixture.server->progress_world(world_id, 0.016);
+			counter.rows = 0;
+
+			const uint64_t t0 = OS::get_singleton()->get_ticks_usec();
+			for (int f = 0; f < frames; f++) {
+				fixture.server->progress_world(world_id, 0.016);
+			}
+			const uint64_t usec = OS::get_singleton()->get_ticks_usec() - t0;
+
+			MESSAGE(vformat("%s: %d entities x %d frames in %d usec", projected ? "projected" : "full", count, frames, usec));
+			CHECK(counter.rows == int64_t(count) * frames);
+		}
+	}
+
 	TEST_CASE("[FlecsScriptSystem] Batch configuration") {
 		REQUIRE_FLECS_SERVER();
 		FlecsServerFixture fixture;
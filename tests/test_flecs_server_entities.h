@@ -0,0 +1,567 @@
+/**************************************************************************/
+/*  test_flecs_server_entities.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FLECS_SERVER_ENTITIES_H
+#define TEST_FLECS_SERVER_ENTITIES_H
+
+#include "core/os/thread.h"
+#include "modules/godot_turbo/ecs/components/all_components.h"
+#include "modules/godot_turbo/ecs/flecs_types/entity_rid_map.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_server.h"
+#include "test_fixtures.h"
+#include "tests/test_macros.h"
+
+namespace TestFlecsServerEntities {
+
+using namespace TestFixtures;
+
+TEST_SUITE("[Modules][GodotTurbo][FlecsServerEntities]") {
+	TEST_CASE("[FlecsServerEntities] Entity world resolution across worlds") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture client;
+		FlecsServerFixture server_side;
+		RID client_world = client.create_world();
+		RID server_world = server_side.create_world();
+		REQUIRE(client_world.is_valid());
+		REQUIRE(server_world.is_valid());
+
+		RID client_entity = client.server->create_entity(client_world);
+		RID server_entity = server_side.server->create_entity(server_world);
+
+		CHECK(client.server->get_world_of_entity(client_entity) == client_world);
+		CHECK(client.server->get_world_of_entity(server_entity) == server_world);
+
+		// Hierarchy helpers hand out new RIDs; they must resolve as well
+		RID child = client.server->create_entity(client_world);
+		client.server->add_child(client_entity, child);
+		TypedArray<RID> children = client.server->get_children(client_entity);
+		REQUIRE(children.size() == 1);
+		CHECK(client.server->get_world_of_entity(children[0]) == client_world);
+	}
+
+	TEST_CASE("[FlecsServerEntities] Freed entity RIDs no longer resolve") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+
+		RID entity = fixture.server->create_entity(world_id);
+		CHECK(fixture.server->get_world_of_entity(entity) == world_id);
+
+		fixture.server->free_entity(world_id, entity, true);
+		CHECK_FALSE(fixture.server->get_world_of_entity(entity).is_valid());
+
+		// Recycled slots resolve to the world that made them
+		RID reused = fixture.server->create_entity(world_id);
+		CHECK(fixture.server->get_world_of_entity(reused) == world_id);
+
+		fixture.cleanup_world();
+		CHECK_FALSE(fixture.server->get_world_of_entity(reused).is_valid());
+	}
+
+	TEST_CASE("[FlecsServerEntities] Bulk creation fills columns in one table") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		const int count = 1000;
+		PackedFloat32Array transforms;
+		transforms.resize(count * 12);
+		PackedByteArray visible;
+		visible.resize(count);
+		for (int i = 0; i < count; i++) {
+			float *row = transforms.ptrw() + i * 12;
+			row[0] = 1.0f;
+			row[5] = 1.0f;
+			row[10] = 1.0f;
+			row[3] = float(i);
+			visible.write[i] = i % 2;
+		}
+
+		Dictionary visibility_fields;
+		visibility_fields["visible"] = visible;
+		Dictionary initial_data;
+		Dictionary transform_fields;
+		transform_fields["transform"] = transforms;
+		initial_data["Transform3DComponent"] = transform_fields;
+		initial_data["VisibilityComponent"] = visibility_fields;
+
+		PackedStringArray components;
+		components.push_back("DirtyTransform");
+		PackedInt64Array ids = fixture.server->create_entities_bulk(world_id, count, components, initial_data);
+		REQUIRE(ids.size() == count);
+
+		const ecs_table_t *table = ecs_get_table(world->c_ptr(), ids[0]);
+		for (int i = 0; i < count; i++) {
+			flecs::entity e = world->entity(ids[i]);
+			REQUIRE(e.is_alive());
+			CHECK(ecs_get_table(world->c_ptr(), ids[i]) == table);
+			CHECK(e.has<DirtyTransform>());
+			CHECK(e.get<Transform3DComponent>().transform.origin.x == doctest::Approx(float(i)));
+			CHECK(e.get<VisibilityComponent>().visible == bool(i % 2));
+		}
+
+		// RIDs are made on demand
+		RID rid = fixture.server->get_entity_rid(world_id, ids[10]);
+		REQUIRE(rid.is_valid());
+		CHECK(fixture.server->get_world_of_entity(rid) == world_id);
+		CHECK(fixture.server->get_entity_rid(world_id, ids[10]) == rid);
+	}
+
+	TEST_CASE("[FlecsServerEntities] Bulk creation rejects bad columns without creating entities") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		PackedByteArray short_column;
+		short_column.resize(3);
+		Dictionary fields;
+		fields["visible"] = short_column;
+		Dictionary initial_data;
+		initial_data["VisibilityComponent"] = fields;
+
+		const int before = world->count<VisibilityComponent>();
+		ERR_PRINT_OFF;
+		PackedInt64Array ids = fixture.server->create_entities_bulk(world_id, 10, PackedStringArray(), initial_data);
+		ERR_PRINT_ON;
+		CHECK(ids.is_empty());
+		CHECK(world->count<VisibilityComponent>() == before);
+	}
+
+	TEST_CASE("[FlecsServerEntities] Prefab instances share components until overridden") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		Dictionary fields;
+		fields["hp"] = 0;
+		fields["label"] = String();
+		REQUIRE(fixture.server->create_runtime_component(world_id, "PrefabStats", fields).is_valid());
+		const flecs::entity_t stats = world->lookup("PrefabStats").id();
+		REQUIRE(stats != 0);
+
+		Dictionary stats_data;
+		stats_data["hp"] = 100;
+		stats_data["label"] = "grunt";
+		Dictionary components;
+		components["PrefabStats"] = stats_data;
+		RID prefab = fixture.server->create_prefab(world_id, components, "GruntPrefab");
+		REQUIRE(prefab.is_valid());
+		CHECK(fixture.get_entity(prefab).has(flecs::Prefab));
+
+		const int count = 64;
+		PackedFloat32Array transforms;
+		transforms.resize(count * 12);
+		for (int i = 0; i < count; i++) {
+			float *row = transforms.ptrw() + i * 12;
+			row[0] = 1.0f;
+			row[5] = 1.0f;
+			row[10] = 1.0f;
+			row[3] = float(i);
+		}
+		Dictionary transform_fields;
+		transform_fields["transform"] = transforms;
+		Dictionary overrides;
+		overrides["Transform3DComponent"] = transform_fields;
+
+		PackedInt64Array ids = fixture.server->instantiate_prefab(world_id, prefab, count, overrides);
+		REQUIRE(ids.size() == count);
+
+		const ecs_table_t *table = ecs_get_table(world->c_ptr(), ids[0]);
+		for (int i = 0; i < count; i++) {
+			flecs::entity e = world->entity(ids[i]);
+			CHECK(ecs_get_table(world->c_ptr(), ids[i]) == table);
+			// The stats live on the prefab only, the transform on every instance
+			CHECK(e.has(stats));
+			CHECK_FALSE(e.owns(stats));
+			CHECK(e.owns<Transform3DComponent>());
+			CHECK(e.get<Transform3DComponent>().transform.origin.x == doctest::Approx(float(i)));
+		}
+
+		RID first = fixture.server->get_entity_rid(world_id, ids[0]);
+		RID second = fixture.server->get_entity_rid(world_id, ids[1]);
+		CHECK(int(fixture.server->get_component_by_name(first, "PrefabStats")["hp"]) == 100);
+
+		// Setting a shared component gives that instance its own copy
+		stats_data["hp"] = 5;
+		fixture.server->set_component(first, "PrefabStats", stats_data);
+		CHECK(world->entity(ids[0]).owns(stats));
+		CHECK(int(fixture.server->get_component_by_name(first, "PrefabStats")["hp"]) == 5);
+		CHECK(int(fixture.server->get_component_by_name(second, "PrefabStats")["hp"]) == 100);
+		CHECK(int(fixture.server->get_component_by_name(prefab, "PrefabStats")["hp"]) == 100);
+	}
+
+	TEST_CASE("[FlecsServerEntities] Prefabs reject components already in use") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		REQUIRE(fixture.get_world() != nullptr);
+
+		Dictionary fields;
+		fields["hp"] = 0;
+		REQUIRE(fixture.server->create_runtime_component(world_id, "UsedStats", fields).is_valid());
+		RID entity = fixture.server->create_entity(world_id);
+		fixture.server->set_component(entity, "UsedStats", fields);
+
+		Dictionary components;
+		components["UsedStats"] = Variant();
+		ERR_PRINT_OFF;
+		CHECK_FALSE(fixture.server->create_prefab(world_id, components).is_valid());
+		ERR_PRINT_ON;
+	}
+
+	TEST_CASE("[FlecsServerEntities] Instantiation rejects entities that are not prefabs") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		REQUIRE(fixture.get_world() != nullptr);
+
+		RID entity = fixture.server->create_entity(world_id);
+		ERR_PRINT_OFF;
+		PackedInt64Array ids = fixture.server->instantiate_prefab(world_id, entity, 10);
+		ERR_PRINT_ON;
+		CHECK(ids.is_empty());
+	}
+
+	TEST_CASE("[FlecsServerEntities] Bulk destruction sweeps entities and RIDs") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		const int count = 500;
+		PackedStringArray components;
+		components.push_back("VisibilityComponent");
+		PackedInt64Array ids = fixture.server->create_entities_bulk(world_id, count, components, Dictionary(), true);
+		REQUIRE(ids.size() == count);
+
+		RID first = fixture.server->get_entity_rid(world_id, ids[0]);
+		RID last = fixture.server->get_entity_rid(world_id, ids[count - 1]);
+		REQUIRE(fixture.server->get_world_of_entity(first) == world_id);
+
+		// Keep one entity to make sure only the requested ones go away
+		PackedInt64Array doomed = ids.slice(0, count - 1);
+		fixture.server->free_entities_bulk(world_id, doomed);
+
+		for (int i = 0; i < count - 1; i++) {
+			CHECK_FALSE(world->is_alive(ids[i]));
+		}
+		CHECK(world->is_alive(ids[count - 1]));
+		CHECK_FALSE(fixture.server->get_world_of_entity(first).is_valid());
+		CHECK(fixture.server->get_world_of_entity(last) == world_id);
+		CHECK(world->count<VisibilityComponent>() == 1);
+
+		// Already dead ids are ignored
+		fixture.server->free_entities_bulk(world_id, doomed);
+		CHECK(world->is_alive(ids[count - 1]));
+	}
+
+	TEST_CASE("[FlecsServerEntities] Bulk destruction sweeps cascaded children") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		RID parent = fixture.server->create_entity(world_id);
+		RID child = fixture.server->create_entity(world_id);
+		RID grandchild = fixture.server->create_entity(world_id);
+		fixture.server->add_child(parent, child);
+		fixture.server->add_child(child, grandchild);
+
+		const flecs::entity_t parent_id = fixture.get_entity(parent).id();
+		const flecs::entity_t child_id = fixture.get_entity(child).id();
+		const flecs::entity_t grandchild_id = fixture.get_entity(grandchild).id();
+
+		// The child is listed too, after its parent, and must not be swept twice
+		PackedInt64Array doomed;
+		doomed.push_back(static_cast<int64_t>(parent_id));
+		doomed.push_back(static_cast<int64_t>(child_id));
+		fixture.server->free_entities_bulk(world_id, doomed);
+
+		CHECK_FALSE(world->is_alive(parent_id));
+		CHECK_FALSE(world->is_alive(child_id));
+		CHECK_FALSE(world->is_alive(grandchild_id));
+		CHECK_FALSE(fixture.server->get_world_of_entity(parent).is_valid());
+		CHECK_FALSE(fixture.server->get_world_of_entity(child).is_valid());
+		CHECK_FALSE(fixture.server->get_world_of_entity(grandchild).is_valid());
+	}
+
+#ifndef DISABLE_THREADED_TESTS
+	TEST_CASE("[FlecsServerEntities] Concurrent RID materialization from many workers") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		const int entity_count = 2000;
+		PackedInt64Array ids = fixture.server->create_entities_bulk(world_id, entity_count, PackedStringArray());
+		REQUIRE(ids.size() == entity_count);
+
+		static constexpr int THREAD_COUNT = 8;
+		static constexpr int ROUNDS = 4;
+		struct WorkerData {
+			FlecsServer *server = nullptr;
+			flecs::world *world = nullptr;
+			RID world_id;
+			const int64_t *ids = nullptr;
+			int count = 0;
+			int offset = 0;
+			Vector<RID> results;
+		};
+
+		Thread threads[THREAD_COUNT];
+		WorkerData data[THREAD_COUNT];
+		for (int t = 0; t < THREAD_COUNT; t++) {
+			data[t].server = fixture.server;
+			data[t].world = world;
+			data[t].world_id = world_id;
+			data[t].ids = ids.ptr();
+			data[t].count = entity_count;
+			// Every worker walks all entities from a different start so they collide
+			data[t].offset = t * entity_count / THREAD_COUNT;
+			data[t].results.resize(entity_count);
+			threads[t].start([](void *p_userdata) {
+				WorkerData *wd = static_cast<WorkerData *>(p_userdata);
+				RID *w = wd->results.ptrw();
+				for (int round = 0; round < ROUNDS; round++) {
+					for (int i = 0; i < wd->count; i++) {
+						const int idx = (wd->offset + i) % wd->count;
+						w[idx] = wd->server->_get_or_create_rid_for_entity(wd->world_id, wd->world->entity(wd->ids[idx]));
+					}
+				}
+			},
+					&data[t]);
+		}
+		for (int t = 0; t < THREAD_COUNT; t++) {
+			threads[t].wait_to_finish();
+		}
+
+		// Every worker must have resolved each entity to the same, single RID
+		int mismatches = 0;
+		for (int i = 0; i < entity_count; i++) {
+			const RID rid = data[0].results[i];
+			for (int t = 1; t < THREAD_COUNT; t++) {
+				if (data[t].results[i] != rid) {
+					mismatches++;
+				}
+			}
+			if (fixture.server->get_world_of_entity(rid) != world_id || fixture.get_entity(rid).id() != flecs::entity_t(ids[i])) {
+				mismatches++;
+			}
+		}
+		CHECK(mismatches == 0);
+		CHECK(fixture.server->get_entity_rid(world_id, ids[0]) == data[0].results[0]);
+	}
+
+	TEST_CASE("[FlecsServerEntities] EntityRIDMap survives concurrent set and take") {
+		EntityRIDMap map;
+		static constexpr int THREAD_COUNT = 8;
+		static constexpr int KEYS_PER_THREAD = 5000;
+		struct WorkerData {
+			EntityRIDMap *map = nullptr;
+			int thread_index = 0;
+			int taken = 0;
+		};
+
+		Thread threads[THREAD_COUNT];
+		WorkerData data[THREAD_COUNT];
+		for (int t = 0; t < THREAD_COUNT; t++) {
+			data[t].map = &map;
+			data[t].thread_index = t;
+			threads[t].start([](void *p_userdata) {
+				WorkerData *wd = static_cast<WorkerData *>(p_userdata);
+				// Interleaved keys put every thread on every shard
+				for (int i = 0; i < KEYS_PER_THREAD; i++) {
+					const uint64_t key = uint64_t(i) * THREAD_COUNT + wd->thread_index;
+					wd->map->set(key, RID::from_uint64(key + 1));
+				}
+				for (int i = 0; i < KEYS_PER_THREAD; i += 2) {
+					const uint64_t key = uint64_t(i) * THREAD_COUNT + wd->thread_index;
+					RID rid;
+					if (wd->map->take(key, rid) && rid == RID::from_uint64(key + 1)) {
+						wd->taken++;
+					}
+				}
+			},
+					&data[t]);
+		}
+		for (int t = 0; t < THREAD_COUNT; t++) {
+			threads[t].wait_to_finish();
+		}
+
+		for (int t = 0; t < THREAD_COUNT; t++) {
+			CHECK(data[t].taken == KEYS_PER_THREAD / 2);
+		}
+		CHECK(map.size() == uint32_t(THREAD_COUNT * KEYS_PER_THREAD / 2));
+		RID rid;
+		CHECK(map.get(1 * THREAD_COUNT + 3, rid));
+		CHECK(rid == RID::from_uint64(1 * THREAD_COUNT + 3 + 1));
+		CHECK_FALSE(map.has(0 * THREAD_COUNT + 3));
+	}
+#endif // DISABLE_THREADED_TESTS
+
+	TEST_CASE("[FlecsServerEntities] EntityRIDMap discards the stale RID it replaces") {
+		EntityRIDMap map;
+		const RID stale = RID::from_uint64(10);
+		const RID fresh = RID::from_uint64(11);
+		map.set(7, stale);
+
+		Vector<RID> discarded;
+		const RID kept = map.get_or_create(
+				7, [](const RID &) { return true; }, [&]() { return fresh; }, [&](const RID &p_rid) { discarded.push_back(p_rid); });
+		CHECK(kept == stale);
+		CHECK(discarded.is_empty());
+
+		const RID replaced = map.get_or_create(
+				7, [](const RID &) { return false; }, [&]() { return fresh; }, [&](const RID &p_rid) { discarded.push_back(p_rid); });
+		CHECK(replaced == fresh);
+		REQUIRE(discarded.size() == 1);
+		CHECK(discarded[0] == stale);
+		RID rid;
+		CHECK(map.get(7, rid));
+		CHECK(rid == fresh);
+	}
+
+	TEST_CASE("[FlecsServerEntities] RIDs of a world survive other worlds coming and going") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		REQUIRE(fixture.get_world() != nullptr);
+
+		RID entity = fixture.server->create_entity_with_name(world_id, "Survivor");
+		fixture.server->set_component(entity, "VisibilityComponent", Dictionary());
+		PackedStringArray components;
+		components.push_back("VisibilityComponent");
+		RID query = fixture.server->create_query(world_id, components);
+		REQUIRE(entity.is_valid());
+		REQUIRE(query.is_valid());
+
+		LocalVector<RID> others;
+		for (int i = 0; i < 16; i++) {
+			RID other = fixture.server->create_world();
+			REQUIRE(other.is_valid());
+			fixture.server->create_entity(other);
+			others.push_back(other);
+		}
+		for (const RID &other : others) {
+			fixture.server->free_world(other);
+		}
+
+		// Registries are held by pointer: nothing of this world was re-made
+		CHECK(fixture.server->get_world_of_entity(entity) == world_id);
+		CHECK(fixture.server->get_entity_name(entity) == "Survivor");
+		CHECK(fixture.server->lookup(world_id, "Survivor").is_valid());
+		CHECK(fixture.server->query_get_entity_count(world_id, query) == 1);
+	}
+
+	TEST_CASE("[FlecsServerEntities] Dense handles work with the entity API") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		CHECK(fixture.server->get_entity_handle_mode(world_id) == FlecsServer::ENTITY_HANDLE_RID);
+		RID owned = fixture.server->create_entity(world_id);
+		CHECK_FALSE(FlecsEntityHandle::is_handle(owned));
+
+		fixture.server->set_entity_handle_mode(world_id, FlecsServer::ENTITY_HANDLE_DENSE);
+		RID parent = fixture.server->create_entity(world_id);
+		RID child = fixture.server->create_entity(world_id);
+		REQUIRE(FlecsEntityHandle::is_handle(parent));
+		CHECK(fixture.server->get_world_of_entity(parent) == world_id);
+
+		Dictionary visibility;
+		visibility["visible"] = false;
+		fixture.server->set_component(parent, "VisibilityComponent", visibility);
+		CHECK(fixture.server->has_component(parent, "VisibilityComponent"));
+		CHECK_FALSE(fixture.get_entity(parent).get<VisibilityComponent>().visible);
+
+		fixture.server->add_child(parent, child);
+		TypedArray<RID> children = fixture.server->get_children(parent);
+		REQUIRE(children.size() == 1);
+		CHECK(RID(children[0]) == child);
+
+		// Both handle kinds keep working after switching back
+		fixture.server->set_entity_handle_mode(world_id, FlecsServer::ENTITY_HANDLE_RID);
+		CHECK(fixture.server->has_component(parent, "VisibilityComponent"));
+		CHECK(fixture.server->get_world_of_entity(owned) == world_id);
+		fixture.server->set_entity_handle_mode(world_id, FlecsServer::ENTITY_HANDLE_DENSE);
+
+		// Bulk spawns hand out handles without touching RID_Owner
+		PackedInt64Array ids = fixture.server->create_entities_bulk(world_id, 100, PackedStringArray(), Dictionary(), true);
+		REQUIRE(ids.size() == 100);
+		RID handle = fixture.server->get_entity_rid(world_id, ids[42]);
+		CHECK(handle == fixture.server->get_entity_handle(world_id, ids[42]));
+		CHECK(fixture.get_entity(handle).id() == flecs::entity_t(ids[42]));
+
+		// Destroying the entity invalidates its handle; a recycled index gets a new generation
+		const flecs::entity_t child_id = fixture.get_entity(child).id();
+		fixture.server->free_entity(world_id, child, true);
+		CHECK_FALSE(world->is_alive(child_id));
+		CHECK_FALSE(fixture.server->get_world_of_entity(child).is_valid());
+		RID recycled = fixture.server->create_entity(world_id);
+		CHECK(recycled != child);
+		ERR_PRINT_OFF;
+		CHECK_FALSE(fixture.server->has_component(child, "VisibilityComponent"));
+		ERR_PRINT_ON;
+	}
+
+	TEST_CASE("[FlecsServerEntities] Dense handles go stale with their world") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		fixture.server->set_entity_handle_mode(world_id, FlecsServer::ENTITY_HANDLE_DENSE);
+		RID handle = fixture.server->create_entity(world_id);
+		REQUIRE(FlecsEntityHandle::is_handle(handle));
+
+		fixture.cleanup_world();
+		CHECK_FALSE(fixture.server->get_world_of_entity(handle).is_valid());
+
+		// The next world may reuse the slot, but with a new generation
+		FlecsServerFixture other;
+		RID other_world = other.create_world();
+		other.server->set_entity_handle_mode(other_world, FlecsServer::ENTITY_HANDLE_DENSE);
+		other.server->create_entity(other_world);
+		CHECK_FALSE(other.server->get_world_of_entity(handle).is_valid());
+	}
+}
+
+} // namespace TestFlecsServerEntities
+
+#endif // TEST_FLECS_SERVER_ENTITIES_H
@@ -0,0 +1,111 @@
+/**************************************************************************/
+/*  test_frame_summary_history.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#ifndef TEST_FRAME_SUMMARY_HISTORY_H
+#define TEST_FRAME_SUMMARY_HISTORY_H
+
+#include "modules/godot_turbo/ecs/flecs_types/flecs_server.h"
+#include "modules/godot_turbo/ecs/flecs_types/frame_summary_history.h"
+#include "test_fixtures.h"
+#include "tests/test_macros.h"
+
+namespace TestFrameSummaryHistory {
+
+using namespace TestFixtures;
+
+TEST_SUITE("[Modules][GodotTurbo][FrameSummaryHistory]") {
+	TEST_CASE("[FrameSummaryHistory] Keeps the newest frames once full") {
+		FrameSummaryHistory history;
+		history.set_capacity(4);
+		CHECK(history.size() == 0);
+		CHECK(history.get(0) == nullptr);
+
+		for (uint64_t frame = 1; frame <= 6; frame++) {
+			WorldFrameSummary &summary = history.begin_frame();
+			summary.frame = frame;
+			ScriptSystemFrameStats stats;
+			stats.entities = frame;
+			summary.systems.push_back(stats);
+		}
+
+		CHECK(history.size() == 4);
+		REQUIRE(history.get(0) != nullptr);
+		CHECK(history.get(0)->frame == 6);
+		CHECK(history.get(3)->frame == 3);
+		CHECK(history.get(4) == nullptr);
+		// Reused slots start without the rows of the frame they replaced
+		CHECK(history.get(0)->systems.size() == 1);
+		CHECK(history.get(0)->systems[0].entities == 6);
+
+		history.clear();
+		CHECK(history.size() == 0);
+		CHECK(history.get_capacity() == 4);
+	}
+
+	TEST_CASE("[FrameSummaryHistory] Converts to the frame summary dictionary") {
+		WorldFrameSummary summary;
+		summary.frame = 12;
+		summary.script_systems = 2;
+		summary.dispatch_invocations = 4;
+		summary.dispatch_accum_usec = 100;
+		ScriptSystemFrameStats stats;
+		stats.entities = 64;
+		stats.dispatch_invocations = 4;
+		stats.dispatch_accum_usec = 100;
+		summary.systems.push_back(stats);
+
+		const Dictionary d = summary.to_dictionary();
+		CHECK(int64_t(d["frame"]) == 12);
+		CHECK(int64_t(d["script_systems"]) == 2);
+		CHECK(int64_t(d["dispatch_avg_usec"]) == 25);
+		const Array systems = d["systems"];
+		REQUIRE(systems.size() == 1);
+		const Dictionary row = systems[0];
+		CHECK(int64_t(row["entities"]) == 64);
+		CHECK_FALSE(row.has("median_dispatch_usec"));
+	}
+
+	TEST_CASE("[FrameSummaryHistory] Nothing is recorded without instrumentation") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		REQUIRE(fixture.get_world() != nullptr);
+
+		fixture.server->progress_world(world_id, 0.016);
+		CHECK(fixture.server->get_world_frame_summary(world_id).is_empty());
+		CHECK(fixture.server->get_world_frame_history(world_id).is_empty());
+
+		fixture.server->set_world_frame_history_size(world_id, 30);
+		CHECK(fixture.server->get_world_frame_history_size(world_id) == 30);
+	}
+}
+
+} // namespace TestFrameSummaryHistory
+
+#endif // TEST_FRAME_SUMMARY_HISTORY_H
@@ -44,6 +44,17 @@
 #include "test_flecs_variant.h"
 #include "test_flecs_query.h"
 #include "test_flecs_script_system.h"
+#include "test_flecs_column_access.h"
+#include "test_component_access_plan.h"
+#include "test_flecs_server_entities.h"
+#include "test_component_name_cache.h"
+#include "test_world_write_batch.h"
+#include "test_world_snapshot.h"
+#include "test_worker_pool.h"
+#include "test_frame_summary_history.h"
+#include "test_fixed_timestep.h"
+#include "test_entity_pool.h"
+#include "test_transform_propagation.h"
 
 // ECS systems tests
 #include "test_gdscript_runner_system.h"
@@ -36,6 +36,7 @@
 #include "modules/godot_turbo/ecs/systems/utility/scene_object_utility.h"
 #include "modules/godot_turbo/ecs/flecs_types/flecs_server.h"
 #include "modules/godot_turbo/ecs/components/all_components.h"
+#include "core/os/os.h"
 #include "scene/main/node.h"
 #include "scene/2d/node_2d.h"
 #include "scene/3d/node_3d.h"
@@ -525,6 +526,148 @@ TEST_CASE("[SceneObjectUtility] Multiple node types in single conversion") {
 	server->free_world(world_id);
 }
 
+TEST_CASE("[SceneObjectUtility] Async conversion commits when the world progresses") {
+	REQUIRE_FLECS_SERVER();
+
+	FlecsServer *server = FlecsServer::get_singleton();
+	RID world_id = server->create_world();
+	flecs::world *world = server->_get_world(world_id);
+
+	Node *root = memnew(Node);
+	root->set_name("Root");
+	for (int i = 0; i < 4; i++) {
+		Node *child = memnew(Node);
+		child->set_name("Child" + itos(i));
+		root->add_child(child);
+		Node *grandchild = memnew(Node);
+		grandchild->set_name("Grandchild" + itos(i));
+		child->add_child(grandchild);
+	}
+
+	SceneObjectUtility *util = SceneObjectUtility::get_singleton();
+	const int64_t job_id = util->convert_scene_async(world_id, root);
+	REQUIRE(job_id > 0);
+	CHECK(util->get_pending_conversion_count() == 1);
+	CHECK(server->get_command_handler(world_id, SceneObjectUtility::conversion_command_handler_name).is_valid());
+
+	// Staging runs on a pool thread; nothing reaches the world before a sync point
+	CHECK(world->count<SceneNodeComponent>() == 0);
+	for (int i = 0; i < 1000 && util->get_pending_conversion_count() > 0; i++) {
+		server->progress_world(world_id, 0.016);
+		OS::get_singleton()->delay_usec(1000);
+	}
+	CHECK(util->get_pending_conversion_count() == 0);
+	CHECK(world->count<SceneNodeComponent>() == 9);
+	// The handler goes away with the world's last conversion
+	CHECK(server->get_command_handler(world_id, SceneObjectUtility::conversion_command_handler_name).is_null());
+
+	flecs::entity root_entity = world->lookup(("Root_" + itos(root->get_instance_id())).ascii().get_data());
+	REQUIRE(root_entity.is_valid());
+	CHECK(root_entity.get<SceneNodeComponent>().node_id == root->get_instance_id());
+
+	CHECK(util->convert_scene_async(world_id, nullptr) == -1);
+
+	memdelete(root);
+	server->free_world(world_id);
+}
+
+TEST_CASE("[SceneObjectUtility] Async conversion commits a budget of nodes per frame") {
+	REQUIRE_BOTH_SERVERS();
+
+	FlecsServer *server = FlecsServer::get_singleton();
+	RID world_id = server->create_world();
+	flecs::world *world = server->_get_world(world_id);
+
+	Node *root = memnew(Node);
+	root->set_name("Root");
+	for (int i = 0; i < 9; i++) {
+		Node *child = memnew(Node);
+		child->set_name("Child" + itos(i));
+		root->add_child(child);
+	}
+	Node2D *sprite = memnew(Node2D);
+	sprite->set_name("Sprite");
+	sprite->set_position(Vector2(3, 4));
+	root->add_child(sprite);
+
+	SceneObjectUtility *util = SceneObjectUtility::get_singleton();
+	const int previous_budget = util->get_conversion_budget();
+	util->set_conversion_budget(4);
+	const int64_t job_id = util->convert_scene_async(world_id, root);
+	REQUIRE(job_id > 0);
+
+	// The snapshot was taken by the call; later edits are not picked up
+	sprite->set_name("Renamed");
+	sprite->set_position(Vector2(7, 8));
+
+	// The first slice is queued once the staging task is done
+	for (int i = 0; i < 1000 && world->count<SceneNodeComponent>() == 0; i++) {
+		server->progress_world(world_id, 0.016);
+		OS::get_singleton()->delay_usec(1000);
+	}
+	CHECK(world->count<SceneNodeComponent>() == 4);
+	CHECK(util->get_pending_conversion_count() == 1);
+
+	server->progress_world(world_id, 0.016);
+	CHECK(world->count<SceneNodeComponent>() == 8);
+	CHECK(util->get_pending_conversion_count() == 1);
+
+	server->progress_world(world_id, 0.016);
+	CHECK(util->get_pending_conversion_count() == 0);
+	CHECK(world->count<SceneNodeComponent>() == 10);
+
+	flecs::entity sprite_entity = world->lookup(("Sprite_" + itos(sprite->get_instance_id())).ascii().get_data());
+	REQUIRE(sprite_entity.is_valid());
+	CHECK(sprite_entity.has<CanvasItemComponent>());
+	CHECK(sprite_entity.get<ObjectInstanceComponent>().object_instance_id == sprite->get_instance_id());
+	CHECK(sprite_entity.get<Transform2DComponent>().transform.get_origin().is_equal_approx(Vector2(3, 4)));
+
+	util->set_conversion_budget(previous_budget);
+	memdelete(root);
+	server->free_world(world_id);
+}
+
+// Records the conversion_completed signal
+class ConversionProbe : public Object {
+public:
+	int64_t job_id = 0;
+	String error;
+
+	void on_completed(int64_t p_job_id, const Array &p_entities, const String &p_error) {
+		job_id = p_job_id;
+		error = p_error;
+	}
+};
+
+TEST_CASE("[SceneObjectUtility] Freeing the world fails its pending conversions") {
+	REQUIRE_FLECS_SERVER();
+
+	FlecsServer *server = FlecsServer::get_singleton();
+	RID world_id = server->create_world();
+
+	Node *root = memnew(Node);
+	root->set_name("Root");
+	root->add_child(memnew(Node));
+
+	SceneObjectUtility *util = SceneObjectUtility::get_singleton();
+	ConversionProbe probe;
+	const Callable on_completed = callable_mp(&probe, &ConversionProbe::on_completed);
+	util->connect(SNAME("conversion_completed"), on_completed);
+
+	const int64_t job_id = util->convert_scene_async(world_id, root);
+	REQUIRE(job_id > 0);
+	ERR_PRINT_OFF;
+	server->free_world(world_id);
+	ERR_PRINT_ON;
+
+	CHECK(util->get_pending_conversion_count() == 0);
+	CHECK(probe.job_id == job_id);
+	CHECK_FALSE(probe.error.is_empty());
+
+	util->disconnect(SNAME("conversion_completed"), on_completed);
+	memdelete(root);
+}
+
 } // namespace TestSceneObjectUtility
 
 #endif // TEST_SCENE_OBJECT_UTILITY_H
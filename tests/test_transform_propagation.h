@@ -0,0 +1,170 @@
+/**************************************************************************/
+/*  test_transform_propagation.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_TRANSFORM_PROPAGATION_H
+#define TEST_TRANSFORM_PROPAGATION_H
+
+#include "core/os/os.h"
+#include "modules/godot_turbo/ecs/components/all_components.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_server.h"
+#include "test_fixtures.h"
+#include "tests/test_macros.h"
+
+namespace TestTransformPropagation {
+
+using namespace TestFixtures;
+
+static Transform3D _translation(real_t p_x, real_t p_y, real_t p_z) {
+	return Transform3D(Basis(), Vector3(p_x, p_y, p_z));
+}
+
+// Writes without modified(), which change detection does not see
+static void _poke_global(flecs::world *p_world, flecs::entity p_entity, const Vector3 &p_origin) {
+	GlobalTransform3D *global = static_cast<GlobalTransform3D *>(ecs_get_mut_id(p_world->c_ptr(), p_entity, p_world->id<GlobalTransform3D>()));
+	global->transform.origin = p_origin;
+}
+
+TEST_SUITE("[Modules][GodotTurbo][TransformPropagation]") {
+	TEST_CASE("[TransformPropagation] Global transforms compose down the hierarchy") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		flecs::entity root = world->entity().set<LocalTransform3D>({ _translation(1, 0, 0) });
+		flecs::entity child = world->entity().child_of(root).set<LocalTransform3D>({ _translation(0, 2, 0) });
+		flecs::entity grandchild = world->entity().child_of(child).set<LocalTransform3D>({ Transform3D(Basis(Vector3(0, 1, 0), Math::PI), Vector3(0, 0, 3)) });
+		// The local transform brings the global one along
+		CHECK(grandchild.has<GlobalTransform3D>());
+
+		fixture.server->progress_world(world_id, 0.016);
+		CHECK(root.get<GlobalTransform3D>().transform.origin.is_equal_approx(Vector3(1, 0, 0)));
+		CHECK(child.get<GlobalTransform3D>().transform.origin.is_equal_approx(Vector3(1, 2, 0)));
+		CHECK(grandchild.get<GlobalTransform3D>().transform.origin.is_equal_approx(Vector3(1, 2, 3)));
+
+		root.set<LocalTransform3D>({ _translation(5, 0, 0) });
+		fixture.server->progress_world(world_id, 0.016);
+		CHECK(grandchild.get<GlobalTransform3D>().transform.origin.is_equal_approx(Vector3(5, 2, 3)));
+		CHECK(grandchild.get<GlobalTransform3D>().transform.basis.is_equal_approx(Basis(Vector3(0, 1, 0), Math::PI)));
+
+		// Reparenting moves the entity to another table, which counts as a change
+		child.child_of(world->entity().set<LocalTransform3D>({ _translation(0, 0, -10) }));
+		fixture.server->progress_world(world_id, 0.016);
+		CHECK(grandchild.get<GlobalTransform3D>().transform.origin.is_equal_approx(Vector3(0, 2, -7)));
+	}
+
+	TEST_CASE("[TransformPropagation] Subtrees below unchanged parents are skipped") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		flecs::entity moving = world->entity().set<LocalTransform3D>({ _translation(1, 0, 0) });
+		flecs::entity moving_child = world->entity().child_of(moving).set<LocalTransform3D>({ _translation(0, 1, 0) });
+		// Changes are tracked per table; the tag keeps the still roots out of the moving root's table
+		flecs::entity still = world->entity().add<DirtyTransform>().set<LocalTransform3D>({ _translation(2, 0, 0) });
+		flecs::entity still_child = world->entity().child_of(still).add<DirtyTransform>().set<LocalTransform3D>({ _translation(0, 1, 0) });
+		fixture.server->progress_world(world_id, 0.016);
+
+		// A stale value survives as long as nothing above it changes
+		_poke_global(world, moving_child, Vector3(-1, -1, -1));
+		_poke_global(world, still_child, Vector3(-1, -1, -1));
+		moving.set<LocalTransform3D>({ _translation(3, 0, 0) });
+		fixture.server->progress_world(world_id, 0.016);
+		CHECK(moving_child.get<GlobalTransform3D>().transform.origin.is_equal_approx(Vector3(3, 1, 0)));
+		CHECK(still_child.get<GlobalTransform3D>().transform.origin.is_equal_approx(Vector3(-1, -1, -1)));
+
+		still.set<LocalTransform3D>({ _translation(2, 0, 0) });
+		fixture.server->progress_world(world_id, 0.016);
+		CHECK(still_child.get<GlobalTransform3D>().transform.origin.is_equal_approx(Vector3(2, 1, 0)));
+	}
+
+	TEST_CASE("[TransformPropagation] 2D transforms propagate") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		flecs::entity parent = world->entity().set<LocalTransform2D>({ Transform2D(Math::PI / 2, Vector2(10, 0)) });
+		flecs::entity child = world->entity().child_of(parent).set<LocalTransform2D>({ Transform2D(0, Vector2(1, 0)) });
+		// A parent without transforms is looked through
+		flecs::entity group = world->entity().child_of(parent);
+		flecs::entity grouped = world->entity().child_of(group).set<LocalTransform2D>({ Transform2D(0, Vector2(0, 1)) });
+
+		fixture.server->progress_world(world_id, 0.016);
+		CHECK(child.get<GlobalTransform2D>().transform.get_origin().is_equal_approx(Vector2(10, 1)));
+		CHECK(grouped.get<GlobalTransform2D>().transform.get_origin().is_equal_approx(Vector2(9, 0)));
+	}
+
+	TEST_CASE("[TransformPropagation][Benchmark] Full propagation vs idle frame") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		// 100 roots, 10 children each, 100 grandchildren per child
+		const int roots = 100;
+		LocalVector<flecs::entity> root_entities;
+		for (int r = 0; r < roots; r++) {
+			flecs::entity root = world->entity().set<LocalTransform3D>({ _translation(r, 0, 0) });
+			root_entities.push_back(root);
+			for (int c = 0; c < 10; c++) {
+				flecs::entity child = world->entity().child_of(root).set<LocalTransform3D>({ _translation(0, c, 0) });
+				for (int g = 0; g < 100; g++) {
+					world->entity().child_of(child).set<LocalTransform3D>({ _translation(0, 0, g) });
+				}
+			}
+		}
+		fixture.server->progress_world(world_id, 0.016);
+
+		uint64_t t0 = OS::get_singleton()->get_ticks_usec();
+		for (flecs::entity root : root_entities) {
+			root.set<LocalTransform3D>({ _translation(0, 1, 0) });
+		}
+		fixture.server->progress_world(world_id, 0.016);
+		const uint64_t full_usec = OS::get_singleton()->get_ticks_usec() - t0;
+
+		t0 = OS::get_singleton()->get_ticks_usec();
+		fixture.server->progress_world(world_id, 0.016);
+		const uint64_t idle_usec = OS::get_singleton()->get_ticks_usec() - t0;
+
+		CHECK(world->count<GlobalTransform3D>() == roots * (1 + 10 + 1000));
+		MESSAGE(vformat("%d entities: all roots moved %d usec, nothing moved %d usec",
+				roots * (1 + 10 + 1000), (int64_t)full_usec, (int64_t)idle_usec));
+	}
+}
+
+} // namespace TestTransformPropagation
+
+#endif // TEST_TRANSFORM_PROPAGATION_H
@@ -0,0 +1,389 @@
+/**************************************************************************/
+/*  test_worker_pool.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#ifndef TEST_WORKER_POOL_H
+#define TEST_WORKER_POOL_H
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_script_system.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_server.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_worker_pool.h"
+#include "test_fixtures.h"
+#include "tests/test_macros.h"
+#include <atomic>
+#include <memory>
+
+namespace TestWorkerPool {
+
+using namespace TestFixtures;
+
+struct PoolTestValue {
+	int32_t value = 0;
+};
+
+static void *_echo_task(void *p_arg) {
+	return p_arg;
+}
+
+// Counts script system calls and whether any ran off the main thread
+class ScriptThreadProbe : public Object {
+public:
+	int calls = 0;
+	bool off_main_thread = false;
+
+	void receive(const Array &p_rows) {
+		calls++;
+		off_main_thread = off_main_thread || Thread::get_caller_id() != Thread::get_main_id();
+		// Script callbacks may reach back into the server
+		FlecsServer::get_singleton()->get_world_list();
+	}
+};
+
+static void *_sleep_task(void *p_arg) {
+	OS::get_singleton()->delay_usec(2000);
+	return p_arg;
+}
+
+// Fans out again from inside a pool task, the way a world progressed by
+// progress_worlds() starts and joins its stage tasks
+static void *_nested_task(void *p_arg) {
+	std::atomic<uint32_t> *visits = static_cast<std::atomic<uint32_t> *>(p_arg);
+	FlecsWorkerPool::get_singleton()->parallel_for(8, [visits](uint32_t) {
+		visits->fetch_add(1);
+	});
+	return p_arg;
+}
+
+static void _add_increment_system(flecs::world *p_world) {
+	p_world->component<PoolTestValue>();
+	p_world->system<PoolTestValue>("PoolTestIncrement")
+			.multi_threaded()
+			.each([](PoolTestValue &p_value) {
+				p_value.value++;
+			});
+}
+
+TEST_SUITE("[Modules][GodotTurbo][WorkerPool]") {
+	TEST_CASE("[WorkerPool] Tasks run and join with their result") {
+		REQUIRE_FLECS_SERVER();
+		FlecsWorkerPool *pool = FlecsWorkerPool::get_singleton();
+		REQUIRE(pool != nullptr);
+
+		int values[8];
+		ecs_os_thread_t tasks[8];
+		for (int i = 0; i < 8; i++) {
+			tasks[i] = pool->start(_echo_task, &values[i]);
+		}
+		for (int i = 0; i < 8; i++) {
+			CHECK(pool->join(tasks[i]) == &values[i]);
+		}
+	}
+
+	TEST_CASE("[WorkerPool] Tasks past the thread budget are queued") {
+		REQUIRE_FLECS_SERVER();
+		FlecsWorkerPool *pool = FlecsWorkerPool::get_singleton();
+		REQUIRE(pool != nullptr);
+
+		const uint32_t task_count = pool->get_thread_count() * 2 + 2;
+		const uint64_t overflow_before = pool->get_overflow_count();
+		int marker = 0;
+
+		LocalVector<ecs_os_thread_t> tasks;
+		for (uint32_t i = 0; i < task_count; i++) {
+			tasks.push_back(pool->start(_sleep_task, &marker));
+		}
+		CHECK(pool->get_live_thread_count() <= pool->get_thread_count());
+		for (ecs_os_thread_t task : tasks) {
+			CHECK(pool->join(task) == &marker);
+		}
+		CHECK(pool->get_overflow_count() > overflow_before);
+	}
+
+	TEST_CASE("[WorkerPool] Tasks that join nested work do not starve") {
+		REQUIRE_FLECS_SERVER();
+		FlecsWorkerPool *pool = FlecsWorkerPool::get_singleton();
+		REQUIRE(pool != nullptr);
+
+		// Every worker ends up waiting on tasks queued behind it
+		const uint32_t task_count = pool->get_thread_count() + 2;
+		std::atomic<uint32_t> visits{ 0 };
+		LocalVector<ecs_os_thread_t> tasks;
+		for (uint32_t i = 0; i < task_count; i++) {
+			tasks.push_back(pool->start(_nested_task, &visits));
+		}
+		for (ecs_os_thread_t task : tasks) {
+			CHECK(pool->join(task) == &visits);
+		}
+		CHECK(visits.load() == task_count * 8);
+		CHECK(pool->get_live_thread_count() <= pool->get_thread_count());
+	}
+
+	TEST_CASE("[WorkerPool] World thread count is settable") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		fixture.server->set_world_thread_count(world_id, 3);
+		CHECK(fixture.server->get_world_thread_count(world_id) == 3);
+
+		ERR_PRINT_OFF;
+		fixture.server->set_world_thread_count(world_id, 0);
+		ERR_PRINT_ON;
+		CHECK(fixture.server->get_world_thread_count(world_id) == 3);
+
+		_add_increment_system(world);
+		const int count = 4096;
+		for (int i = 0; i < count; i++) {
+			world->entity().set<PoolTestValue>({});
+		}
+		fixture.server->progress_world(world_id, 0.016);
+		fixture.server->progress_world(world_id, 0.016);
+
+		int total = 0;
+		world->each([&total](const PoolTestValue &p_value) {
+			total += p_value.value;
+		});
+		CHECK(total == count * 2);
+	}
+
+	TEST_CASE("[WorkerPool][Benchmark] Dedicated threads per world vs shared pool") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServer *server = FlecsServer::get_singleton();
+		const int world_count = 4;
+		const int entity_count = 20000;
+		const int frames = 60;
+		const int stage_count = server->get_worker_thread_count() + 1;
+
+		LocalVector<RID> worlds;
+		for (int i = 0; i < world_count; i++) {
+			const RID world_id = server->create_world();
+			REQUIRE(world_id.is_valid());
+			flecs::world *world = server->_get_world(world_id);
+			_add_increment_system(world);
+			for (int j = 0; j < entity_count; j++) {
+				world->entity().set<PoolTestValue>({});
+			}
+			worlds.push_back(world_id);
+		}
+
+		auto run_frames = [&]() {
+			const uint64_t t0 = OS::get_singleton()->get_ticks_usec();
+			for (int frame = 0; frame < frames; frame++) {
+				for (const RID &world_id : worlds) {
+					server->_get_world(world_id)->progress(0.016f);
+				}
+			}
+			return OS::get_singleton()->get_ticks_usec() - t0;
+		};
+
+		// Before: every world keeps stage_count - 1 threads of its own
+		for (const RID &world_id : worlds) {
+			server->_get_world(world_id)->set_threads(stage_count);
+		}
+		const uint64_t dedicated_usec = run_frames();
+
+		// After: stages are tasks on the shared pool
+		for (const RID &world_id : worlds) {
+			server->set_world_thread_count(world_id, stage_count);
+		}
+		const uint64_t shared_usec = run_frames();
+
+		MESSAGE(vformat("%d worlds x %d entities x %d frames, %d stages: dedicated %d usec (%d threads), shared %d usec (%d threads)",
+				world_count, entity_count, frames, stage_count,
+				dedicated_usec, world_count * (stage_count - 1),
+				shared_usec, FlecsWorkerPool::get_singleton()->get_live_thread_count()));
+
+		for (const RID &world_id : worlds) {
+			int total = 0;
+			server->_get_world(world_id)->each([&total](const PoolTestValue &p_value) {
+				total += p_value.value;
+			});
+			CHECK(total == entity_count * frames * 2);
+			server->free_world(world_id);
+		}
+	}
+
+	TEST_CASE("[WorkerPool] parallel_for visits every index once") {
+		REQUIRE_FLECS_SERVER();
+		FlecsWorkerPool *pool = FlecsWorkerPool::get_singleton();
+		REQUIRE(pool != nullptr);
+
+		const uint32_t count = 1000;
+		std::unique_ptr<std::atomic<uint32_t>[]> visits(new std::atomic<uint32_t>[count]);
+		for (uint32_t i = 0; i < count; i++) {
+			visits[i].store(0);
+		}
+		pool->parallel_for(count, [&visits](uint32_t p_index) {
+			visits[p_index].fetch_add(1);
+		});
+		uint32_t wrong = 0;
+		for (uint32_t i = 0; i < count; i++) {
+			wrong += visits[i].load() == 1 ? 0 : 1;
+		}
+		CHECK(wrong == 0);
+	}
+
+	TEST_CASE("[WorkerPool] progress_worlds advances every world") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServer *server = FlecsServer::get_singleton();
+		const int world_count = 8;
+		const int entity_count = 512;
+
+		TypedArray<RID> worlds;
+		for (int i = 0; i < world_count; i++) {
+			const RID world_id = server->create_world();
+			REQUIRE(world_id.is_valid());
+			_add_increment_system(server->_get_world(world_id));
+			for (int j = 0; j < entity_count; j++) {
+				server->_get_world(world_id)->entity().set<PoolTestValue>({});
+			}
+			worlds.push_back(world_id);
+		}
+
+		CHECK(server->progress_worlds(worlds, 0.016));
+		CHECK(server->progress_worlds(worlds, 0.016));
+
+		ERR_PRINT_OFF;
+		TypedArray<RID> duplicated;
+		duplicated.push_back(worlds[0]);
+		duplicated.push_back(worlds[0]);
+		server->progress_worlds(duplicated, 0.016);
+		ERR_PRINT_ON;
+
+		for (int i = 0; i < world_count; i++) {
+			const RID world_id = worlds[i];
+			int total = 0;
+			server->_get_world(world_id)->each([&total](const PoolTestValue &p_value) {
+				total += p_value.value;
+			});
+			// The duplicate entry is skipped, so the first world advances once more
+			CHECK(total == entity_count * (i == 0 ? 3 : 2));
+			server->free_world(world_id);
+		}
+	}
+
+	TEST_CASE("[WorkerPool] progress_worlds keeps script worlds on the calling thread") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServer *server = FlecsServer::get_singleton();
+
+		TypedArray<RID> worlds;
+		for (int i = 0; i < 3; i++) {
+			const RID world_id = server->create_world();
+			REQUIRE(world_id.is_valid());
+			worlds.push_back(world_id);
+		}
+		// The third world is native and still goes to the pool
+		const RID native_world = worlds[2];
+		_add_increment_system(server->_get_world(native_world));
+		server->_get_world(native_world)->entity().set<PoolTestValue>({});
+
+		{
+			// Destroyed before the worlds they live in
+			ScriptThreadProbe probes[2];
+			FlecsScriptSystem script_systems[2];
+			for (int i = 0; i < 2; i++) {
+				script_systems[i].init(worlds[i], PackedStringArray(), callable_mp(&probes[i], &ScriptThreadProbe::receive));
+			}
+
+			CHECK(server->progress_worlds(worlds, 0.016));
+			CHECK(server->progress_worlds(worlds, 0.016));
+
+			for (int i = 0; i < 2; i++) {
+				CHECK(probes[i].calls == 2);
+				CHECK_FALSE(probes[i].off_main_thread);
+			}
+		}
+		int total = 0;
+		server->_get_world(native_world)->each([&total](const PoolTestValue &p_value) {
+			total += p_value.value;
+		});
+		CHECK(total == 2);
+
+		for (int i = 0; i < worlds.size(); i++) {
+			server->free_world(worlds[i]);
+		}
+	}
+
+	TEST_CASE("[WorkerPool][Benchmark] progress_world loop vs progress_worlds") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServer *server = FlecsServer::get_singleton();
+		const int world_count = 32;
+		const int entity_count = 2000;
+		const int frames = 60;
+
+		TypedArray<RID> worlds;
+		for (int i = 0; i < world_count; i++) {
+			const RID world_id = server->create_world();
+			REQUIRE(world_id.is_valid());
+			// Small worlds: parallelism comes from running worlds side by side
+			server->set_world_thread_count(world_id, 1);
+			_add_increment_system(server->_get_world(world_id));
+			for (int j = 0; j < entity_count; j++) {
+				server->_get_world(world_id)->entity().set<PoolTestValue>({});
+			}
+			worlds.push_back(world_id);
+		}
+
+		uint64_t t0 = OS::get_singleton()->get_ticks_usec();
+		for (int frame = 0; frame < frames; frame++) {
+			for (int i = 0; i < world_count; i++) {
+				server->progress_world(worlds[i], 0.016);
+			}
+		}
+		const uint64_t serial_usec = OS::get_singleton()->get_ticks_usec() - t0;
+
+		t0 = OS::get_singleton()->get_ticks_usec();
+		for (int frame = 0; frame < frames; frame++) {
+			server->progress_worlds(worlds, 0.016);
+		}
+		const uint64_t parallel_usec = OS::get_singleton()->get_ticks_usec() - t0;
+
+		MESSAGE(vformat("%d worlds x %d entities x %d frames: progress_world %d usec, progress_worlds %d usec (%.2fx, %d pool threads)",
+				world_count, entity_count, frames, serial_usec, parallel_usec,
+				parallel_usec > 0 ? double(serial_usec) / double(parallel_usec) : 0.0,
+				server->get_worker_thread_count()));
+
+		for (int i = 0; i < world_count; i++) {
+			const RID world_id = worlds[i];
+			int total = 0;
+			server->_get_world(world_id)->each([&total](const PoolTestValue &p_value) {
+				total += p_value.value;
+			});
+			CHECK(total == entity_count * frames * 2);
+			server->free_world(world_id);
+		}
+	}
+}
+
+} // namespace TestWorkerPool
+
+#endif // TEST_WORKER_POOL_H
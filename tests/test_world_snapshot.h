@@ -0,0 +1,323 @@
+/**************************************************************************/
+/*  test_world_snapshot.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_WORLD_SNAPSHOT_H
+#define TEST_WORLD_SNAPSHOT_H
+
+#include "modules/godot_turbo/ecs/components/all_components.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_server.h"
+#include "modules/godot_turbo/ecs/flecs_types/flecs_world_snapshot.h"
+#include "test_fixtures.h"
+#include "tests/test_macros.h"
+
+namespace TestWorldSnapshot {
+
+using namespace TestFixtures;
+
+TEST_SUITE("[Modules][GodotTurbo][WorldSnapshot]") {
+	TEST_CASE("[WorldSnapshot] Restore rolls entities and columns back") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		const int count = 256;
+		PackedStringArray components;
+		components.push_back("Transform3DComponent");
+		PackedInt64Array ids = fixture.server->create_entities_bulk(world_id, count, components);
+		REQUIRE(ids.size() == count);
+		for (int i = 0; i < count; i++) {
+			world->entity(ids[i]).set<Transform3DComponent>({ Transform3D(Basis(), Vector3(i, 0, 0)) });
+		}
+		world->entity(ids[0]).set_name("Leader");
+		world->entity(ids[1]).child_of(world->entity(ids[0]));
+
+		const PackedByteArray snapshot = fixture.server->snapshot_world(world_id);
+		REQUIRE(snapshot.size() > count * int(sizeof(Transform3D)));
+
+		// Diverge: move everything, destroy a few, spawn a few, rename the leader
+		for (int i = 0; i < count; i++) {
+			world->entity(ids[i]).set<Transform3DComponent>({ Transform3D(Basis(), Vector3(-1, -1, -1)) });
+		}
+		world->entity(ids[10]).destruct();
+		world->entity(ids[11]).remove<Transform3DComponent>();
+		world->entity(ids[0]).set_name("Renamed");
+		flecs::entity spawned = world->entity().set<Transform3DComponent>({});
+
+		REQUIRE(fixture.server->restore_world(world_id, snapshot));
+
+		CHECK_FALSE(world->is_alive(spawned));
+		CHECK(world->is_alive(ids[10]));
+		CHECK(world->entity(ids[11]).has<Transform3DComponent>());
+		CHECK(String(world->entity(ids[0]).name().c_str()) == "Leader");
+		CHECK(world->entity(ids[1]).parent() == world->entity(ids[0]));
+		for (int i = 0; i < count; i++) {
+			flecs::entity entity = world->entity(ids[i]);
+			REQUIRE(entity.has<Transform3DComponent>());
+			CHECK(entity.get<Transform3DComponent>().transform.origin == Vector3(i, 0, 0));
+		}
+
+		// Components and systems are schema and survive a restore untouched
+		CHECK(world->lookup("Transform3DComponent").is_valid());
+	}
+
+	TEST_CASE("[WorldSnapshot] Components owning memory are restored member by member") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		Dictionary fields;
+		fields["hp"] = 0;
+		fields["label"] = String();
+		REQUIRE(fixture.server->create_runtime_component(world_id, "SnapshotTag", fields).is_valid());
+
+		RID entity = fixture.server->create_entity(world_id);
+		Dictionary data;
+		data["hp"] = 42;
+		data["label"] = "before";
+		fixture.server->set_component(entity, "SnapshotTag", data);
+
+		const PackedByteArray snapshot = fixture.server->snapshot_world(world_id);
+		data["hp"] = 7;
+		data["label"] = "after";
+		fixture.server->set_component(entity, "SnapshotTag", data);
+
+		REQUIRE(fixture.server->restore_world(world_id, snapshot));
+		Dictionary restored = fixture.server->get_component_by_name(entity, "SnapshotTag");
+		CHECK(int(restored["hp"]) == 42);
+		CHECK(String(restored["label"]) == "before");
+	}
+
+	TEST_CASE("[WorldSnapshot] Restoring into an empty world notifies every row") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		const int count = 500;
+		LocalVector<flecs::entity_t> ids;
+		for (int i = 0; i < count; i++) {
+			flecs::entity e = world->entity().set<Transform3DComponent>({ Transform3D(Basis(), Vector3(i, 0, 0)) });
+			// Two destination tables
+			if (i % 2) {
+				e.set<VisibilityComponent>({ true });
+			}
+			ids.push_back(e.id());
+		}
+
+		RID target_id = fixture.server->create_world();
+		flecs::world *target = fixture.server->_get_world(target_id);
+		REQUIRE(target != nullptr);
+		int on_set_rows = 0;
+		flecs::observer counter = target->observer<Transform3DComponent>()
+										  .event(flecs::OnSet)
+										  .each([&](flecs::entity, Transform3DComponent &) { on_set_rows++; });
+
+		FlecsWorldSnapshot::Restore restore;
+		String error;
+		REQUIRE(restore.parse(*target, FlecsWorldSnapshot::save(*world), error));
+		restore.apply(*target);
+
+		CHECK(on_set_rows == count);
+		for (int i = 0; i < count; i++) {
+			flecs::entity e = target->entity(ids[i]);
+			REQUIRE(e.is_alive());
+			CHECK(e.get<Transform3DComponent>().transform.origin == Vector3(i, 0, 0));
+			CHECK(e.has<VisibilityComponent>() == bool(i % 2));
+		}
+		counter.destruct();
+		fixture.server->free_world(target_id);
+	}
+
+	TEST_CASE("[WorldSnapshot] Invalid snapshots leave the world untouched") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		RID entity = fixture.server->create_entity(world_id);
+		PackedByteArray snapshot = fixture.server->snapshot_world(world_id);
+		snapshot.resize(snapshot.size() - 1);
+
+		// Hand-written snapshots with one single-row table
+		auto put = [](PackedByteArray &r_bytes, uint64_t p_value, int p_size) {
+			for (int i = 0; i < p_size; i++) {
+				r_bytes.push_back(uint8_t(p_value >> (8 * i)));
+			}
+		};
+		auto make_snapshot = [&](uint64_t p_entity, uint8_t p_first_kind, uint64_t p_first) {
+			PackedByteArray bytes;
+			put(bytes, 0x53575447, 4); // Magic
+			put(bytes, 1, 4); // Version
+			put(bytes, 0, 4); // Paths
+			put(bytes, 1, 4); // Tables
+			put(bytes, 1, 4); // Rows
+			put(bytes, p_entity, 8);
+			put(bytes, 0, 4); // Names
+			put(bytes, 1, 4); // Ids
+			put(bytes, 0, 8); // Flags
+			put(bytes, p_first_kind, 1);
+			put(bytes, p_first, 8);
+			put(bytes, 0, 1); // REF_NONE
+			put(bytes, 0, 4); // Columns
+			return bytes;
+		};
+		const uint64_t entity_id = fixture.get_entity(entity).id();
+		const uint8_t ref_entity = 2;
+		const uint8_t ref_literal = 3;
+
+		ERR_PRINT_OFF;
+		CHECK_FALSE(fixture.server->restore_world(world_id, snapshot));
+		CHECK_FALSE(fixture.server->restore_world(world_id, PackedByteArray()));
+		// Null, builtin and flagged entity ids
+		CHECK_FALSE(fixture.server->restore_world(world_id, make_snapshot(0, ref_entity, entity_id)));
+		CHECK_FALSE(fixture.server->restore_world(world_id, make_snapshot(1, ref_entity, entity_id)));
+		CHECK_FALSE(fixture.server->restore_world(world_id, make_snapshot(entity_id | ECS_PAIR, ref_entity, entity_id)));
+		CHECK_FALSE(fixture.server->restore_world(world_id, make_snapshot(entity_id, ref_entity, EcsChildOf)));
+		// A literal is only valid as a pair target
+		CHECK_FALSE(fixture.server->restore_world(world_id, make_snapshot(entity_id, ref_literal, entity_id)));
+		ERR_PRINT_ON;
+		CHECK(fixture.server->get_world_of_entity(entity) == world_id);
+	}
+
+	TEST_CASE("[WorldSnapshot] Forks diverge without touching the source world") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		Dictionary fields;
+		fields["hp"] = 0;
+		REQUIRE(fixture.server->create_runtime_component(world_id, "ForkHealth", fields).is_valid());
+		RID entity = fixture.server->create_entity(world_id);
+		Dictionary data;
+		data["hp"] = 10;
+		fixture.server->set_component(entity, "ForkHealth", data);
+		const flecs::entity_t entity_id = fixture.get_entity(entity).id();
+
+		RID fork_id = fixture.server->fork_world(world_id);
+		REQUIRE(fork_id.is_valid());
+		CHECK(fixture.server->get_fork_source(fork_id) == world_id);
+		flecs::world *fork = fixture.server->_get_world(fork_id);
+		REQUIRE(fork != nullptr);
+		CHECK(fork->c_ptr() != world->c_ptr());
+
+		// Same entity id and values in the fork
+		RID fork_entity = fixture.server->get_entity_rid(fork_id, int64_t(entity_id));
+		REQUIRE(fork_entity.is_valid());
+		CHECK(int(fixture.server->get_component_by_name(fork_entity, "ForkHealth")["hp"]) == 10);
+
+		data["hp"] = 99;
+		fixture.server->set_component(fork_entity, "ForkHealth", data);
+		fixture.server->create_entity(fork_id);
+		fixture.server->progress_world(fork_id, 0.016);
+
+		CHECK(int(fixture.server->get_component_by_name(entity, "ForkHealth")["hp"]) == 10);
+		CHECK(int(fixture.server->get_component_by_name(fork_entity, "ForkHealth")["hp"]) == 99);
+
+		fixture.server->discard_fork(fork_id);
+		CHECK(fixture.server->_get_world(fork_id) == nullptr);
+		CHECK(fixture.server->get_world_of_entity(entity) == world_id);
+
+		// Only forks can be discarded
+		ERR_PRINT_OFF;
+		fixture.server->discard_fork(world_id);
+		ERR_PRINT_ON;
+		CHECK(fixture.server->_get_world(world_id) != nullptr);
+	}
+
+	TEST_CASE("[WorldSnapshot] Worlds with native systems cannot be forked") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		fixture.server->_create_rid_for_system(world_id, world->system("ForkNative").run([](flecs::iter &) {}));
+		ERR_PRINT_OFF;
+		CHECK_FALSE(fixture.server->fork_world(world_id).is_valid());
+		ERR_PRINT_ON;
+	}
+
+	TEST_CASE("[WorldSnapshot] Freeing the source leaves its forks as plain worlds") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServer *server = FlecsServer::get_singleton();
+		const RID source_id = server->create_world();
+		REQUIRE(source_id.is_valid());
+		const RID fork_id = server->fork_world(source_id);
+		REQUIRE(fork_id.is_valid());
+		REQUIRE(server->get_fork_source(fork_id) == source_id);
+
+		server->free_world(source_id);
+		CHECK(server->get_fork_source(fork_id) == RID());
+		CHECK(server->_get_world(fork_id) != nullptr);
+		server->free_world(fork_id);
+	}
+
+	TEST_CASE("[WorldSnapshot] Forks never truncate wide runtime structs") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		// One member more than ecs_struct_init() accepts
+		const int member_count = ECS_MEMBER_DESC_CACHE_SIZE + 1;
+		flecs::untyped_component wide = world->component("ForkWide");
+		for (int i = 0; i < member_count; i++) {
+			wide.member<float>(vformat("m%d", i).utf8().get_data());
+		}
+		REQUIRE(ecs_vec_count(&wide.get<EcsStruct>().members) == member_count);
+
+		ERR_PRINT_OFF;
+		RID fork_id = fixture.server->fork_world(world_id);
+		ERR_PRINT_ON;
+		REQUIRE(fork_id.is_valid());
+		flecs::world *fork = fixture.server->_get_world(fork_id);
+		REQUIRE(fork != nullptr);
+
+		// Left out of the fork rather than recreated with fewer members
+		flecs::entity fork_wide = fork->lookup("ForkWide");
+		if (fork_wide.is_valid() && fork_wide.has<EcsStruct>()) {
+			CHECK(ecs_vec_count(&fork_wide.get<EcsStruct>().members) == member_count);
+		}
+		fixture.server->discard_fork(fork_id);
+	}
+}
+
+} // namespace TestWorldSnapshot
+
+#endif // TEST_WORLD_SNAPSHOT_H
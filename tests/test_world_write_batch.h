@@ -0,0 +1,198 @@
+/**************************************************************************/
+/*  test_world_write_batch.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_WORLD_WRITE_BATCH_H
+#define TEST_WORLD_WRITE_BATCH_H
+
+#include "modules/godot_turbo/ecs/flecs_types/flecs_server.h"
+#include "modules/godot_turbo/ecs/flecs_types/world_write_batch.h"
+#include "test_fixtures.h"
+#include "tests/test_macros.h"
+
+namespace TestWorldWriteBatch {
+
+using namespace TestFixtures;
+
+TEST_SUITE("[Modules][GodotTurbo][WorldWriteBatch]") {
+	TEST_CASE("[WorldWriteBatch] Writes are coalesced per entity and component") {
+		WorldWriteBatch batch;
+		batch.record_add(1, 10);
+		Dictionary first;
+		first["hp"] = 1;
+		first["armor"] = 2.0;
+		batch.record_set(1, 10, first);
+		Dictionary second;
+		second["hp"] = 5;
+		batch.record_set(1, 10, second);
+		batch.record_set(2, 10, second);
+		batch.record_remove(2, 10);
+		batch.record_add(1, 10);
+
+		CHECK(batch.get_pending_count() == 2);
+		CHECK(batch.get_recorded_count() == 6);
+
+		LocalVector<WorldWriteBatch::Op> ops;
+		batch.take(ops);
+		REQUIRE(ops.size() == 2);
+		CHECK(ops[0].entity == 1);
+		CHECK(ops[0].kind == WorldWriteBatch::OP_SET);
+		CHECK(int(ops[0].data["hp"]) == 5);
+		CHECK(double(ops[0].data["armor"]) == doctest::Approx(2.0));
+		CHECK(ops[1].entity == 2);
+		CHECK(ops[1].kind == WorldWriteBatch::OP_REMOVE);
+		CHECK(batch.get_pending_count() == 0);
+
+		// A write after a remove still removes first
+		batch.record_remove(3, 10);
+		batch.record_set(3, 10, second);
+		batch.record_remove(4, 10);
+		batch.record_add(4, 10);
+		batch.take(ops);
+		REQUIRE(ops.size() == 2);
+		CHECK(ops[0].kind == WorldWriteBatch::OP_SET);
+		CHECK(ops[0].reset);
+		CHECK(ops[1].kind == WorldWriteBatch::OP_ADD);
+		CHECK(ops[1].reset);
+	}
+
+	TEST_CASE("[WorldWriteBatch] Batched sets fire one OnSet per entity") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+		flecs::world *world = fixture.get_world();
+		REQUIRE(world != nullptr);
+
+		Dictionary fields;
+		fields["hp"] = 100;
+		REQUIRE(fixture.server->create_runtime_component(world_id, "BatchHealth", fields).is_valid());
+		flecs::entity health = world->lookup("BatchHealth");
+		REQUIRE(health.is_valid());
+
+		const int count = 64;
+		Vector<RID> entities;
+		for (int i = 0; i < count; i++) {
+			entities.push_back(fixture.server->create_entity(world_id));
+		}
+
+		int on_set_calls = 0;
+		world->observer<>()
+				.with(health)
+				.event(flecs::OnSet)
+				.each([&on_set_calls](flecs::iter &, size_t) {
+					on_set_calls++;
+				});
+
+		for (int pass = 0; pass < 10; pass++) {
+			for (int i = 0; i < count; i++) {
+				Dictionary data;
+				data["hp"] = pass * 1000 + i;
+				fixture.server->batch_set_component(entities[i], "BatchHealth", data);
+			}
+		}
+		CHECK(fixture.server->get_write_batch_pending_count(world_id) == count);
+		CHECK_FALSE(fixture.server->has_component(entities[0], "BatchHealth"));
+		CHECK(on_set_calls == 0);
+
+		CHECK(fixture.server->flush_write_batch(world_id) == count);
+		CHECK(on_set_calls == count);
+		CHECK(fixture.server->get_write_batch_pending_count(world_id) == 0);
+		for (int i = 0; i < count; i++) {
+			Dictionary data = fixture.server->get_component_by_name(entities[i], "BatchHealth");
+			CHECK(int(data["hp"]) == 9000 + i);
+		}
+	}
+
+	TEST_CASE("[WorldWriteBatch] Remove then set starts from default values") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+
+		Dictionary fields;
+		fields["hp"] = 0;
+		fields["armor"] = 0;
+		REQUIRE(fixture.server->create_runtime_component(world_id, "BatchShield", fields).is_valid());
+
+		RID fresh = fixture.server->create_entity(world_id);
+		fixture.server->batch_add_component(fresh, "BatchShield");
+		fixture.server->flush_write_batch(world_id);
+		const int default_armor = fixture.server->get_component_by_name(fresh, "BatchShield")["armor"];
+
+		RID entity = fixture.server->create_entity(world_id);
+		Dictionary data;
+		data["hp"] = 5;
+		data["armor"] = default_armor + 7;
+		fixture.server->set_component(entity, "BatchShield", data);
+
+		Dictionary hp_only;
+		hp_only["hp"] = 1;
+		fixture.server->batch_remove_component(entity, "BatchShield");
+		fixture.server->batch_set_component(entity, "BatchShield", hp_only);
+		fixture.server->flush_write_batch(world_id);
+
+		Dictionary result = fixture.server->get_component_by_name(entity, "BatchShield");
+		CHECK(int(result["hp"]) == 1);
+		CHECK(int(result["armor"]) == default_armor);
+	}
+
+	TEST_CASE("[WorldWriteBatch] Pending writes are applied by progress and skip dead entities") {
+		REQUIRE_FLECS_SERVER();
+		FlecsServerFixture fixture;
+		RID world_id = fixture.create_world();
+
+		Dictionary fields;
+		fields["hp"] = 100;
+		REQUIRE(fixture.server->create_runtime_component(world_id, "BatchArmor", fields).is_valid());
+
+		RID kept = fixture.server->create_entity(world_id);
+		RID freed = fixture.server->create_entity(world_id);
+		fixture.server->batch_add_component(kept, "BatchArmor");
+		fixture.server->batch_add_component(freed, "BatchArmor");
+		fixture.server->free_entity(world_id, freed, true);
+
+		fixture.server->progress_world(world_id, 0.016);
+		CHECK(fixture.server->has_component(kept, "BatchArmor"));
+		CHECK(fixture.server->get_write_batch_pending_count(world_id) == 0);
+
+		fixture.server->batch_remove_component(kept, "BatchArmor");
+		fixture.server->set_write_batch_flush_phase(world_id, "PostUpdate");
+		CHECK(fixture.server->get_write_batch_flush_phase(world_id) == "PostUpdate");
+		fixture.server->progress_world(world_id, 0.016);
+		CHECK_FALSE(fixture.server->has_component(kept, "BatchArmor"));
+
+		ERR_PRINT_OFF;
+		fixture.server->set_write_batch_flush_phase(world_id, "NoSuchPhase");
+		ERR_PRINT_ON;
+		CHECK(fixture.server->get_write_batch_flush_phase(world_id) == "PostUpdate");
+	}
+}
+
+} // namespace TestWorldWriteBatch
+
+#endif // TEST_WORLD_WRITE_BATCH_H